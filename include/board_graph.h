@@ -0,0 +1,223 @@
+#ifndef BOARD_GRAPH_H
+#define BOARD_GRAPH_H
+
+#include <stdint.h>
+
+#include "dataflow.h"
+#include "imu.h"
+#include "gyro_bias.h"
+#include "detector.h"
+#include "dual_front_end.h"
+#include "spectrogram.h"
+#include "tremor_tracker.h"
+#include "vote.h"
+
+// ========= PIPELINE NODES =========
+// The analysis path as dataflow nodes (see dataflow.h):
+//
+//   raw IMU sample -> MagnitudeNode -> DetectorNode -> VoteNode
+//        1 : 1                 raw_samples : 1         1 : 1
+//
+// MagnitudeNode, 1 : 1 at the head, fires on each push() (dataflow.h);
+// the step detector reads its accel magnitude from head_output(). Other
+// per-sample work (flight recorder) stays in the acquisition path.
+
+struct imu_sample {
+    int16_t raw[IMU_AXES];
+};
+
+struct mag_sample {
+    float accel;            // g
+    float gyro;             // dps
+};
+
+// Accel and gyro magnitudes, the gyro's zero-rate bias tracked and
+// taken off first (gyro_bias.h).
+struct MagnitudeNode {
+    typedef imu_sample in_t;
+    typedef mag_sample out_t;
+    static constexpr int in_rate  = 1;
+    static constexpr int out_rate = 1;
+
+    gyro_bias bias;
+
+    void init() { gyro_bias_init(bias); }
+    void run(const imu_sample *in, mag_sample *out) {
+        gyro_bias_push(bias, in->raw);
+        out->accel = imu_accel_magnitude(in->raw);
+        out->gyro = gyro_bias_magnitude(bias, in->raw);
+    }
+};
+
+// Whether magnitudes lose precision on the way into sample_t T. Such a
+// type gets them with an f32 mean taken off first: around the accel's
+// 1 g, f16 steps are ~0.001 g, as large as the walk and fog bands. The
+// FFT stage removes what is left of the mean, so the spectra are the
+// same up to rounding.
+template <class T> struct narrower_than_f32 {
+    static constexpr bool value = sizeof(T) < sizeof(float);
+};
+
+// One window of mag_samples through the detector. The window stays in
+// accel / gyro after run() for the WCET capture (less its mean if
+// sample_t is narrower than f32); sink, if set, receives the spectra
+// (see Detector::analyze, board_sink).
+template <class D, class Sink>
+struct DetectorNode {
+    typedef mag_sample      in_t;
+    typedef detector_result out_t;
+    static constexpr int in_rate  = D::raw_samples;
+    static constexpr int out_rate = 1;
+    static constexpr bool narrow = narrower_than_f32<typename D::sample_t>::value;
+
+    D detector;
+    Sink *sink;
+    typename D::sample_t accel[D::raw_samples];
+    typename D::sample_t gyro[D::raw_samples];
+
+    void init() {
+        detector.init();
+        sink = 0;
+    }
+
+    void run(const mag_sample *in, detector_result *out) {
+        float accel_mean = 0, gyro_mean = 0;
+        if (narrow) {
+            for (int i=0; i < D::raw_samples; i++) {
+                accel_mean += in[i].accel;
+                gyro_mean  += in[i].gyro;
+            }
+            accel_mean /= D::raw_samples;
+            gyro_mean  /= D::raw_samples;
+        }
+        for (int i=0; i < D::raw_samples; i++) {
+            accel[i] = (typename D::sample_t)(in[i].accel - accel_mean);
+            gyro[i]  = (typename D::sample_t)(in[i].gyro - gyro_mean);
+        }
+        if (sink) detector.analyze(accel, gyro, *out, *sink);
+        else      detector.analyze(accel, gyro, *out);
+    }
+};
+
+// The dual-resolution front end: a decision per fast hop, from the
+// newest gyro bands and the latest accel bands. Its windows span several
+// hops, so a narrow sample_t gets the magnitudes less a running f32 mean
+// (time constant of one slow window, far below the walk band) instead
+// of a per-hop one, which would put steps into the window.
+template <class F>
+struct DualFrontEndNode {
+    typedef mag_sample      in_t;
+    typedef detector_result out_t;
+    static constexpr int in_rate  = F::fast_hop;
+    static constexpr int out_rate = 1;
+    static constexpr bool narrow = narrower_than_f32<typename F::sample_t>::value;
+
+    F front;
+    typename F::sample_t accel[F::fast_hop];
+    typename F::sample_t gyro[F::fast_hop];
+    float accel_mean, gyro_mean;
+    bool  primed;
+
+    void init() {
+        front.init();
+        accel_mean = gyro_mean = 0;
+        primed = false;
+    }
+
+    void run(const mag_sample *in, detector_result *out) {
+        const float k = 1.0f / F::slow_fft;
+        if (narrow && !primed) {
+            accel_mean = in[0].accel;
+            gyro_mean  = in[0].gyro;
+            primed = true;
+        }
+        for (int i=0; i < F::fast_hop; i++) {
+            if (narrow) {
+                accel_mean += k * (in[i].accel - accel_mean);
+                gyro_mean  += k * (in[i].gyro - gyro_mean);
+            }
+            accel[i] = (typename F::sample_t)(in[i].accel - accel_mean);
+            gyro[i]  = (typename F::sample_t)(in[i].gyro - gyro_mean);
+        }
+        front.hop(accel, gyro);
+        const spectral_features &f = front.features();
+        detector_decide(f.tremor, f.dysk, f.walk, f.fog, *out);
+    }
+};
+
+struct board_decision {
+    detector_result r;      // this window alone
+    uint32_t active;        // vote bits, 1 << SYM_*
+    int16_t  conf[SYM_COUNT];
+};
+
+template <class V>
+struct VoteNode {
+    typedef detector_result in_t;
+    typedef board_decision  out_t;
+    static constexpr int in_rate  = 1;
+    static constexpr int out_rate = 1;
+
+    V vote;
+
+    void init() { vote.reset(); }
+
+    void run(const detector_result *in, board_decision *out) {
+        vote.push(in->score);
+        out->r = *in;
+        out->active = vote.active_mask();
+        for (int s=0; s < SYM_COUNT; s++) out->conf[s] = vote.confidence(s);
+    }
+};
+
+// ========= BOARD GRAPH =========
+// last 16 hops (48 s) of 0.5-8 Hz spectra, log-compressed
+typedef SpectralHistory<board_detector, 16, spec_log_q15> board_history;
+
+// The detector's spectra to the history and the gyro one to the tremor
+// tracker; either may be left out (0).
+struct board_sink {
+    board_history *history;
+    TremorTracker<board_detector> *tracker;
+
+    void accel_spectrum(const board_detector::sample_t *mag, float gain) {
+        if (history) history->accel_spectrum(mag, gain);
+    }
+    void gyro_spectrum(const board_detector::sample_t *mag, float gain) {
+        if (history) history->gyro_spectrum(mag, gain);
+        if (tracker) tracker->gyro_spectrum(mag, gain);
+    }
+};
+
+// Room for two FIFO batches to arrive while a window waits for analysis.
+typedef SdfGraph<32,
+                 MagnitudeNode,
+                 DetectorNode<board_detector, board_sink>,
+                 VoteNode<board_vote> > board_graph;
+
+enum { NODE_MAGNITUDE, NODE_DETECTOR, NODE_VOTE };
+
+// The board's detector settings, for main.cpp and every host tool that
+// stands in for it: band powers averaged over ~1 hop. Restarts the
+// average, so the next hop seeds it.
+inline void board_detector_init(board_detector &d) {
+    d.init();
+    d.set_smoothing(1.0f);
+}
+
+// Initialises every node as on the board; sinks are left to the caller.
+inline void board_graph_init(board_graph &g) {
+    g.init();
+    board_detector_init(g.node<NODE_DETECTOR>().detector);
+}
+
+// Same chain on the dual-resolution front end, same node indices.
+typedef SdfGraph<32,
+                 MagnitudeNode,
+                 DualFrontEndNode<board_dual>,
+                 VoteNode<dual_vote> > dual_graph;
+
+// The dual front end has no settings of its own.
+inline void board_graph_init(dual_graph &g) { g.init(); }
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef CONST_MATH_H
+#define CONST_MATH_H
+
+// ========= COMPILE-TIME MATH =========
+// sin / cos / exp usable in constant expressions, so coefficient tables
+// (filters) are computed by the compiler and land in flash instead of
+// being filled in at boot. Double precision series, well past float
+// accuracy over the ranges used here; not meant for run-time use.
+
+constexpr double CE_PI = 3.14159265358979323846;
+
+// x reduced to [-pi, pi]
+constexpr double ce_reduce(double x) {
+    while (x >  CE_PI) x -= 2.0 * CE_PI;
+    while (x < -CE_PI) x += 2.0 * CE_PI;
+    return x;
+}
+
+constexpr double ce_sin(double x) {
+    x = ce_reduce(x);
+    double term = x, sum = x;
+    for (int n=1; n < 14; n++) {
+        term *= -x * x / ((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double ce_cos(double x) {
+    x = ce_reduce(x);
+    double term = 1.0, sum = 1.0;
+    for (int n=1; n < 14; n++) {
+        term *= -x * x / ((2 * n - 1) * (2 * n));
+        sum += term;
+    }
+    return sum;
+}
+
+// exp(x) = exp(x / 2^k)^(2^k) with |x / 2^k| <= 0.5
+constexpr double ce_exp(double x) {
+    int k = 0;
+    while (x > 0.5 || x < -0.5) {
+        x /= 2.0;
+        k++;
+    }
+    double term = 1.0, sum = 1.0;
+    for (int n=1; n < 18; n++) {
+        term *= x / n;
+        sum += term;
+    }
+    while (k-- > 0) sum *= sum;
+    return sum;
+}
+
+#endif
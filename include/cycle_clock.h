@@ -0,0 +1,19 @@
+#ifndef CYCLE_CLOCK_H
+#define CYCLE_CLOCK_H
+
+#include <stdint.h>
+
+// ========= CYCLE CLOCK =========
+// Free-running 32-bit cycle counter shared by the timing modules.
+// The platform installs the source: DWT->CYCCNT on the board, a host
+// or simulated clock in the tools. Differences are taken with unsigned
+// subtraction, so wrap-around is harmless for intervals < 2^32 cycles.
+
+typedef uint32_t (*cycle_clock_fn)(void);
+
+void     cycle_clock_set(cycle_clock_fn now, uint32_t hz);
+uint32_t cycle_clock_now();
+uint32_t cycle_clock_hz();
+uint32_t cycle_clock_to_us(uint32_t cycles);
+
+#endif
@@ -0,0 +1,269 @@
+#ifndef DATAFLOW_H
+#define DATAFLOW_H
+
+#include <stddef.h>
+#include <string.h>
+#include <tuple>
+#include <type_traits>
+
+// ========= SYNCHRONOUS DATAFLOW =========
+// A chain of nodes with fixed token rates, solved at compile time.
+//
+// A node is a class with
+//
+//     typedef ... in_t;  static constexpr int in_rate  = ...;
+//     typedef ... out_t; static constexpr int out_rate = ...;
+//     void init();
+//     void run(const in_t *in, out_t *out);   // in_rate in, out_rate out
+//
+// SdfGraph<Slack, A, B, C> balances the rates (A fires reps(0) times,
+// B reps(1) times, ... per iteration), sizes every edge buffer for one
+// iteration and runs the single-appearance schedule A^r0 B^r1 C^r2.
+// All storage is inside the graph object: no allocation, and the same
+// graph runs on the board and on the host.
+//
+// Input arrives token by token with push(); once input_tokens are
+// buffered, ready() is true and run() executes one iteration. Slack
+// extra input tokens can be pushed while an iteration waits to run.
+//
+// A head node with rates 1 : 1 fires in push(), on each token as it
+// arrives, instead of reps(0) times in run(). The input FIFO then holds
+// its outputs, and head_output() returns the newest one at once, for
+// per-sample work outside the graph that needs the same value.
+
+constexpr int sdf_gcd(int a, int b) { return b ? sdf_gcd(b, a % b) : a; }
+
+template <int Count>
+struct sdf_schedule {
+    int reps[Count];
+};
+
+// Balance equations of a chain: reps[i] * out[i] = reps[i+1] * in[i+1],
+// smallest positive integer solution.
+template <int Count>
+constexpr sdf_schedule<Count> sdf_solve(const int (&in)[Count], const int (&out)[Count]) {
+    sdf_schedule<Count> s = {};
+    int num[Count] = {}, den[Count] = {};
+    num[0] = den[0] = 1;
+    for (int i=1; i < Count; i++) {
+        num[i] = num[i-1] * out[i-1];
+        den[i] = den[i-1] * in[i];
+        int g = sdf_gcd(num[i], den[i]);
+        num[i] /= g;
+        den[i] /= g;
+    }
+    int l = 1;
+    for (int i=0; i < Count; i++) l = l / sdf_gcd(l, den[i]) * den[i];
+    int g = 0;
+    for (int i=0; i < Count; i++) {
+        s.reps[i] = num[i] * (l / den[i]);
+        g = sdf_gcd(g, s.reps[i]);
+    }
+    for (int i=0; i < Count; i++) s.reps[i] /= g;
+    return s;
+}
+
+template <class... Nodes>
+struct sdf_rates {
+    static constexpr int count = sizeof...(Nodes);
+    static constexpr int in[count]  = { Nodes::in_rate... };
+    static constexpr int out[count] = { Nodes::out_rate... };
+    static constexpr sdf_schedule<count> sched = sdf_solve<count>(in, out);
+};
+
+template <class... Nodes> constexpr int sdf_rates<Nodes...>::in[];
+template <class... Nodes> constexpr int sdf_rates<Nodes...>::out[];
+template <class... Nodes> constexpr sdf_schedule<sdf_rates<Nodes...>::count> sdf_rates<Nodes...>::sched;
+
+// One node and its output buffer, then the rest of the chain.
+template <class Rates, int I, class... Nodes>
+struct sdf_chain;
+
+template <class Rates, int I>
+struct sdf_chain<Rates, I> {
+    static constexpr size_t bytes = 0;
+    void init() {}
+    template <class T> void run(const T *) {}
+};
+
+template <class Rates, int I, class N, class... Rest>
+struct sdf_chain<Rates, I, N, Rest...> {
+    static constexpr int reps = Rates::sched.reps[I];
+    static constexpr int produced = reps * N::out_rate;
+
+    typedef N node_t;
+    typedef sdf_chain<Rates, I + 1, Rest...> next_t;
+    static constexpr size_t bytes = sizeof(typename N::out_t) * produced + next_t::bytes;
+
+    N node;
+    typename N::out_t out[produced];
+    next_t next;
+
+    void init() {
+        node.init();
+        next.init();
+    }
+
+    void run(const typename N::in_t *in) {
+        for (int k=0; k < reps; k++)
+            node.run(in + k * N::in_rate, out + k * N::out_rate);
+        next.run(out);
+    }
+};
+
+// Type checks between neighbours
+template <class... Nodes> struct sdf_linked { static constexpr bool value = true; };
+template <class A, class B, class... Rest>
+struct sdf_linked<A, B, Rest...> {
+    static constexpr bool value = std::is_same<typename A::out_t, typename B::in_t>::value
+                               && sdf_linked<B, Rest...>::value;
+};
+
+template <class... Nodes> struct sdf_first;
+template <class N, class... Rest> struct sdf_first<N, Rest...> { typedef N type; };
+
+template <class... Nodes> struct sdf_last;
+template <class N> struct sdf_last<N> { typedef N type; };
+template <class N, class... Rest> struct sdf_last<N, Rest...> { typedef typename sdf_last<Rest...>::type type; };
+
+template <int I, class Chain> struct sdf_get {
+    typedef sdf_get<I - 1, typename Chain::next_t> inner;
+    typedef typename inner::stage_t stage_t;
+    static stage_t &from(Chain &c) { return inner::from(c.next); }
+};
+template <class Chain> struct sdf_get<0, Chain> {
+    typedef Chain stage_t;
+    static stage_t &from(Chain &c) { return c; }
+};
+
+// What a graph stores besides its input FIFO: the whole chain, run on
+// the FIFO's input tokens, or with an eager head, the head node apart
+// and the chain from node 1, run on the head's outputs.
+template <bool Eager, class Rates, class... Nodes>
+struct sdf_body {
+    typedef sdf_chain<Rates, 0, Nodes...> chain_t;
+    typedef typename sdf_first<Nodes...>::type first_t;
+    typedef typename first_t::in_t fifo_t;
+
+    static constexpr int last = sizeof...(Nodes) - 1;
+
+    chain_t chain;
+
+    void init() { chain.init(); }
+    void head(const typename first_t::in_t &x, fifo_t &out) { out = x; }
+    void run(const fifo_t *in) { chain.run(in); }
+
+    template <int I>
+    typename std::tuple_element<I, std::tuple<Nodes...> >::type &node(std::integral_constant<int, I>) {
+        return sdf_get<I, chain_t>::from(chain).node;
+    }
+    const typename sdf_get<last, chain_t>::stage_t &last_stage() const {
+        return sdf_get<last, chain_t>::from(const_cast<chain_t &>(chain));
+    }
+};
+
+template <class Rates, class Head, class... Rest>
+struct sdf_body<true, Rates, Head, Rest...> {
+    static_assert(sizeof...(Rest) > 0, "an eager head needs a node after it");
+
+    typedef sdf_chain<Rates, 1, Rest...> chain_t;
+    typedef typename Head::out_t fifo_t;
+
+    static constexpr int last = sizeof...(Rest) - 1;
+
+    Head    head_node;
+    chain_t chain;
+
+    void init() {
+        head_node.init();
+        chain.init();
+    }
+    void head(const typename Head::in_t &x, fifo_t &out) { head_node.run(&x, &out); }
+    void run(const fifo_t *in) { chain.run(in); }
+
+    Head &node(std::integral_constant<int, 0>) { return head_node; }
+    template <int I>
+    typename std::tuple_element<I, std::tuple<Head, Rest...> >::type &node(std::integral_constant<int, I>) {
+        return sdf_get<I - 1, chain_t>::from(chain).node;
+    }
+    const typename sdf_get<last, chain_t>::stage_t &last_stage() const {
+        return sdf_get<last, chain_t>::from(const_cast<chain_t &>(chain));
+    }
+};
+
+template <int Slack, class... Nodes>
+class SdfGraph {
+    typedef sdf_rates<Nodes...> rates;
+    typedef typename sdf_first<Nodes...>::type first_t;
+    typedef typename sdf_last<Nodes...>::type  last_t;
+
+    static_assert(sdf_linked<Nodes...>::value, "node output does not match next input");
+
+public:
+    typedef typename first_t::in_t  in_t;
+    typedef typename last_t::out_t  out_t;
+
+    static constexpr int nodes = sizeof...(Nodes);
+    static constexpr bool eager_head = nodes > 1 && first_t::in_rate == 1 && first_t::out_rate == 1;
+
+private:
+    typedef sdf_body<eager_head, rates, Nodes...> body_t;
+    typedef typename body_t::fifo_t fifo_t;
+
+public:
+    static constexpr int input_tokens  = rates::sched.reps[0] * first_t::in_rate;
+    static constexpr int output_tokens = rates::sched.reps[nodes - 1] * last_t::out_rate;
+
+    // Edge buffers plus the input FIFO.
+    static constexpr size_t buffer_bytes =
+        body_t::chain_t::bytes + sizeof(fifo_t) * (input_tokens + Slack);
+
+    static constexpr int reps(int i) { return rates::sched.reps[i]; }
+
+    void init() {
+        fill = 0;
+        body.init();
+    }
+
+    // false when the input FIFO is full (the iteration is overdue); an
+    // eager head has still seen the token
+    bool push(const in_t &x) {
+        body.head(x, newest);
+        if (fill >= input_tokens + Slack) return false;
+        input[fill++] = newest;
+        return true;
+    }
+
+    // The eager head's output for the last token pushed.
+    const fifo_t &head_output() const {
+        static_assert(eager_head, "the head node runs in run(), not push()");
+        return newest;
+    }
+
+    bool ready() const { return fill >= input_tokens; }
+    int  buffered() const { return fill; }
+
+    // One iteration over the oldest input_tokens. Returns the
+    // output_tokens it produced, valid until the next run().
+    const out_t *run() {
+        body.run(input);
+        fill -= input_tokens;
+        memmove(input, input + input_tokens, fill * sizeof(fifo_t));
+        return output();
+    }
+
+    const out_t *output() const { return body.last_stage().out; }
+
+    template <int I>
+    typename std::tuple_element<I, std::tuple<Nodes...> >::type &node() {
+        return body.node(std::integral_constant<int, I>());
+    }
+
+private:
+    fifo_t input[input_tokens + Slack];
+    fifo_t newest;
+    int    fill;
+    body_t body;
+};
+
+#endif
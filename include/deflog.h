@@ -0,0 +1,74 @@
+#ifndef DEFLOG_H
+#define DEFLOG_H
+
+#include <stdint.h>
+#include <string.h>
+
+// ========= DEFERRED LOGGER =========
+// The hot path stores a binary record (format id + up to 7 32-bit
+// arguments) in a lock-free ring and returns; it never formats or
+// waits on the UART. deflog_drain() formats records into a byte ring
+// when the loop is otherwise idle, and the UART TX interrupt empties
+// that ring one byte at a time via deflog_tx_byte().
+//
+// One producer (the main loop) and one consumer (drain) per ring; do
+// not log from interrupt handlers.
+
+#define DEFLOG_MAX_ARGS 7
+#define DEFLOG_RECORDS  64     // power of two
+#define DEFLOG_TX_BYTES 1024   // power of two
+
+// Format strings understand %d %u %x (with optional 0-padded width,
+// e.g. %08x), %f (3 decimals) and %%.
+
+struct deflog_stats {
+    uint32_t written;
+    uint32_t dropped;     // records lost because the ring was full
+    uint32_t max_depth;   // high-water mark of the record ring
+    uint32_t tx_bytes;
+};
+
+typedef void (*deflog_kick_fn)(void);
+
+void deflog_init(const char *const *formats, int count);
+
+// Called after drain adds bytes, to start the TX interrupt if idle.
+void deflog_set_kick(deflog_kick_fn kick);
+
+bool deflog_write(uint8_t fmt, const uint32_t *args, int n);
+
+// Free record slots; bulk producers use it to avoid dropping.
+int deflog_space();
+int deflog_pending();
+
+// Idle-time work: formats as many records as fit in the TX ring.
+void deflog_drain();
+
+// TX interrupt side: next byte to send, or -1 when the ring is empty.
+int deflog_tx_byte();
+
+// True once each time the TX ring runs low while records wait, so the
+// TX interrupt can wake the loop to drain more.
+bool deflog_refill_due();
+
+const deflog_stats &deflog_get_stats();
+
+// ======= TYPED FRONT END =======
+static inline uint32_t deflog_arg(float v)         { uint32_t u; memcpy(&u, &v, 4); return u; }
+static inline uint32_t deflog_arg(int v)           { return (uint32_t)v; }
+static inline uint32_t deflog_arg(unsigned v)      { return (uint32_t)v; }
+static inline uint32_t deflog_arg(long v)          { return (uint32_t)v; }
+static inline uint32_t deflog_arg(unsigned long v) { return (uint32_t)v; }
+
+static inline bool deflog(uint8_t fmt) {
+    return deflog_write(fmt, 0, 0);
+}
+
+template <class... T>
+static inline bool deflog(uint8_t fmt, T... args) {
+    static_assert(sizeof...(T) <= DEFLOG_MAX_ARGS, "too many log arguments");
+    const uint32_t a[] = { deflog_arg(args)... };
+    return deflog_write(fmt, a, (int)sizeof...(T));
+}
+
+#endif
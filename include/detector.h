@@ -0,0 +1,486 @@
+#ifndef DETECTOR_H
+#define DETECTOR_H
+
+#include <string.h>
+
+#include "arm_math.h"
+#include "arm_math_f16.h"
+#include "arm_const_structs.h"
+#include "arm_const_structs_f16.h"
+
+// ========= RESULT =========
+// Symptoms with a per-window score, see Detector::analyze and vote.h.
+enum {
+    SYM_TREMOR,
+    SYM_DYSK,
+    SYM_FREEZE,
+    SYM_TREMOR_PRESENT,     // tremor band alone, shown during a freeze
+    SYM_COUNT
+};
+
+struct detector_result {
+    float tremor;
+    float dysk;
+    float walk;
+    float fog;
+    float fog_ratio;
+
+    bool tremor_present;
+    bool freezing;
+    bool is_tremor;
+    bool is_dysk;
+
+    // q15 in [-1, 1): > 0 when the flag above is set, and how far the
+    // closest threshold was from flipping it.
+    q15_t score[SYM_COUNT];
+};
+
+// ========= BANDS =========
+// Band edges in mHz so they can be template arguments. LoIncl says
+// whether the lower edge itself belongs to the band; the upper edge
+// always does (matches the original f >= lo / f > lo && f <= hi tests).
+template <int LoMilliHz, int HiMilliHz, bool LoIncl = true>
+struct band_mhz {
+    static constexpr int  lo = LoMilliHz;
+    static constexpr int  hi = HiMilliHz;
+    static constexpr bool lo_incl = LoIncl;
+};
+
+// The four clinical bands from the readme, plus the span covering all
+// of them (what spectral history keeps).
+struct parkinson_bands {
+    typedef band_mhz< 500, 3000>        walk;    // accel
+    typedef band_mhz<3000, 8000, false> fog;     // accel
+    typedef band_mhz<3000, 5000>        tremor;  // gyro
+    typedef band_mhz<5000, 7000, false> dysk;    // gyro
+    typedef band_mhz< 500, 8000>        span;
+};
+
+// First / last bin (inclusive) of an FftSize-point transform at
+// SampleRate whose centre lies in band B, using exact integer
+// arithmetic: f_k = k * SampleRate / FftSize.
+template <int SampleRate, int FftSize, class B>
+struct fft_bins {
+    static constexpr int bins = FftSize / 2;
+
+    static constexpr bool above_lo(int k) {
+        return B::lo_incl
+            ? (long long)k * SampleRate * 1000 >= (long long)B::lo * FftSize
+            : (long long)k * SampleRate * 1000 >  (long long)B::lo * FftSize;
+    }
+    static constexpr bool below_hi(int k) {
+        return (long long)k * SampleRate * 1000 <= (long long)B::hi * FftSize;
+    }
+    static constexpr int first_bin() {
+        int k = 1;
+        while (k < bins && !above_lo(k)) k++;
+        return k;
+    }
+    static constexpr int last_bin() {
+        int k = bins - 1;
+        while (k > 0 && !below_hi(k)) k--;
+        return k;
+    }
+    static constexpr int first = first_bin();
+    static constexpr int last  = last_bin();
+};
+
+// ========= FFT INSTANCES =========
+// The length-specific real FFT instances from arm_const_structs: built
+// by the compiler and kept in flash, so there is nothing to set up at
+// boot and only the tables for FftSize are linked in. These exist for
+// the scalar / DSP-extension CMSIS build the Cortex-M4 uses.
+template <int N> struct rfft_const_f32;
+template <> struct rfft_const_f32<32>   { static const arm_rfft_fast_instance_f32 *get() { return &arm_rfft_fast_sR_f32_len32; } };
+template <> struct rfft_const_f32<64>   { static const arm_rfft_fast_instance_f32 *get() { return &arm_rfft_fast_sR_f32_len64; } };
+template <> struct rfft_const_f32<128>  { static const arm_rfft_fast_instance_f32 *get() { return &arm_rfft_fast_sR_f32_len128; } };
+template <> struct rfft_const_f32<256>  { static const arm_rfft_fast_instance_f32 *get() { return &arm_rfft_fast_sR_f32_len256; } };
+template <> struct rfft_const_f32<512>  { static const arm_rfft_fast_instance_f32 *get() { return &arm_rfft_fast_sR_f32_len512; } };
+template <> struct rfft_const_f32<1024> { static const arm_rfft_fast_instance_f32 *get() { return &arm_rfft_fast_sR_f32_len1024; } };
+template <> struct rfft_const_f32<2048> { static const arm_rfft_fast_instance_f32 *get() { return &arm_rfft_fast_sR_f32_len2048; } };
+template <> struct rfft_const_f32<4096> { static const arm_rfft_fast_instance_f32 *get() { return &arm_rfft_fast_sR_f32_len4096; } };
+
+#if defined(ARM_FLOAT16_SUPPORTED)
+template <int N> struct rfft_const_f16;
+template <> struct rfft_const_f16<32>   { static const arm_rfft_fast_instance_f16 *get() { return &arm_rfft_fast_sR_f16_len32; } };
+template <> struct rfft_const_f16<64>   { static const arm_rfft_fast_instance_f16 *get() { return &arm_rfft_fast_sR_f16_len64; } };
+template <> struct rfft_const_f16<128>  { static const arm_rfft_fast_instance_f16 *get() { return &arm_rfft_fast_sR_f16_len128; } };
+template <> struct rfft_const_f16<256>  { static const arm_rfft_fast_instance_f16 *get() { return &arm_rfft_fast_sR_f16_len256; } };
+template <> struct rfft_const_f16<512>  { static const arm_rfft_fast_instance_f16 *get() { return &arm_rfft_fast_sR_f16_len512; } };
+template <> struct rfft_const_f16<1024> { static const arm_rfft_fast_instance_f16 *get() { return &arm_rfft_fast_sR_f16_len1024; } };
+template <> struct rfft_const_f16<2048> { static const arm_rfft_fast_instance_f16 *get() { return &arm_rfft_fast_sR_f16_len2048; } };
+template <> struct rfft_const_f16<4096> { static const arm_rfft_fast_instance_f16 *get() { return &arm_rfft_fast_sR_f16_len4096; } };
+#endif
+
+// ========= PRECISION =========
+// Sample type and transform kernels of the pipeline. When block_scaled
+// is set, each window is scaled by a power of two after DC removal so
+// it uses the type's range, and the band sums undo that exactly.
+
+struct prec_f32 {
+    typedef float32_t sample_t;
+    typedef arm_rfft_fast_instance_f32 rfft_t;
+
+    static constexpr bool block_scaled = false;
+    static float window_scale(float) { return 1.0f; }
+
+    template <int N> static const rfft_t *instance() { return rfft_const_f32<N>::get(); }
+    static void rfft(const rfft_t *S, sample_t *p) {
+        arm_rfft_fast_inplace_f32(S, p, 0);
+    }
+    static void mag(const sample_t *in, sample_t *out, int n) {
+        arm_cmplx_mag_f32(in, out, n);
+    }
+    static void power(const sample_t *mag, float, float *out, int n) {
+        arm_mult_f32(mag, mag, out, n);
+    }
+    static void band_sum(const sample_t *mag, const arm_band_range *bands, int n, float *out) {
+        arm_band_sum_f32(mag, bands, n, out);
+    }
+};
+
+// prec_f32 with the two-line alpha-max-plus-beta-min magnitude: no
+// square root per bin, each bin within 0.971 % (1.94 % in the smoothed
+// power path). Only windows right at a threshold can flip.
+struct prec_f32_approx : prec_f32 {
+    static void mag(const sample_t *in, sample_t *out, int n) {
+        arm_cmplx_mag_approx_refined_f32(in, out, n);
+    }
+};
+
+#if defined(ARM_FLOAT16_SUPPORTED)
+// Half the working set of prec_f32. arm_cmplx_mag_f16 squares in f16,
+// which overflows above |X| = 256, while small accel swings underflow
+// if scaled down with the gyro. Block scaling keeps sum |x| near 128,
+// which bounds every |X| below it.
+struct prec_f16 {
+    typedef float16_t sample_t;
+    typedef arm_rfft_fast_instance_f16 rfft_t;
+
+    static constexpr bool block_scaled = true;
+
+    // Largest power of two 2^k with 2^k * sum_abs <= 128.
+    static float window_scale(float sum_abs) {
+        if (sum_abs <= 0.0f) return 1.0f;
+        int e;
+        frexpf(128.0f / sum_abs, &e);
+        return ldexpf(1.0f, e - 1);
+    }
+
+    template <int N> static const rfft_t *instance() { return rfft_const_f16<N>::get(); }
+    static void rfft(const rfft_t *S, sample_t *p) {
+        arm_rfft_fast_inplace_f16(S, p, 0);
+    }
+    static void mag(const sample_t *in, sample_t *out, int n) {
+        arm_cmplx_mag_f16(in, out, n);
+    }
+    // squared in f32: (mag * gain)^2 is far outside the f16 range
+    static void power(const sample_t *mag, float gain, float *out, int n) {
+        for (int k=0; k < n; k++) {
+            float m = (float)mag[k] * gain;
+            out[k] = m * m;
+        }
+    }
+    // accumulated in f32, the caller applies the gain
+    static void band_sum(const sample_t *mag, const arm_band_range *bands, int n, float *out) {
+        for (int i=0; i < n; i++) {
+            float sum = 0;
+            for (int k=bands[i].start; k < bands[i].end; k++) sum += (float)mag[k];
+            out[i] = sum;
+        }
+    }
+};
+#endif
+
+// Work of an N-point transform, counted as N log2 N: what the front
+// ends compare their schedules by.
+constexpr long long fft_work(int n) {
+    return n > 1 ? (long long)n + 2 * fft_work(n / 2) : 0;
+}
+
+// ========= WINDOW TO SPECTRUM =========
+// DC removal + zero padding + in-place FFT + magnitude, for a window of
+// Samples values in an FftSize-point transform. mag * gain is the
+// unscaled magnitude. The mean and the sums are kept in f32 whatever
+// the sample type.
+template <int Samples, int FftSize, class Prec>
+struct fft_stage {
+    typedef typename Prec::sample_t sample_t;
+
+    static constexpr int bins = FftSize / 2;
+    static_assert(Samples <= FftSize, "window does not fit the FFT");
+    static_assert((FftSize & (FftSize - 1)) == 0, "FFT size must be a power of two");
+
+    sample_t buf[FftSize];      // the window in, its packed spectrum out
+    sample_t mag[FftSize/2];
+    float gain;
+
+    void run(const sample_t *x) {
+        float mean = 0;
+        for (int i=0; i < Samples; i++) mean += (float)x[i];
+        mean /= (float)Samples;
+
+        float scale = 1.0f;
+        if (Prec::block_scaled) {
+            float sum_abs = 0;
+            for (int i=0; i < Samples; i++) sum_abs += fabsf((float)x[i] - mean);
+            scale = Prec::window_scale(sum_abs);
+        }
+        gain = 1.0f / scale;
+
+        if (Prec::block_scaled) {
+            for (int i=0; i < Samples; i++)
+                buf[i] = (sample_t)(((float)x[i] - mean) * scale);
+        } else {
+            for (int i=0; i < Samples; i++)
+                buf[i] = x[i] - mean;
+        }
+        for (int i=Samples; i < FftSize; i++)
+            buf[i] = (sample_t)0.0f;
+
+        Prec::rfft(Prec::template instance<FftSize>(), buf);
+        Prec::mag(buf, mag, bins);
+    }
+
+    // Sums of the [first, last] bins of A and B in one Prec::band_sum
+    // call, unscaled.
+    template <class A, class B> void band_sums(float &a, float &b) const {
+        static const arm_band_range t[2] = {
+            { (uint16_t)A::first, (uint16_t)(A::last + 1) },
+            { (uint16_t)B::first, (uint16_t)(B::last + 1) },
+        };
+        float out[2];
+        Prec::band_sum(mag, t, 2, out);
+        if (Prec::block_scaled) {
+            out[0] *= gain;
+            out[1] *= gain;
+        }
+        a = out[0];
+        b = out[1];
+    }
+};
+
+// ========= SPECTRAL AVERAGING =========
+// Exponentially weighted power per bin across hops, for Bins values.
+// update() takes this hop's power and leaves the running average in
+// avg; the first hop after set_time_constant() seeds it.
+template <int Bins>
+class SpectralAverage {
+public:
+    static constexpr int bins = Bins;
+
+    SpectralAverage() : alpha(0.0f), primed(false) {}
+
+    // Time constant in hops; 0 turns averaging off.
+    void set_time_constant(float tau_hops) {
+        alpha = tau_hops > 0.0f ? 1.0f - expf(-1.0f / tau_hops) : 0.0f;
+        primed = false;
+    }
+
+    bool enabled() const { return alpha > 0.0f; }
+
+    // avg += alpha * (power - avg); power is used as scratch
+    void update(float *power) {
+        if (!primed) {
+            memcpy(avg, power, sizeof(avg));
+            primed = true;
+            return;
+        }
+        arm_sub_f32(power, avg, power, Bins);
+        arm_scale_f32(power, alpha, power, Bins);
+        arm_add_f32(avg, power, avg, Bins);
+    }
+
+    float avg[Bins];
+
+private:
+    float alpha;    // weight of the newest hop
+    bool  primed;
+};
+
+// ========= DECISION =========
+// The per-window rules on the four band sums, with their scores: each
+// test a > b has margin (a - b) / (a + b); an AND of tests takes the
+// smallest, so the sign always matches the flag.
+inline q15_t detector_margin(float a, float b) {
+    float sum = a + b;
+    if (!(sum > 0.0f)) return 0;
+    return (q15_t)((a - b) / sum * 32767.0f);
+}
+
+inline q15_t detector_min3(q15_t a, q15_t b, q15_t c) {
+    q15_t m = a < b ? a : b;
+    return m < c ? m : c;
+}
+
+inline void detector_decide(float tremor, float dysk, float walk, float fog,
+                            detector_result &r) {
+    float fog_ratio = fog / (walk + 0.0001f);
+
+    // ======= LOGIC =======
+    bool tremor_present = tremor > 5.0f;
+    bool dysk_present   = dysk   > 5.0f;
+    bool low_walk       = walk < 5.0f;
+
+    bool freezing = false;
+    if (fog_ratio > 3.0f && low_walk && !dysk_present)
+        freezing = true;
+
+    r.tremor    = tremor;
+    r.dysk      = dysk;
+    r.walk      = walk;
+    r.fog       = fog;
+    r.fog_ratio = fog_ratio;
+    r.tremor_present = tremor_present;
+    r.freezing  = freezing;
+    r.is_tremor = low_walk && tremor_present && tremor > dysk * 1.2f;
+    r.is_dysk   = low_walk && dysk_present && dysk > tremor * 1.2f;
+
+    // ======= SCORES =======
+    q15_t m_low_walk = detector_margin(5.0f, walk);
+    q15_t m_tremor   = detector_margin(tremor, 5.0f);
+    q15_t m_dysk     = detector_margin(dysk, 5.0f);
+
+    r.score[SYM_TREMOR] = detector_min3(m_low_walk, m_tremor, detector_margin(tremor, dysk * 1.2f));
+    r.score[SYM_DYSK]   = detector_min3(m_low_walk, m_dysk, detector_margin(dysk, tremor * 1.2f));
+    r.score[SYM_FREEZE] = detector_min3(detector_margin(fog_ratio, 3.0f), m_low_walk, (q15_t)-m_dysk);
+    r.score[SYM_TREMOR_PRESENT] = m_tremor;
+}
+
+// ========= DETECTOR =========
+// One analysis configuration. Buffer sizes, bin ranges and scaling are
+// all fixed at compile time, so several configurations can live in one
+// binary (see tools/bench). Has no hardware dependencies; the board and
+// the host tools run the same code.
+template <int SampleRate, int WindowSec, int FftSize, class Bands,
+          class Prec = prec_f32>
+class Detector {
+public:
+    typedef typename Prec::sample_t sample_t;
+    typedef Prec prec_t;
+
+    static constexpr int   sample_rate = SampleRate;
+    static constexpr int   window_sec  = WindowSec;
+    static constexpr int   raw_samples = SampleRate * WindowSec;
+    static constexpr int   fft_size    = FftSize;
+    static constexpr int   bins        = FftSize / 2;
+    static constexpr float hz_per_bin  = (float)SampleRate / FftSize;
+
+    static_assert(raw_samples <= FftSize, "window does not fit the FFT");
+    static_assert((FftSize & (FftSize - 1)) == 0, "FFT size must be a power of two");
+
+    // two transforms per window
+    static constexpr long long fft_work_per_s = 2 * fft_work(FftSize) * SampleRate / raw_samples;
+
+    template <class B> using bin_range = fft_bins<SampleRate, FftSize, B>;
+
+    typedef bin_range<typename Bands::walk>   walk_bins;
+    typedef bin_range<typename Bands::fog>    fog_bins;
+    typedef bin_range<typename Bands::tremor> tremor_bins;
+    typedef bin_range<typename Bands::dysk>   dysk_bins;
+    typedef bin_range<typename Bands::span>   span_bins;
+
+    // Nothing to build: the FFT instance is a const struct in flash.
+    // Kept so every stage of the graph has the same init().
+    void init() {}
+
+    // Band powers from spectra averaged over hops (see SpectralAverage)
+    // instead of the current window alone. 0 hops = off, the default.
+    void set_smoothing(float tau_hops) {
+        accel_avg.set_time_constant(tau_hops);
+        gyro_avg.set_time_constant(tau_hops);
+    }
+
+    // Runs one analysis hop over raw_samples accel / gyro magnitudes.
+    void analyze(const sample_t *accel, const sample_t *gyro, detector_result &r) {
+        no_sink sink;
+        analyze(accel, gyro, r, sink);
+    }
+
+    // Same, but hands each magnitude spectrum (bins values of sample_t,
+    // to be multiplied by gain) to the sink before it is overwritten:
+    // sink.accel_spectrum(mag, gain) and sink.gyro_spectrum(mag, gain).
+    // See spectrogram.h.
+    template <class Sink>
+    void analyze(const sample_t *accel, const sample_t *gyro, detector_result &r,
+                 Sink &sink) {
+
+        // ======= ACCEL FFT FOR WALK + FREEZE =======
+        fft.run(accel);
+        sink.accel_spectrum(fft.mag, fft.gain);
+        smooth(accel_avg);
+        float walk, fog;
+        band_sums<walk_bins, fog_bins>(walk, fog);
+
+        // ======= GYRO FFT FOR TREMOR + DYSK =======
+        fft.run(gyro);
+        sink.gyro_spectrum(fft.mag, fft.gain);
+        smooth(gyro_avg);
+        float tremor, dysk;
+        band_sums<tremor_bins, dysk_bins>(tremor, dysk);
+
+        detector_decide(tremor, dysk, walk, fog, r);
+    }
+
+private:
+    struct no_sink {
+        void accel_spectrum(const sample_t *, float) {}
+        void gyro_spectrum(const sample_t *, float) {}
+    };
+
+    fft_stage<raw_samples, FftSize, Prec> fft;     // shared by accel and gyro
+
+    static constexpr int span_len = span_bins::last - span_bins::first + 1;
+
+    SpectralAverage<span_len> accel_avg, gyro_avg;
+    float smoothed[span_len];   // averaged magnitudes over span_bins
+    bool  use_smoothed = false;
+
+    // Power of the span bins into the average, and its square root
+    // back as the magnitudes the band sums use.
+    void smooth(SpectralAverage<span_len> &avg) {
+        use_smoothed = avg.enabled();
+        if (!use_smoothed) return;
+
+        Prec::power(fft.mag + span_bins::first, fft.gain, smoothed, span_len);
+        avg.update(smoothed);
+        for (int k=0; k < span_len; k++) arm_sqrt_f32(avg.avg[k], &smoothed[k]);
+    }
+
+    template <class R> static constexpr bool in_span() {
+        return R::first >= span_bins::first && R::last <= span_bins::last;
+    }
+
+    // Both bands of one spectrum in a single arm_band_sum_f32 call. The
+    // tables are [start, end) ranges, relative to the span for smoothed.
+    template <class A, class B> void band_sums(float &a, float &b) const {
+        static_assert(in_span<A>() && in_span<B>(), "band outside the span");
+        if (!use_smoothed) {
+            fft.template band_sums<A, B>(a, b);
+            return;
+        }
+        static const arm_band_range t[2] = {
+            { (uint16_t)(A::first - span_bins::first), (uint16_t)(A::last + 1 - span_bins::first) },
+            { (uint16_t)(B::first - span_bins::first), (uint16_t)(B::last + 1 - span_bins::first) },
+        };
+        float out[2];
+        arm_band_sum_f32(smoothed, t, 2, out);
+        a = out[0];
+        b = out[1];
+    }
+};
+
+// ========= BOARD CONFIGURATION =========
+// 52 Hz, 3 s window (156 samples), 256-point FFT. Build with
+// -DDETECTOR_F16 (and -mfp16-format=ieee on Arm) for the half-precision
+// pipeline, meant for parts with f16 vector units, or -DDETECTOR_FASTMAG
+// for the approximate magnitude.
+#if defined(DETECTOR_F16)
+typedef Detector<52, 3, 256, parkinson_bands, prec_f16> board_detector;
+#elif defined(DETECTOR_FASTMAG)
+typedef Detector<52, 3, 256, parkinson_bands, prec_f32_approx> board_detector;
+#else
+typedef Detector<52, 3, 256, parkinson_bands> board_detector;
+#endif
+
+#endif
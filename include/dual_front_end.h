@@ -0,0 +1,124 @@
+#ifndef DUAL_FRONT_END_H
+#define DUAL_FRONT_END_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "detector.h"
+
+// ========= DUAL-RESOLUTION FRONT END =========
+// Two spectral paths, each sized for its symptoms, writing one shared
+// feature set:
+//
+//   fast   gyro,  FastFft-sample window, a spectrum every FastHop
+//          samples                                  -> tremor, dysk
+//   slow   accel, SlowFft-sample window, a spectrum every SlowHop
+//          samples                                  -> walk, fog
+//
+// Tremor and dyskinesia follow the short transform's quick hops; gait
+// gets the finer low-frequency bins of the long one. Windows fill the
+// whole transform (no zero padding) and slide by their hop. Samples
+// arrive FastHop at a time; the slow path runs on the hops where its
+// window is due.
+//
+// Band sums are scaled by RefFft / FftSize: the band sum of a tone
+// grows with the transform length, so this keeps the thresholds of
+// detector_decide(), tuned for a RefFft-point detector, meaningful.
+
+struct spectral_features {
+    float tremor, dysk;         // fast path, gyro
+    float walk, fog;            // slow path, accel
+    uint32_t fast_runs;         // spectra so far; 0 = features not valid yet
+    uint32_t slow_runs;
+    uint32_t slow_age;          // fast hops since the slow path last ran
+};
+
+template <int SampleRate, int FastFft, int FastHop, int SlowFft, int SlowHop,
+          class Bands, class Prec = prec_f32, int RefFft = 256>
+class DualFrontEnd {
+public:
+    typedef typename Prec::sample_t sample_t;
+
+    static constexpr int sample_rate = SampleRate;
+    static constexpr int fast_fft = FastFft;
+    static constexpr int fast_hop = FastHop;
+    static constexpr int slow_fft = SlowFft;
+    static constexpr int slow_hop = SlowHop;
+
+    static_assert(FastHop > 0 && FastFft % FastHop == 0,
+                  "fast window must be a whole number of hops");
+    static_assert(SlowFft % FastHop == 0 && SlowHop % FastHop == 0 && SlowHop <= SlowFft,
+                  "slow window and hop must be whole numbers of fast hops");
+
+    typedef fft_bins<SampleRate, FastFft, typename Bands::tremor> tremor_bins;
+    typedef fft_bins<SampleRate, FastFft, typename Bands::dysk>   dysk_bins;
+    typedef fft_bins<SampleRate, SlowFft, typename Bands::walk>   walk_bins;
+    typedef fft_bins<SampleRate, SlowFft, typename Bands::fog>    fog_bins;
+
+    static constexpr long long fft_work_per_s =
+        fft_work(FastFft) * SampleRate / FastHop + fft_work(SlowFft) * SampleRate / SlowHop;
+
+    void init() {
+        gyro_fill = accel_fill = 0;
+        memset(&f, 0, sizeof(f));
+    }
+
+    // FastHop new accel / gyro magnitudes. Returns true when the slow
+    // path ran on this hop.
+    bool hop(const sample_t *accel, const sample_t *gyro) {
+        memcpy(gyro_win + gyro_fill, gyro, FastHop * sizeof(sample_t));
+        gyro_fill += FastHop;
+        if (gyro_fill == FastFft) {
+            fast.run(gyro_win);
+            fast.template band_sums<tremor_bins, dysk_bins>(f.tremor, f.dysk);
+            f.tremor *= fast_scale;
+            f.dysk   *= fast_scale;
+            f.fast_runs++;
+            gyro_fill -= FastHop;
+            memmove(gyro_win, gyro_win + FastHop, gyro_fill * sizeof(sample_t));
+        }
+
+        memcpy(accel_win + accel_fill, accel, FastHop * sizeof(sample_t));
+        accel_fill += FastHop;
+        f.slow_age++;
+        if (accel_fill < SlowFft) return false;
+
+        slow.run(accel_win);
+        slow.template band_sums<walk_bins, fog_bins>(f.walk, f.fog);
+        f.walk *= slow_scale;
+        f.fog  *= slow_scale;
+        f.slow_runs++;
+        f.slow_age = 0;
+        accel_fill -= SlowHop;
+        memmove(accel_win, accel_win + SlowHop, accel_fill * sizeof(sample_t));
+        return true;
+    }
+
+    const spectral_features &features() const { return f; }
+
+private:
+    static constexpr float fast_scale = (float)RefFft / FastFft;
+    static constexpr float slow_scale = (float)RefFft / SlowFft;
+
+    sample_t gyro_win[FastFft];
+    sample_t accel_win[SlowFft];
+    int gyro_fill, accel_fill;
+
+    fft_stage<FastFft, FastFft, Prec> fast;
+    fft_stage<SlowFft, SlowFft, Prec> slow;
+
+    spectral_features f;
+};
+
+// ========= BOARD CONFIGURATION =========
+// 52 Hz, same precision as board_detector. Gyro: 128 points (0.41
+// Hz/bin), a new spectrum every 64 samples (1.23 s). Accel: 512 points
+// (0.10 Hz/bin), every 512 samples (9.8 s). Transform work is held
+// below the board detector's two 256-point FFTs per 3 s window.
+typedef DualFrontEnd<52, 128, 64, 512, 512, parkinson_bands,
+                     board_detector::prec_t, board_detector::fft_size> board_dual;
+
+static_assert(board_dual::fft_work_per_s < board_detector::fft_work_per_s,
+              "dual front end over the board detector's transform budget");
+
+#endif
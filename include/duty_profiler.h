@@ -0,0 +1,34 @@
+#ifndef DUTY_PROFILER_H
+#define DUTY_PROFILER_H
+
+#include <stdint.h>
+
+// ========= DUTY-CYCLE PROFILER =========
+// The main loop announces which stage it is in; time between switches is
+// charged to the stage being left. Stage 0 is idle (asleep), so
+// active time is everything else. Uses the shared cycle_clock.
+
+#define DUTY_IDLE       0
+#define DUTY_ACQ        1
+#define DUTY_ANA        2
+#define DUTY_IO         3
+#define DUTY_STAGES     4
+
+struct duty_report {
+    uint32_t period;                 // cycles covered by the report
+    uint32_t wakes;                  // transitions out of idle
+    uint32_t cycles[DUTY_STAGES];
+};
+
+void duty_init();
+void duty_switch(int stage);
+
+// Fills r with the totals since the last report and starts a new period.
+void duty_take(duty_report &r);
+
+// Stage share of the period in 0.1 % units.
+uint32_t duty_permille(const duty_report &r, int stage);
+
+extern const char *const duty_names[DUTY_STAGES];
+
+#endif
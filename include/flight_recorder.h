@@ -0,0 +1,64 @@
+#ifndef FLIGHT_RECORDER_H
+#define FLIGHT_RECORDER_H
+
+#include <stdint.h>
+#include "imu.h"
+
+// ========= FLIGHT RECORDER =========
+// Keeps raw 6-axis samples around detected episodes without streaming.
+// The block being recorded is itself the pre-trigger ring: every sample
+// is written into it, and on a trigger it keeps going for FR_POST
+// samples and is then handed to the consumer queue as-is (no copy). A
+// free block takes over as the new pre-trigger ring.
+//
+// Memory: FR_BLOCKS * (FR_PRE + FR_POST) * 12 B of samples
+//         = 3 * 520 * 12 B = 18.7 KB at the defaults.
+
+#define FR_PRE      (6 * 52)    // 6 s: the 3 s window that fired + 3 s before
+#define FR_POST     (4 * 52)    // 4 s after the trigger
+#define FR_LENGTH   (FR_PRE + FR_POST)
+#define FR_BLOCKS   3           // one recording + up to two queued
+
+#define FR_TREMOR   (1u << 0)
+#define FR_DYSK     (1u << 1)
+#define FR_FREEZE   (1u << 2)
+
+struct flight_block {
+    uint32_t seq;
+    uint32_t trigger_sample;   // sample counter value at the trigger
+    uint32_t reason;           // FR_* bits
+    uint16_t lag;              // samples between the window end and the trigger
+    uint16_t pre;              // valid samples before the trigger
+    uint16_t post;             // samples after it
+    uint16_t start;            // ring index of the oldest sample
+    int16_t  samples[FR_LENGTH][IMU_AXES];
+};
+
+struct flight_stats {
+    uint32_t captured;
+    uint32_t dropped;          // triggers with no free block
+    uint32_t merged;           // triggers during a post-trigger capture
+};
+
+void flight_init();
+
+// Producer side, called for every sample (acquisition context). O(1).
+void flight_push(const int16_t raw[IMU_AXES]);
+
+// Starts the post-trigger phase. lag is how many samples were pushed
+// after the end of the analysis window that fired, so the window can be
+// found again in the block. Reason bits of triggers arriving while a
+// capture is already running are merged into it.
+void flight_trigger(uint32_t reason, uint32_t lag);
+
+// Consumer side (storage / telemetry). Returns the oldest finished
+// block or 0; the block stays owned by the consumer until released.
+flight_block *flight_next();
+void flight_release(flight_block *b);
+
+// i-th sample of a finished block in time order, 0 = oldest.
+const int16_t *flight_sample(const flight_block *b, int i);
+
+const flight_stats &flight_get_stats();
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef GAIT_METRICS_H
+#define GAIT_METRICS_H
+
+#include <stdint.h>
+
+// ========= GAIT QUALITY =========
+// Built on the step detector. Per step, in bounded time:
+//
+//   stride CV    std / mean of stride times (two steps) over the last
+//                GAIT_STRIDES strides, from running integer sums
+//   asymmetry    |mean odd step - mean even step| / mean step. With one
+//                sensor left and right are not known, but they alternate
+//   regularity   unbiased autocorrelation of the gait band signal at one
+//                step and one stride of lag, over the last GAIT_ACF_LEN
+//                samples (1 = identical steps / strides)
+//
+// Regularity costs O(GAIT_ACF_LEN) per step, not O(1): GAIT_ACF_LEN MACs
+// for lag 0 and three dot products of GAIT_ACF_LEN - lag around each of
+// the two lags. At 110 steps/min (lags 28 and 56) that is ~1,540 MACs,
+// at most 7 GAIT_ACF_LEN = 1,792. At roughly 3 cycles per MAC for
+// arm_dot_prod_f32 on the M4 (an estimate, not measured on the board)
+// that is ~5k cycles (~60 us at 80 MHz) in the wake a step lands in,
+// ~10k cycles/s while walking. Running lagged sums would be O(1) per
+// sample per lag, but every cadence change that moves a lag rebuilds
+// one in O(GAIT_ACF_LEN), and f32 add / subtract drifts over a bout.
+//
+// A pause longer than STEP_MAX_GAP starts a new bout and clears the
+// rings. Metrics are averaged per minute of samples and queued for
+// export (gait_minute_take).
+
+#define GAIT_STRIDES   16
+#define GAIT_STEPS     (2 * GAIT_STRIDES)   // even, see gait_step()
+#define GAIT_ACF_LEN   256                  // ~5 s at 52 Hz
+#define GAIT_MIN_STEPS 6                    // before metrics are valid
+#define GAIT_MINUTES   4                    // minute records queued
+
+struct gait_metrics {
+    bool  valid;
+    float step_s;           // mean step time
+    float stride_s;         // mean stride time
+    float stride_cv;
+    float asymmetry;
+    float step_reg;
+    float stride_reg;
+};
+
+struct gait_minute {
+    uint32_t minute;        // since gait_init()
+    uint32_t steps;
+    uint32_t scored;        // steps with valid metrics, averaged below
+    float    stride_s;
+    float    stride_cv;
+    float    asymmetry;
+    float    step_reg;
+    float    stride_reg;
+};
+
+void gait_init();
+
+// Gait band samples in time order (step_push() can hand them out).
+void gait_samples(const float *band, int n);
+
+// One step at sample index t, in time order.
+void gait_step(uint32_t t);
+
+void gait_get(gait_metrics &m);
+
+// Oldest finished minute, false if none.
+bool gait_minute_take(gait_minute &m);
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef GYRO_BIAS_H
+#define GYRO_BIAS_H
+
+#include <stdint.h>
+
+#include "imu.h"
+
+// ========= GYRO ZERO-RATE BIAS =========
+// The gyro reads a few dps with the wrist still, drifting with
+// temperature. Through the vector magnitude that offset is a floor under
+// every rotation, different on every part, so it is estimated online and
+// subtracted per axis.
+//
+// Samples are summed in blocks of GB_BLOCK (integer sums, O(1) per
+// sample). A block is still when every gyro and accel axis varies less
+// than the thresholds below and its mean rate is a plausible zero-rate
+// level; each still block's mean is folded into the bias, as a running
+// mean over the first GB_SETTLE still blocks and a moving average with
+// that time constant after. Slow wrist drift with no tremor passes as
+// still too; averaged over many rests it cancels.
+//
+// The estimate is saved (gyro_bias_cal) so the next boot starts
+// calibrated and keeps refining.
+
+#define GB_BLOCK        52          // samples, 1 s
+#define GB_SETTLE       64          // still blocks
+#define GB_GYRO_STILL   0.5f        // dps rms, per axis
+#define GB_ACCEL_STILL  0.02f       // g rms, per axis
+#define GB_MAX_BIAS     10.0f       // dps; LSM6DSL zero-rate level is ±10
+#define GB_SAVE_DPS     0.1f        // change worth a flash write
+
+struct gyro_bias {
+    float    bias[3];               // dps
+    uint32_t still;                 // still blocks folded in, up to GB_SETTLE
+    uint32_t blocks, still_blocks;  // since init, for reporting
+
+    int      n;
+    int32_t  sum[IMU_AXES];
+    int64_t  sq[IMU_AXES];
+    int64_t  limit[2];              // variance limits, accel / gyro, in n² · LSB²
+};
+
+// A saved calibration.
+#define GB_CAL_MAGIC    0x47425331u  // "GBS1"
+
+struct gyro_bias_cal {
+    uint32_t magic;
+    float    bias[3];
+    uint32_t still;
+    uint32_t check;                 // hash of the fields above
+};
+
+void gyro_bias_init(gyro_bias &b);
+
+// Adds one raw sample; true when it completed a still block and the
+// bias moved.
+bool gyro_bias_push(gyro_bias &b, const int16_t raw[IMU_AXES]);
+
+// The rate with the bias taken off, dps per axis.
+static inline void gyro_bias_rate(const gyro_bias &b, const int16_t raw[IMU_AXES], float w[3]) {
+    for (int i=0; i < 3; i++) w[i] = raw[3 + i] * GYRO_DPS_PER_LSB - b.bias[i];
+}
+
+// Orientation-free |rate| with the bias taken off, dps.
+static inline float gyro_bias_magnitude(const gyro_bias &b, const int16_t raw[IMU_AXES]) {
+    float w[3];
+    gyro_bias_rate(b, raw, w);
+    return sqrtf(w[0]*w[0] + w[1]*w[1] + w[2]*w[2]);
+}
+
+void gyro_bias_save(const gyro_bias &b, gyro_bias_cal &c);
+
+// True once the estimate has settled and any axis moved GB_SAVE_DPS away
+// from the saved one (saved.magic 0: never saved).
+bool gyro_bias_save_due(const gyro_bias &b, const gyro_bias_cal &saved);
+
+// Starts from a saved calibration; false (and nothing changed) if the
+// record is blank or damaged. A restored estimate counts as half settled,
+// so it follows a change of temperature faster than a full one.
+bool gyro_bias_restore(gyro_bias &b, const gyro_bias_cal &c);
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef IMU_H
+#define IMU_H
+
+#include <stdint.h>
+#include <math.h>
+
+// ========= LSM6DSL SCALING =========
+// Raw 6-axis sample order: accel x,y,z then gyro x,y,z.
+#define IMU_AXES        6
+#define ACCEL_G_PER_LSB 0.000061f   // ±2 g
+#define GYRO_DPS_PER_LSB 0.00875f   // ±250 dps
+
+// Orientation-free accel magnitude. The gyro's is taken after its
+// zero-rate bias is removed (gyro_bias_magnitude, gyro_bias.h).
+static inline float imu_accel_magnitude(const int16_t raw[IMU_AXES]) {
+    float ax = raw[0] * ACCEL_G_PER_LSB;
+    float ay = raw[1] * ACCEL_G_PER_LSB;
+    float az = raw[2] * ACCEL_G_PER_LSB;
+    return sqrtf(ax*ax + ay*ay + az*az);
+}
+
+#endif
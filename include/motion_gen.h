@@ -0,0 +1,111 @@
+#ifndef MOTION_GEN_H
+#define MOTION_GEN_H
+
+#include <stdint.h>
+#include "imu.h"
+
+// ========= SYNTHETIC MOTION =========
+// Deterministic 6-axis IMU streams with known symptoms, as the LSM6DSL
+// delivers them after init_sensor() (52 Hz, raw counts at ±2 g /
+// ±250 dps). A stream is a sequence of segments; each segment may have
+//
+//   tremor       rotational oscillation (pronation / supination, mostly
+//                about x) at a given frequency and peak rate
+//   dyskinesia   bursts of 0.5-2 s at a jittered frequency about a random
+//                axis mix, raised-cosine envelope
+//   walking      vertical bounce at the step frequency (plus a harmonic)
+//                and arm swing at the stride frequency
+//   freezing     trembling in place: 3-8 Hz vertical shake, no gait bounce
+//
+// On top of every segment: gravity through a slowly wandering wrist
+// orientation, per-axis gyro zero-rate bias doing a random walk, white
+// sensor noise, and saturation at the int16 output range. Rotations move
+// gravity in the accel axes the way they would on the wrist.
+//
+// All randomness comes from a per-generator LCG, so a seed gives the
+// same stream on the board and on the host. Sines are arm_sin_f32 /
+// arm_cos_f32 on wrapped phases, only for the active components.
+//
+// Without a script, segments are drawn at random (motion_random_segment)
+// so corpora of any length can be produced from a seed.
+
+#define MOTION_RATE      52          // Hz, as the detector
+
+// Label bits, per sample
+#define MOTION_TREMOR    (1u << 0)
+#define MOTION_DYSK      (1u << 1)
+#define MOTION_WALK      (1u << 2)
+#define MOTION_FREEZE    (1u << 3)
+
+// Zero amplitude means the component is off.
+struct motion_segment {
+    float seconds;
+    float tremor_hz, tremor_dps;
+    float dysk_hz, dysk_dps;
+    float cadence_spm, step_g;
+    float fog_hz, fog_g;
+};
+
+struct motion_config {
+    float noise_g;              // accel white noise, rms
+    float noise_dps;            // gyro white noise, rms
+    float bias_dps;             // initial zero-rate bias, up to ± per axis
+    float bias_walk_dps;        // bias random walk, rms per sqrt(s)
+    float wander_deg;           // orientation wander, peak per component
+    float wander_hz;            // its fastest component
+};
+
+struct motion_stats {
+    uint32_t samples;
+    uint32_t segments;
+    uint32_t steps;             // generated, for step detector checks
+    uint32_t saturated;         // samples with any axis clipped
+};
+
+struct motion_gen {
+    motion_config cfg;
+    uint32_t rng;
+
+    const motion_segment *script;
+    int script_len, script_pos;
+    bool pending_fog;           // a random walk segment ends in a freeze
+
+    motion_segment seg;
+    uint32_t seg_left;          // samples
+    uint32_t labels;
+
+    // phases in radians, [0, 2 pi)
+    float ph_tremor, ph_dysk, ph_step, ph_fog;
+
+    // dyskinesia burst
+    uint32_t burst_len, burst_pos, burst_gap;
+    float burst_hz, burst_axis[3];
+
+    // wander: roll and pitch are each the sum of two slow sines
+    float ph_wander[4], hz_wander[4];
+    float bias[3];              // dps
+
+    motion_stats stats;
+};
+
+void motion_default_config(motion_config &c);
+
+// cfg == 0 uses motion_default_config().
+void motion_init(motion_gen &g, uint32_t seed, const motion_config *cfg = 0);
+
+// Plays segments in order, then repeats them. n == 0 goes back to
+// random segments.
+void motion_script(motion_gen &g, const motion_segment *segs, int n);
+
+// Draws a segment from the built-in ranges: rest, tremor at rest,
+// dyskinesia, walking, or walking that freezes (the freeze is returned
+// by the next call).
+void motion_random_segment(motion_gen &g, motion_segment &s);
+
+uint32_t motion_labels(const motion_segment &s);
+
+// Writes n samples (accel x,y,z then gyro x,y,z) and, if labels is
+// given, their MOTION_* bits.
+void motion_generate(motion_gen &g, int16_t (*raw)[IMU_AXES], uint8_t *labels, int n);
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef PACKETIZER_H
+#define PACKETIZER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "telemetry.h"
+
+// ========= PACKETIZER =========
+// Sits between the analysis outputs and any transport. A radio costs far
+// more per packet (wake-up, preamble, connection event) than per byte,
+// so telemetry frames (telemetry.h) are queued and sent several per
+// packet, up to the transport's MTU:
+//
+//   urgent   episode events; due urgent_ms after queueing (0: at the
+//            next pk_poll)
+//   routine  window results, hourly summaries, instrumentation; due
+//            flush_ms after the oldest was queued
+//
+// A packet goes out when a queue's oldest frame is due or when the
+// routine frames fill an MTU. It takes urgent frames first and fills the
+// rest with routine ones, so routine data rides along with events for
+// free. Frames are never split; a packet is whole frames back to back,
+// which tm_decode() reads unchanged. A full queue drops the new frame
+// (counted); urgent and routine frames have separate space.
+//
+// No allocation, no clock: callers pass the time in ms.
+
+#define PK_QUEUE_BYTES  2048    // per priority
+#define PK_MAX_MTU      512
+
+enum { PK_ROUTINE, PK_URGENT, PK_PRIORITIES };
+
+// Sends one packet; false if the transport could not take it (the frames
+// stay queued and are tried again at the next poll).
+typedef bool (*pk_send_fn)(void *ctx, const uint8_t *p, size_t n);
+
+struct pk_config {
+    uint16_t mtu;               // payload bytes per packet, <= PK_MAX_MTU
+    uint32_t flush_ms;          // routine latency bound
+    uint32_t urgent_ms;         // urgent latency bound
+};
+
+struct pk_stats {
+    uint32_t frames, bytes;     // queued
+    uint32_t packets, sent_bytes;
+    uint32_t full, due, urgent; // packets sent because full / routine due / urgent due
+    uint32_t dropped[PK_PRIORITIES];
+    uint32_t send_failed;
+    uint32_t max_delay_ms[PK_PRIORITIES];   // queue to packet
+};
+
+struct pk_queue {
+    // entries: u16 length, u32 time queued, frame bytes
+    uint8_t  buf[PK_QUEUE_BYTES];
+    uint16_t head, tail;        // bytes; head == tail: empty
+    uint16_t frames, bytes;     // queued frames and their bytes
+};
+
+struct packetizer {
+    pk_config cfg;
+    pk_send_fn send;
+    void *ctx;
+    uint32_t device;
+    uint16_t seq;
+    pk_queue q[PK_PRIORITIES];
+    pk_stats st;
+};
+
+void pk_init(packetizer &p, const pk_config &cfg, uint32_t device, pk_send_fn send, void *ctx);
+
+// Encodes a telemetry frame (next sequence number) and queues it.
+// False if it was dropped: queue full, or the frame exceeds the MTU.
+bool pk_put(packetizer &p, int prio, uint8_t type, const void *payload, size_t len, uint32_t now_ms);
+
+// Sends the packets that are due. Call after pk_put() and whenever
+// pk_next_due() has passed.
+void pk_poll(packetizer &p, uint32_t now_ms);
+
+// Sends everything queued, due or not.
+void pk_flush(packetizer &p, uint32_t now_ms);
+
+// ms until the next packet is due, UINT32_MAX with nothing queued; for
+// sleep scheduling.
+uint32_t pk_next_due(const packetizer &p, uint32_t now_ms);
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+
+// ========= EVENT SCHEDULER =========
+// Interrupt handlers post event bits; the main loop waits for them and
+// sleeps in between. The idle hook is supplied by the platform: WFI on
+// the board, a simulated clock jump in tools/dutysim.
+
+#define EVT_SENSOR   (1u << 0)   // data-ready / FIFO watermark from the IMU
+#define EVT_ANALYZE  (1u << 1)   // a full window is ready
+#define EVT_SERIAL   (1u << 2)   // command byte received
+#define EVT_LOG      (1u << 3)   // UART TX ring running low
+
+typedef void (*sched_idle_fn)(void);
+
+void sched_set_idle(sched_idle_fn idle);
+
+// Safe to call from interrupt context.
+void sched_post(uint32_t events);
+
+// Non-zero when events are waiting. The idle hook must recheck this with
+// interrupts masked before sleeping, or a post racing the call is lost
+// until the next interrupt.
+uint32_t sched_pending();
+
+// Blocks (sleeping through the idle hook) until at least one event is
+// posted, then returns and clears all pending events.
+uint32_t sched_wait();
+
+#endif
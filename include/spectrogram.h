@@ -0,0 +1,212 @@
+#ifndef SPECTROGRAM_H
+#define SPECTROGRAM_H
+
+#include <stdint.h>
+#include <math.h>
+
+// ========= CELL ENCODINGS =========
+// How one magnitude is stored in the ring. f32 is exact; q15 and log
+// halve the memory of a row.
+
+struct spec_f32 {
+    typedef float type;
+    static type  encode(float v) { return v; }
+    static float decode(type v)  { return v; }
+};
+
+// Linear q15 over [0, FullScale); larger values saturate.
+template <int FullScale>
+struct spec_q15 {
+    typedef int16_t type;
+    static type encode(float v) {
+        float q = v * (32768.0f / FullScale);
+        if (q <= 0.0f)     return 0;
+        if (q >= 32767.0f) return 32767;
+        return (type)(q + 0.5f);
+    }
+    static float decode(type v) { return v * ((float)FullScale / 32768.0f); }
+};
+
+// log2(1 + v) in q15 with 16 octaves of range (up to ~65535). A step is
+// 1/2048 octave of 1 + v, so the rounding error is at most 0.017 % of
+// 1 + v: relative precision only holds for v above ~1. Below that the
+// error is ~0.00017 absolute: ~1.7 % of a bin of 0.01 (g for the accel,
+// dps for the gyro), ~17 % at 0.001, and bins under 0.00017 read 0.
+struct spec_log_q15 {
+    typedef int16_t type;
+    static type encode(float v) {
+        if (v <= 0.0f) return 0;
+        float q = log2f(1.0f + v) * (32768.0f / 16.0f);
+        if (q >= 32767.0f) return 32767;
+        return (type)(q + 0.5f);
+    }
+    static float decode(type v) { return exp2f(v * (16.0f / 32768.0f)) - 1.0f; }
+};
+
+// ========= SPECTROGRAM RING =========
+// The last Depth magnitude spectra, keeping only bins First..Last
+// (inclusive). push() overwrites the oldest row.
+template <int First, int Last, int Depth, class Cell = spec_f32>
+class Spectrogram {
+public:
+    static constexpr int first = First;
+    static constexpr int bins  = Last - First + 1;
+    static constexpr int depth = Depth;
+
+    static_assert(bins > 0 && Depth > 0, "empty spectrogram");
+
+    Spectrogram() : head(0), count(0) {}
+
+    // mag is a full magnitude spectrum indexed by FFT bin, stored
+    // multiplied by gain.
+    template <class T>
+    void push(const T *mag, float gain = 1.0f) {
+        typename Cell::type *row = rows[head];
+        for (int b=0; b < bins; b++)
+            row[b] = Cell::encode((float)mag[First + b] * gain);
+        head = (head + 1) % Depth;
+        if (count < Depth) count++;
+    }
+
+    int frames() const { return count; }
+
+    // age 0 is the newest frame; bin is relative to First.
+    float at(int age, int bin) const {
+        return Cell::decode(rows[row_index(age)][bin]);
+    }
+
+    // Copies the newest n frames (oldest first) into out[n][bins] and
+    // returns how many were available.
+    int slice(int n, float *out) const {
+        if (n > count) n = count;
+        for (int f=0; f < n; f++) {
+            const typename Cell::type *row = rows[row_index(n - 1 - f)];
+            for (int b=0; b < bins; b++) *out++ = Cell::decode(row[b]);
+        }
+        return n;
+    }
+
+private:
+    typename Cell::type rows[Depth][bins];
+    int head;
+    int count;
+
+    int row_index(int age) const {
+        return (head - 1 - age + 2 * Depth) % Depth;
+    }
+};
+
+// ========= TIME-FREQUENCY FEATURES =========
+// Sliding-window statistics over the last Depth hops, updated in O(1)
+// per hop from values the hop produces anyway. Kept in fixed point so
+// the running sums never drift: powers in 1/16 units, peaks as bins.
+template <int Depth>
+class TremorTrend {
+public:
+    TremorTrend() : head(0), count(0), present(0), s0_pk(0), s1_pk(0),
+                    s0_pw(0), s1_pw(0) {}
+
+    void push(float power, int peak_bin, bool is_present) {
+        int32_t pw = to_fixed(power);
+
+        if (count == Depth) {
+            // drop the oldest frame, then re-index so it becomes j = 0
+            int32_t old_pw = pw_ring[head];
+            int32_t old_pk = pk_ring[head];
+            present -= pr_ring[head];
+            s1_pk -= s0_pk - old_pk;  s0_pk -= old_pk;
+            s1_pw -= s0_pw - old_pw;  s0_pw -= old_pw;
+            count--;
+        }
+
+        s1_pk += (int64_t)count * peak_bin;  s0_pk += peak_bin;
+        s1_pw += (int64_t)count * pw;        s0_pw += pw;
+        present += is_present ? 1 : 0;
+
+        pw_ring[head] = pw;
+        pk_ring[head] = peak_bin;
+        pr_ring[head] = is_present ? 1 : 0;
+        head = (head + 1) % Depth;
+        count++;
+    }
+
+    int frames() const { return count; }
+
+    // Share of the window with tremor present, 0..1.
+    float persistence() const {
+        return count ? (float)present / count : 0.0f;
+    }
+
+    // Least-squares slope of the tremor peak, in bins per hop.
+    float drift_bins() const { return slope(s0_pk, s1_pk); }
+
+    // Least-squares slope of tremor band power, per hop.
+    float onset_slope() const { return slope(s0_pw, s1_pw) / 16.0f; }
+
+private:
+    int32_t pw_ring[Depth];
+    int32_t pk_ring[Depth];
+    uint8_t pr_ring[Depth];
+    int head;
+    int count;
+    int present;
+
+    // s0 = sum y_j, s1 = sum j * y_j over j = 0 (oldest) .. count-1
+    int64_t s0_pk, s1_pk;
+    int64_t s0_pw, s1_pw;
+
+    static int32_t to_fixed(float v) {
+        float q = v * 16.0f;
+        if (q >  2.0e9f) return 2000000000;
+        if (q < -2.0e9f) return -2000000000;
+        return (int32_t)q;
+    }
+
+    float slope(int64_t s0, int64_t s1) const {
+        if (count < 2) return 0.0f;
+        int64_t n  = count;
+        int64_t sj = n * (n - 1) / 2;
+        int64_t sjj = (n - 1) * n * (2 * n - 1) / 6;
+        int64_t den = n * sjj - sj * sj;
+        return (float)(n * s1 - sj * s0) / (float)den;
+    }
+};
+
+// ========= DETECTOR SINK =========
+// Pass to Detector::analyze() to keep the 0.5-8 Hz part of both spectra
+// and track tremor trends without recomputing any transform.
+template <class D, int Depth, class Cell = spec_f32>
+class SpectralHistory {
+public:
+    typedef Spectrogram<D::span_bins::first, D::span_bins::last, Depth, Cell> grid;
+
+    grid accel;
+    grid gyro;
+    TremorTrend<Depth> tremor;
+
+    typedef typename D::sample_t sample_t;
+
+    void accel_spectrum(const sample_t *mag, float gain) { accel.push(mag, gain); }
+
+    void gyro_spectrum(const sample_t *mag, float gain) {
+        gyro.push(mag, gain);
+
+        typedef typename D::tremor_bins tb;
+        float power = 0, peak = -1.0f;
+        int peak_bin = tb::first;
+        for (int k=tb::first; k <= tb::last; k++) {
+            float m = (float)mag[k];
+            power += m;
+            if (m > peak) { peak = m; peak_bin = k; }
+        }
+        power *= gain;
+        tremor.push(power, peak_bin, power > 5.0f);
+    }
+
+    // Tremor peak drift converted to Hz per second.
+    float drift_hz_per_s() const {
+        return tremor.drift_bins() * D::hz_per_bin / D::window_sec;
+    }
+};
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef STEP_DETECTOR_H
+#define STEP_DETECTOR_H
+
+#include <stdint.h>
+
+// ========= STEP DETECTOR =========
+// Time-domain steps on the accel magnitude stream, sample by sample:
+//
+//   1. 0.5-3 Hz band-pass (two biquads) isolates the gait bounce
+//   2. a step is a local maximum of that signal above an adaptive
+//      threshold (half the decaying peak envelope, never below
+//      STEP_MIN_G), at least STEP_REFRACTORY samples after the last one
+//   3. steps less than STEP_MAX_GAP apart form a bout; cadence is taken
+//      over the last STEP_HISTORY steps of the bout
+//
+// A second band-pass (3-8 Hz) tracks trembling energy. When a bout of
+// at least STEP_MIN_BOUT steps stops (no step for 1.5 stride intervals)
+// while that energy stays up, step_freeze_hint() is set: the "steps
+// stopped while intent persists" signal of a freeze, available within a
+// second instead of at the next analysis window. It lapses
+// STEP_HINT_STRIDES stride intervals after the last step (~10-13 s at a
+// normal cadence): by then 3-8 Hz energy is more likely resting tremor,
+// which would otherwise hold the hint up until the next step.
+//
+// Timestamps are sample indices since step_init(). Cost per sample is a
+// few biquad MACs and compares; no allocation.
+
+#define STEP_RATE        52          // Hz, as the detector
+#define STEP_BLOCK       16          // most samples per step_push()
+#define STEP_HISTORY     8           // step times kept for cadence
+#define STEP_REFRACTORY  (STEP_RATE * 3 / 10)   // 0.3 s
+#define STEP_MAX_GAP     (STEP_RATE * 2)        // 2 s ends a bout
+#define STEP_MIN_BOUT    4
+#define STEP_MIN_G       0.02f       // lowest step threshold, g
+#define STEP_INTENT_G    0.03f       // 3-8 Hz rms counted as intent, g
+#define STEP_HINT_STRIDES 20         // stride intervals a stop can be a freeze
+
+struct step_status {
+    uint32_t steps;             // since step_init()
+    uint32_t last_step;         // sample index of the newest step
+    uint32_t bout;              // steps in the current bout
+    float    cadence;           // steps / min over the bout, 0 if none
+    float    intent_g;          // 3-8 Hz rms, g
+    bool     stopped;           // bout ended without a step, until it lapses
+    bool     freeze_hint;       // stopped while intent_g stays up
+};
+
+void step_init();
+
+// Feeds n <= STEP_BLOCK accel magnitudes (g) in time order. Returns how
+// many steps were found; their times can be read with step_take(). If
+// band is given, the 0.5-3 Hz signal of these samples is written to it.
+int step_push(const float *accel, int n, float *band = 0);
+
+// Pops up to max step times (oldest first) not yet taken.
+int step_take(uint32_t *t, int max);
+
+uint32_t step_now();            // index of the next sample
+bool step_freeze_hint();
+void step_get_status(step_status &s);
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef SYMPTOM_SUMMARY_H
+#define SYMPTOM_SUMMARY_H
+
+#include <stdint.h>
+
+#include "detector.h"
+
+// ========= HOURLY SYMPTOM SUMMARY =========
+// What is kept instead of every window: per hour of windows, a 32-byte
+// record with
+//
+//   on          windows each symptom was active (episode time, x 3 s)
+//   episodes    symptom onsets in the hour
+//   tremor_hist log histogram of the tremor / dysk band powers, edges
+//   dysk_hist   0.625 * 8^k (5 = the detector's presence threshold)
+//   freq_hist   tracked tremor frequency, log-spaced over the tremor
+//               band; only windows with a lock count
+//
+// Histograms hold each bucket's share of the hour's windows in 1/255
+// (rounded when the hour closes). An episode running over the hour
+// boundary counts its onset once and its windows in both hours.
+//
+// summary_window() is O(1) (a few compares and one frexpf / logf). Hours
+// close after SUMMARY_HOUR_WINDOWS windows and queue for export; the
+// queue holds a day, 768 bytes, and drops the oldest when full.
+
+#define SUMMARY_HOUR_WINDOWS 1200       // 3 s hops
+#define SUMMARY_HOURS        24         // records queued
+#define SUMMARY_POWER_BINS   6
+#define SUMMARY_FREQ_BINS    4
+
+struct summary_hour {
+    uint16_t hour;                      // since summary_init()
+    uint16_t windows;                   // < SUMMARY_HOUR_WINDOWS if flushed early
+    uint16_t on[SYM_COUNT];
+    uint8_t  episodes[SYM_COUNT];
+    uint8_t  tremor_hist[SUMMARY_POWER_BINS];
+    uint8_t  dysk_hist[SUMMARY_POWER_BINS];
+    uint8_t  freq_hist[SUMMARY_FREQ_BINS];
+};
+
+static_assert(sizeof(summary_hour) == 32, "summary record is the export format");
+
+struct symptom_summary {
+    // the open hour, exact counts
+    uint16_t hour, windows;
+    uint16_t on[SYM_COUNT];
+    uint16_t episodes[SYM_COUNT];
+    uint16_t tremor_n[SUMMARY_POWER_BINS];
+    uint16_t dysk_n[SUMMARY_POWER_BINS];
+    uint16_t freq_n[SUMMARY_FREQ_BINS];
+    uint32_t prev_active;
+
+    summary_hour queue[SUMMARY_HOURS];
+    int head, queued;
+    uint32_t dropped;                   // hours lost to a full queue
+};
+
+void summary_init(symptom_summary &s);
+
+// One window: its result, the symptoms shown after it (1 << SYM_*), and
+// the tracked tremor frequency (0 without a lock).
+void summary_window(symptom_summary &s, const detector_result &r, uint32_t active, float tremor_hz);
+
+// Closes the open hour early (shutdown, sync). No-op without windows.
+void summary_flush(symptom_summary &s);
+
+// Oldest closed hour, false if none.
+bool summary_take(symptom_summary &s, summary_hour &h);
+
+// Histogram buckets, exposed so host tools bin the same way.
+int summary_power_bin(float power);
+int summary_freq_bin(float hz);
+
+#endif
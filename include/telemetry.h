@@ -0,0 +1,110 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "detector.h"
+#include "imu.h"
+#include "symptom_summary.h"
+
+// ========= TELEMETRY FRAMES =========
+// Binary frames from a device to the host, over any byte stream (UART,
+// BLE, a gateway socket carrying many devices):
+//
+//   sync     0xA5 0x5A
+//   type     TM_*
+//   len      payload bytes, <= TM_MAX_PAYLOAD
+//   device   u32
+//   seq      u16, per device, +1 per frame (gaps = lost frames)
+//   payload
+//   crc      CRC-16/CCITT-FALSE over type .. payload
+//
+// Multi-byte fields are little-endian (the board and the hosts). The
+// decoder resynchronises on the next sync after a bad CRC, so a stream
+// joined mid-frame or with damaged bytes only loses the frames hit.
+
+#define TM_SYNC0        0xA5
+#define TM_SYNC1        0x5A
+#define TM_HEADER       10          // sync .. seq
+#define TM_TRAILER      2
+#define TM_MAX_PAYLOAD  255
+#define TM_MAX_FRAME    (TM_HEADER + TM_MAX_PAYLOAD + TM_TRAILER)
+
+enum {
+    TM_WINDOW = 1,                  // tm_window: one analysis hop
+    TM_RAW,                         // tm_raw: raw samples, for re-analysis
+    TM_HOUR,                        // summary_hour
+    TM_EPISODE,                     // tm_episode: symptoms turning on / off
+    TM_LOG,                         // tm_log: an instrumentation record
+};
+
+#define TM_FLAG_TREMOR_PRESENT  (1u << 0)
+#define TM_FLAG_FREEZING        (1u << 1)
+#define TM_FLAG_IS_TREMOR       (1u << 2)
+#define TM_FLAG_IS_DYSK         (1u << 3)
+
+struct tm_window {
+    uint32_t hop;                   // analysis windows since boot
+    float    tremor, dysk, walk, fog, fog_ratio;
+    uint32_t active;                // symptoms shown, 1 << SYM_*
+    int16_t  score[SYM_COUNT];
+    uint32_t flags;                 // TM_FLAG_*
+};
+
+// Samples sample .. sample + n - 1 (n from the frame length).
+#define TM_RAW_MAX  ((TM_MAX_PAYLOAD - 4) / (IMU_AXES * 2))
+
+struct tm_raw {
+    uint32_t sample;                // since boot
+    int16_t  raw[TM_RAW_MAX][IMU_AXES];
+};
+
+struct tm_episode {
+    uint32_t hop;
+    uint32_t onset;                 // 1 << SYM_*, turned on at this hop
+    uint32_t end;                   // turned off
+    uint32_t shown;                 // after this hop
+};
+
+// A deflog record (format id and arguments), n arguments from the frame
+// length.
+#define TM_LOG_MAX_ARGS 7
+
+struct tm_log {
+    uint32_t fmt;
+    uint32_t args[TM_LOG_MAX_ARGS];
+};
+
+struct tm_frame {
+    uint8_t  type;
+    uint8_t  len;
+    uint32_t device;
+    uint16_t seq;
+    const uint8_t *payload;         // into the decoded buffer
+};
+
+tm_window tm_window_from(uint32_t hop, const detector_result &r, uint32_t active);
+void tm_window_result(const tm_window &w, detector_result &r);
+
+// Writes one frame into out (TM_MAX_FRAME bytes is always enough) and
+// returns its length, 0 if len is too long.
+size_t tm_encode(uint8_t *out, uint8_t type, uint32_t device, uint16_t seq,
+                 const void *payload, size_t len);
+
+struct tm_decode_stats {
+    uint64_t frames;
+    uint64_t crc_errors;
+    uint64_t skipped;               // bytes dropped while looking for sync
+};
+
+typedef void (*tm_frame_fn)(void *ctx, const tm_frame &f);
+
+// Calls fn for every whole frame in p[0 .. n) and returns the bytes
+// consumed. The rest (< TM_MAX_FRAME bytes, a frame cut by the read) must
+// be passed again at the front of the next call.
+size_t tm_decode(const uint8_t *p, size_t n, tm_frame_fn fn, void *ctx, tm_decode_stats &st);
+
+uint16_t tm_crc16(const uint8_t *p, size_t n);
+
+#endif
@@ -0,0 +1,201 @@
+#ifndef TREMOR_TRACKER_H
+#define TREMOR_TRACKER_H
+
+#include <math.h>
+#include <stdint.h>
+
+#include "detector.h"
+
+// ========= TREMOR PEAK TRACKER =========
+// Follows the dominant tremor frequency and its amplitude from hop to
+// hop with a small Kalman filter: frequency with a per-hop drift
+// (constant velocity), amplitude as a random walk.
+//
+// It transforms nothing itself: it is a sink for Detector::analyze (on
+// the board through board_sink) and reads the tremor band of the gyro
+// magnitude spectrum the detector has just computed.
+//
+// While locked only the bins within ~2 sigma of the predicted frequency
+// are searched (3-7 bins, widened by up to max_grow to enclose a
+// maximum on its edge), so a stronger peak elsewhere in the band cannot
+// pull the track away. A peak that is weaker than drop_ratio of the
+// tracked amplitude or hold_ratio of the band mean seen at lock, still
+// on the edge or outside the gate counts as a miss. The gate is for
+// robustness, not speed: the detector has already made every bin. After max_misses
+// misses, or before the first lock, the whole tremor band of D is
+// searched instead, and a lock needs a peak peak_ratio above the band
+// mean.
+template <class D>
+class TremorTracker {
+public:
+    typedef typename D::tremor_bins tb;
+    typedef typename D::sample_t sample_t;
+    static constexpr int band_bins = tb::last - tb::first + 1;
+
+    static constexpr float min_peak   = 2.0f;   // |X_k| to accept a peak
+    static constexpr float peak_ratio = 3.0f;   // to the band mean, to lock
+    static constexpr float hold_ratio = 2.0f;   // to that mean, to keep it
+    static constexpr float drop_ratio = 0.3f;   // to amplitude(), to keep it
+    static constexpr int   max_misses = 2;
+    static constexpr int   max_half   = 3;      // widest neighbourhood, bins
+    static constexpr int   max_grow   = 2;      // extra bins to enclose a peak
+
+    struct stats {
+        uint32_t hops;
+        uint32_t locked_hops;
+        uint32_t acquired;
+        uint32_t lost;
+    };
+
+    void init() {
+        lock = false;
+        misses = 0;
+        f = df = amp = 0;
+        p_ff = p_fd = p_dd = p_a = 0;
+        floor_mag = 0;
+        st = stats();
+    }
+
+    void accel_spectrum(const sample_t *, float) {}
+
+    // One hop: the gyro magnitude spectrum (D::bins values, times gain).
+    void gyro_spectrum(const sample_t *spec, float gain) {
+        for (int j=0; j < band_bins; j++) mag[j] = (float)spec[tb::first + j] * gain;
+
+        st.hops++;
+        if (lock) track();
+        if (!lock) acquire();
+        if (lock) st.locked_hops++;
+    }
+
+    bool  locked() const        { return lock; }
+    float frequency() const     { return f; }                   // Hz
+    float amplitude() const     { return amp; }                 // |X_k|
+    float drift_hz_per_s() const { return df / D::window_sec; }
+    float sigma_hz() const      { return sqrtf(p_ff); }
+    const stats &get_stats() const { return st; }
+
+private:
+    // process / measurement noise, Hz^2 per hop and relative amplitude
+    static constexpr float q_f  = 0.0004f;
+    static constexpr float q_df = 0.0004f;
+    static constexpr float r_f  = 0.0025f;
+    static constexpr float q_a  = 0.04f;
+    static constexpr float r_a  = 0.09f;
+
+    float mag[band_bins];       // this hop's tremor band
+
+    bool  lock;
+    int   misses;
+
+    float f, df;                // state: frequency, drift per hop
+    float p_ff, p_fd, p_dd;     // its covariance
+    float amp, p_a;
+    float floor_mag;            // band mean |X_k| when the lock was taken
+
+    stats st;
+
+    // Sub-bin peak position by a parabola through j-1, j, j+1.
+    float peak_hz(int j) const {
+        float delta = 0;
+        if (j > 0 && j < band_bins - 1) {
+            float a = mag[j-1], b = mag[j], c = mag[j+1];
+            float den = a - 2.0f * b + c;
+            if (den < 0.0f) delta = 0.5f * (a - c) / den;
+        }
+        return (tb::first + j + delta) * D::hz_per_bin;
+    }
+
+    void acquire() {
+        int best = 0;
+        float sum = mag[0];
+        for (int j=1; j < band_bins; j++) {
+            sum += mag[j];
+            if (mag[j] > mag[best]) best = j;
+        }
+        float mean_mag = sum / band_bins;
+        if (mag[best] < min_peak || mag[best] < peak_ratio * mean_mag) return;
+
+        f = peak_hz(best);
+        df = 0;
+        p_ff = r_f;  p_fd = 0;  p_dd = q_df * 4.0f;
+        amp = mag[best];
+        p_a = r_a * amp * amp;
+        floor_mag = mean_mag;
+        lock = true;
+        misses = 0;
+        st.acquired++;
+    }
+
+    void track() {
+        // predict
+        f += df;
+        p_ff += 2.0f * p_fd + p_dd + q_f;
+        p_fd += p_dd;
+        p_dd += q_df;
+        p_a  += q_a * amp * amp;
+
+        int center = (int)lrintf(f / D::hz_per_bin) - tb::first;
+        int half = (int)ceilf(2.0f * sqrtf(p_ff) / D::hz_per_bin);
+        if (half < 1) half = 1;
+        if (half > max_half) half = max_half;
+
+        int lo = center - half, hi = center + half;
+        if (lo < 0) lo = 0;
+        if (hi > band_bins - 1) hi = band_bins - 1;
+
+        bool hit = false;
+        if (lo <= hi) {
+            int best = lo;
+            for (int j=lo + 1; j <= hi; j++) if (mag[j] > mag[best]) best = j;
+
+            // a maximum on the edge of the neighbourhood: widen towards it
+            // until it is enclosed, at most max_grow bins
+            for (int g=0; g < max_grow; g++) {
+                if (best == lo && lo > 0) {
+                    if (mag[--lo] > mag[best]) best = lo;
+                } else if (best == hi && hi < band_bins - 1) {
+                    if (mag[++hi] > mag[best]) best = hi;
+                } else {
+                    break;
+                }
+            }
+            bool inner = (best > lo || lo == 0) && (best < hi || hi == band_bins - 1);
+            bool strong = mag[best] >= min_peak && mag[best] >= drop_ratio * amp
+                       && mag[best] >= hold_ratio * floor_mag;
+            if (inner && strong) {
+                if (best > lo && best < hi) hit = correct(peak_hz(best), mag[best]);
+                else hit = correct((tb::first + best) * D::hz_per_bin, mag[best]);
+            }
+        }
+
+        if (hit) {
+            misses = 0;
+        } else if (++misses >= max_misses) {
+            lock = false;
+            st.lost++;
+        }
+    }
+
+    bool correct(float z, float za) {
+        float s = p_ff + r_f;
+        float innov = z - f;
+        if (innov * innov > 9.0f * s) return false;     // outside 3 sigma
+
+        float k_f = p_ff / s, k_d = p_fd / s;
+        f  += k_f * innov;
+        df += k_d * innov;
+        float ff = p_ff, fd = p_fd;
+        p_ff -= k_f * ff;
+        p_fd -= k_f * fd;
+        p_dd -= k_d * fd;
+
+        float ra = r_a * za * za;
+        float k_a = p_a / (p_a + ra);
+        amp += k_a * (za - amp);
+        p_a -= k_a * p_a;
+        return true;
+    }
+};
+
+#endif
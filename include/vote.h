@@ -0,0 +1,105 @@
+#ifndef VOTE_H
+#define VOTE_H
+
+#include <stdint.h>
+
+#include "detector.h"
+
+// d^n in q15 (1.0 = 32768), rounded at every step
+constexpr int32_t vote_decay_pow(int32_t decay_q15, int n) {
+    int32_t p = 32768;
+    for (int i=0; i < n; i++) p = (p * decay_q15 + (1 << 14)) >> 15;
+    return p;
+}
+
+constexpr int32_t vote_weight_sum(int32_t decay_q15, int n) {
+    int32_t sum = 0;
+    for (int j=0; j < n; j++) sum += vote_decay_pow(decay_q15, j);
+    return sum;
+}
+
+// ========= MULTI-WINDOW VOTE =========
+// Fuses the per-window scores of detector_result over the last K hops.
+// For each symptom the vote is
+//
+//     V = sum_{j<K} d^j * score[t-j]
+//
+// kept with one multiply-add per hop (V = d*V + s_t - d^K * s_{t-K}),
+// and the confidence is V divided by sum_{j<K} d^j, in q15. A symptom
+// turns on above OnQ15 and off at or below OffQ15.
+//
+// Integer arithmetic only, so the host (tools/replay) reproduces the
+// board's confidences exactly from the logged scores.
+template <int Symbols, int K, int DecayQ15, int OnQ15, int OffQ15>
+class Vote {
+public:
+    static constexpr int symbols = Symbols;
+    static constexpr int depth   = K;
+
+    static_assert(K > 0 && DecayQ15 > 0 && DecayQ15 < 32768, "bad vote decay");
+    static_assert(OffQ15 < OnQ15, "vote needs hysteresis");
+
+    Vote() { reset(); }
+
+    void reset() {
+        head = 0;
+        for (int s=0; s < Symbols; s++) {
+            acc[s] = 0;
+            conf[s] = 0;
+            on[s] = false;
+            for (int j=0; j < K; j++) ring[j][s] = 0;
+        }
+    }
+
+    void push(const int16_t *score) {
+        for (int s=0; s < Symbols; s++) {
+            int32_t oldest = ring[head][s];
+            ring[head][s] = score[s];
+
+            // acc holds V with 8 extra fraction bits
+            int32_t decayed = (int32_t)(((int64_t)acc[s] * DecayQ15 + (1 << 14)) >> 15);
+            int32_t expired = (oldest * decay_k + (1 << 6)) >> 7;
+            acc[s] = decayed + ((int32_t)score[s] << 8) - expired;
+
+            int32_t c = (int32_t)(((int64_t)acc[s] << 7) / weight_sum);
+            if (c >  32767) c =  32767;
+            if (c < -32768) c = -32768;
+            conf[s] = (int16_t)c;
+
+            if (c > OnQ15)        on[s] = true;
+            else if (c <= OffQ15) on[s] = false;
+        }
+        if (++head == K) head = 0;
+    }
+
+    int16_t confidence(int s) const { return conf[s]; }
+    bool    active(int s) const     { return on[s]; }
+
+    // bit s set when symptom s is active
+    uint32_t active_mask() const {
+        uint32_t m = 0;
+        for (int s=0; s < Symbols; s++) if (on[s]) m |= 1u << s;
+        return m;
+    }
+
+private:
+    static constexpr int32_t decay_k    = vote_decay_pow(DecayQ15, K);
+    static constexpr int32_t weight_sum = vote_weight_sum(DecayQ15, K);
+
+    int16_t ring[K][Symbols];
+    int32_t acc[Symbols];
+    int16_t conf[Symbols];
+    bool    on[Symbols];
+    int     head;
+};
+
+// 4 hops (12 s), each hop weighted 0.75 of the next newer one. A single
+// window against three that disagree cannot flip a symptom; two strong
+// ones in a row can. On above 0.25, off at or below 0.
+typedef Vote<SYM_COUNT, 4, 24576, 8192, 0> board_vote;
+
+// For the dual front end's 1.23 s hops (dual_front_end.h): 10 hops, the
+// same 12 s span, 0.75 per 3 s expressed per hop.
+typedef Vote<SYM_COUNT, 10, 29120, 8192, 0> dual_vote;
+
+#endif
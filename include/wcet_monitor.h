@@ -0,0 +1,53 @@
+#ifndef WCET_MONITOR_H
+#define WCET_MONITOR_H
+
+#include <stdint.h>
+#include "cycle_clock.h"
+
+// ========= WCET MONITOR =========
+// Wraps a stage of the main loop (acquisition tick, analysis hop) and
+// tracks its execution time against a deadline in cycle_clock cycles.
+
+struct wcet_stage {
+    const char *name;
+    uint32_t budget;    // cycles until the next tick is due
+    uint32_t start;
+    uint32_t last;
+    uint32_t worst;
+    uint32_t runs;
+    uint32_t misses;    // runs that were still busy when the next tick was due
+    uint32_t dropped;   // ticks that were never serviced
+    uint64_t total;
+};
+
+void wcet_stage_init(wcet_stage &s, const char *name, uint32_t budget);
+void wcet_begin(wcet_stage &s);
+
+// Returns true when this run set a new worst case, so the caller can
+// snapshot whatever input caused it.
+bool wcet_end(wcet_stage &s);
+
+// Records ticks that fired while the loop was busy elsewhere.
+void wcet_note_dropped(wcet_stage &s, uint32_t ticks);
+
+// ========= WORST-CASE WINDOW =========
+// The analysis window that produced the worst analysis time. Dumped
+// over serial as raw float bits so tools/replay can rerun it exactly.
+struct wcet_capture {
+    uint32_t cycles;
+    uint32_t length;
+    float   *accel;
+    float   *gyro;
+};
+
+template <class T>
+void wcet_capture_store(wcet_capture &c, uint32_t cycles,
+                        const T *accel, const T *gyro) {
+    c.cycles = cycles;
+    for (uint32_t i=0; i < c.length; i++) {
+        c.accel[i] = (float)accel[i];
+        c.gyro[i]  = (float)gyro[i];
+    }
+}
+
+#endif
@@ -78,6 +78,24 @@ extern "C"
    extern const arm_cfft_instance_q15 arm_cfft_sR_q15_len2048;
    extern const arm_cfft_instance_q15 arm_cfft_sR_q15_len4096;
 
+   extern const arm_rfft_fast_instance_f64 arm_rfft_fast_sR_f64_len32;
+   extern const arm_rfft_fast_instance_f64 arm_rfft_fast_sR_f64_len64;
+   extern const arm_rfft_fast_instance_f64 arm_rfft_fast_sR_f64_len128;
+   extern const arm_rfft_fast_instance_f64 arm_rfft_fast_sR_f64_len256;
+   extern const arm_rfft_fast_instance_f64 arm_rfft_fast_sR_f64_len512;
+   extern const arm_rfft_fast_instance_f64 arm_rfft_fast_sR_f64_len1024;
+   extern const arm_rfft_fast_instance_f64 arm_rfft_fast_sR_f64_len2048;
+   extern const arm_rfft_fast_instance_f64 arm_rfft_fast_sR_f64_len4096;
+
+   extern const arm_rfft_fast_instance_f32 arm_rfft_fast_sR_f32_len32;
+   extern const arm_rfft_fast_instance_f32 arm_rfft_fast_sR_f32_len64;
+   extern const arm_rfft_fast_instance_f32 arm_rfft_fast_sR_f32_len128;
+   extern const arm_rfft_fast_instance_f32 arm_rfft_fast_sR_f32_len256;
+   extern const arm_rfft_fast_instance_f32 arm_rfft_fast_sR_f32_len512;
+   extern const arm_rfft_fast_instance_f32 arm_rfft_fast_sR_f32_len1024;
+   extern const arm_rfft_fast_instance_f32 arm_rfft_fast_sR_f32_len2048;
+   extern const arm_rfft_fast_instance_f32 arm_rfft_fast_sR_f32_len4096;
+
 #ifdef   __cplusplus
 }
 #endif
@@ -50,6 +50,15 @@ extern "C"
    extern const arm_cfft_instance_f16 arm_cfft_sR_f16_len1024;
    extern const arm_cfft_instance_f16 arm_cfft_sR_f16_len2048;
    extern const arm_cfft_instance_f16 arm_cfft_sR_f16_len4096;
+
+   extern const arm_rfft_fast_instance_f16 arm_rfft_fast_sR_f16_len32;
+   extern const arm_rfft_fast_instance_f16 arm_rfft_fast_sR_f16_len64;
+   extern const arm_rfft_fast_instance_f16 arm_rfft_fast_sR_f16_len128;
+   extern const arm_rfft_fast_instance_f16 arm_rfft_fast_sR_f16_len256;
+   extern const arm_rfft_fast_instance_f16 arm_rfft_fast_sR_f16_len512;
+   extern const arm_rfft_fast_instance_f16 arm_rfft_fast_sR_f16_len1024;
+   extern const arm_rfft_fast_instance_f16 arm_rfft_fast_sR_f16_len2048;
+   extern const arm_rfft_fast_instance_f16 arm_rfft_fast_sR_f16_len4096;
 #endif
 
 #ifdef   __cplusplus
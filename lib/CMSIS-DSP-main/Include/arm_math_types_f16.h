@@ -57,6 +57,10 @@ won't be built.
     #if defined(__ARM_FP16_FORMAT_IEEE) || defined(__ARM_FP16_FORMAT_ALTERNATIVE)
       typedef __fp16 float16_t;
       #define ARM_FLOAT16_SUPPORTED
+    #elif defined(__GNUC_PYTHON__) && defined(__FLT16_MANT_DIG__)
+      /* Host builds without CMSIS Core: use the compiler's _Float16 */
+      typedef _Float16 float16_t;
+      #define ARM_FLOAT16_SUPPORTED
     #endif
   #endif
 #endif
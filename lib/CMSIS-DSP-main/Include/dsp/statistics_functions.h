@@ -980,6 +980,52 @@ const float64_t * pSrc,
       uint32_t blockSize,
       float64_t * pResult);
 
+/**
+ * @brief  Bin range [start, end) of a band, for the band sum functions.
+ */
+typedef struct
+{
+  uint16_t start;          /**< first bin of the band. */
+  uint16_t end;            /**< one past the last bin. */
+} arm_band_range;
+
+/**
+ * @brief  Sums of a floating-point vector over bin ranges.
+ * @param[in]  pSrc       is input pointer
+ * @param[in]  pBands     points to numBands [start, end) ranges
+ * @param[in]  numBands   is the number of ranges
+ * @param[out] pDst       is output pointer, one sum per range
+ */
+void arm_band_sum_f32(
+const float32_t * pSrc,
+const arm_band_range * pBands,
+      uint32_t numBands,
+      float32_t * pDst);
+
+/**
+ * @brief  Prefix sums of a floating-point vector for band queries.
+ * @param[in]  pSrc       is input pointer
+ * @param[in]  blockSize  is the number of samples to process
+ * @param[out] pDst       is output pointer, blockSize + 1 values starting with 0
+ */
+void arm_band_prefix_f32(
+const float32_t * pSrc,
+      uint32_t blockSize,
+      float32_t * pDst);
+
+/**
+ * @brief  Sums over bin ranges from prefix sums, O(1) per range.
+ * @param[in]  pPrefix    points to the output of arm_band_prefix_f32
+ * @param[in]  pBands     points to numBands [start, end) ranges
+ * @param[in]  numBands   is the number of ranges
+ * @param[out] pDst       is output pointer, one sum per range
+ */
+void arm_band_sum_prefix_f32(
+const float32_t * pPrefix,
+const arm_band_range * pBands,
+      uint32_t numBands,
+      float32_t * pDst);
+
 
 #ifdef   __cplusplus
 }
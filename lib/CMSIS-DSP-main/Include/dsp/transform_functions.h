@@ -618,6 +618,15 @@ arm_status arm_rfft_init_8192_q15(
   const arm_rfft_instance_q15 * S,
         q15_t * pSrc,
         q15_t * pDst);
+
+  /**
+   * @brief In-place Q15 RFFT/RIFFT, packed half spectrum (see arm_rfft_inplace_q15.c).
+   * @param[in]     S  points to an instance of the Q15 RFFT/RIFFT structure
+   * @param[in,out] p  points to the N samples, overwritten by the result
+   */
+  void arm_rfft_inplace_q15(
+  const arm_rfft_instance_q15 * S,
+        q15_t * p);
 #endif 
 
   /**
@@ -747,6 +756,15 @@ extern arm_rfft_instance_q31 *arm_rfft_init_dynamic_q31(uint32_t fftLenReal);
   const arm_rfft_instance_q31 * S,
         q31_t * pSrc,
         q31_t * pDst);
+
+  /**
+   * @brief In-place Q31 RFFT/RIFFT, packed half spectrum (see arm_rfft_inplace_q31.c).
+   * @param[in]     S  points to an instance of the Q31 RFFT/RIFFT structure
+   * @param[in,out] p  points to the N samples, overwritten by the result
+   */
+  void arm_rfft_inplace_q31(
+  const arm_rfft_instance_q31 * S,
+        q31_t * p);
 #endif
 
   /**
@@ -847,6 +865,17 @@ void arm_rfft_fast_f32(
         const arm_rfft_fast_instance_f32 * S,
         float32_t * p, float32_t * pOut,
         uint8_t ifftFlag);
+
+  /**
+   * @brief In-place floating-point RFFT/RIFFT, same format as arm_rfft_fast_f32.
+   * @param[in]     S         points to an arm_rfft_fast_instance_f32 structure
+   * @param[in,out] p         points to the N samples, overwritten by the result
+   * @param[in]     ifftFlag  0: RFFT, 1: RIFFT
+   */
+  void arm_rfft_fast_inplace_f32(
+        const arm_rfft_fast_instance_f32 * S,
+        float32_t * p,
+        uint8_t ifftFlag);
 #endif
 
 
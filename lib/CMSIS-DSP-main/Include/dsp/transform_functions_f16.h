@@ -199,6 +199,17 @@ void arm_rfft_fast_f16(
         const arm_rfft_fast_instance_f16 * S,
         float16_t * p, float16_t * pOut,
         uint8_t ifftFlag);
+
+  /**
+   * @brief In-place floating-point RFFT/RIFFT (f16), same format as arm_rfft_fast_f16.
+   * @param[in]     S         points to an arm_rfft_fast_instance_f16 structure
+   * @param[in,out] p         points to the N samples, overwritten by the result
+   * @param[in]     ifftFlag  0: RFFT, 1: RIFFT
+   */
+  void arm_rfft_fast_inplace_f16(
+        const arm_rfft_fast_instance_f16 * S,
+        float16_t * p,
+        uint8_t ifftFlag);
 #endif 
 
 /* Deprecated */
@@ -36,6 +36,10 @@
 #include "arm_cmplx_mag_f64.c"
 #include "arm_cmplx_mag_q15.c"
 #include "arm_cmplx_mag_fast_q15.c"
+#include "arm_cmplx_mag_approx_f32.c"
+#include "arm_cmplx_mag_approx_refined_f32.c"
+#include "arm_cmplx_mag_approx_q15.c"
+#include "arm_cmplx_mag_approx_refined_q15.c"
 #include "arm_cmplx_mag_q31.c"
 #include "arm_cmplx_mag_squared_f32.c"
 #include "arm_cmplx_mag_squared_f64.c"
@@ -19,6 +19,11 @@ target_sources(CMSISDSP PRIVATE ComplexMathFunctions/arm_cmplx_mag_q15.c)
 
 target_sources(CMSISDSP PRIVATE ComplexMathFunctions/arm_cmplx_mag_fast_q15.c)
 
+target_sources(CMSISDSP PRIVATE ComplexMathFunctions/arm_cmplx_mag_approx_f32.c)
+target_sources(CMSISDSP PRIVATE ComplexMathFunctions/arm_cmplx_mag_approx_refined_f32.c)
+target_sources(CMSISDSP PRIVATE ComplexMathFunctions/arm_cmplx_mag_approx_q15.c)
+target_sources(CMSISDSP PRIVATE ComplexMathFunctions/arm_cmplx_mag_approx_refined_q15.c)
+
 target_sources(CMSISDSP PRIVATE ComplexMathFunctions/arm_cmplx_conj_f32.c)
 target_sources(CMSISDSP PRIVATE ComplexMathFunctions/arm_cmplx_conj_q15.c)
 target_sources(CMSISDSP PRIVATE ComplexMathFunctions/arm_cmplx_conj_q31.c)
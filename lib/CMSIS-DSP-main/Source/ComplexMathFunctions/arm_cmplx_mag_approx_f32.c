@@ -0,0 +1,216 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_cmplx_mag_approx_f32.c
+ * Description:  Floating-point approximate complex magnitude
+ *
+ * $Date:        17 October 2026
+ * $Revision:    V1.10.0
+ *
+ * Target Processor: Cortex-M and Cortex-A cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2021 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dsp/complex_math_functions.h"
+
+/**
+  @ingroup groupCmplxMath
+ */
+
+/**
+  @defgroup cmplx_mag_approx Approximate Complex Magnitude
+
+  Computes an approximation of the magnitude of the elements of a complex
+  data vector without a square root, for uses that only compare
+  magnitudes or their sums against thresholds.
+
+  The data layout is the one of \ref cmplx_mag. With
+  <code>hi = max(|re|, |im|)</code> and <code>lo = min(|re|, |im|)</code>,
+  the alpha-max-plus-beta-min estimate is
+
+  <pre>
+      pDst[n] = alpha * hi + beta * lo
+  </pre>
+
+  with alpha = 0.96043387 and beta = 0.39782473, the minimax choice for a
+  single line. The relative error is within +/-3.96 % for any input.
+
+  The refined variant takes the larger of two such lines,
+
+  <pre>
+      pDst[n] = max(0.99029947 * hi + 0.19698154 * lo,
+                    0.83953526 * hi + 0.56095972 * lo)
+  </pre>
+
+  which brings the relative error within +/-0.971 % for one more
+  multiply-accumulate and a compare. A Newton step on the one-line
+  estimate would need a divide, which costs as much as the square root
+  it replaces on cores with a floating-point unit.
+
+  Both estimates are exact (0) for a zero input. The error is a smooth
+  function of the phase only, so sums over many bins with spread phases
+  land much closer than the bound.
+
+  There are separate functions for floating-point and Q15 data types.
+ */
+
+/**
+  @addtogroup cmplx_mag_approx
+  @{
+ */
+
+/**
+  @brief         Floating-point approximate complex magnitude (alpha max plus beta min).
+  @param[in]     pSrc        points to input vector
+  @param[out]    pDst        points to output vector
+  @param[in]     numSamples  number of samples in each vector
+
+  @par           Accuracy
+                   Relative error within +/-3.96 %.
+ */
+
+#define CMPLX_MAG_ALPHA_F32 0.960433870f
+#define CMPLX_MAG_BETA_F32  0.397824735f
+
+#if defined(ARM_MATH_MVEF) && !defined(ARM_MATH_AUTOVECTORIZE)
+
+#include "arm_helium_utils.h"
+
+ARM_DSP_ATTRIBUTE void arm_cmplx_mag_approx_f32(
+  const float32_t * pSrc,
+        float32_t * pDst,
+        uint32_t numSamples)
+{
+    uint32_t  blkCnt;           /* loop counters */
+    f32x4x2_t vecSrc;
+    f32x4_t vecRe, vecIm, vecHi, vecLo;
+    float32_t real, imag, hi, lo;
+
+    /* Compute 4 complex samples at a time */
+    blkCnt = numSamples >> 2;
+    while (blkCnt > 0U)
+    {
+        vecSrc = vld2q(pSrc);
+        pSrc += 8;
+        vecRe = vabsq(vecSrc.val[0]);
+        vecIm = vabsq(vecSrc.val[1]);
+        vecHi = vmaxnmq(vecRe, vecIm);
+        vecLo = vminnmq(vecRe, vecIm);
+
+        vecHi = vmulq(vecHi, CMPLX_MAG_ALPHA_F32);
+        vecHi = vfmaq(vecHi, vecLo, CMPLX_MAG_BETA_F32);
+
+        vst1q(pDst, vecHi);
+        pDst += 4;
+
+        blkCnt--;
+    }
+
+    /* tail */
+    blkCnt = numSamples & 3;
+    while (blkCnt > 0U)
+    {
+        real = fabsf(*pSrc++);
+        imag = fabsf(*pSrc++);
+        hi = real > imag ? real : imag;
+        lo = real > imag ? imag : real;
+
+        *pDst++ = CMPLX_MAG_ALPHA_F32 * hi + CMPLX_MAG_BETA_F32 * lo;
+
+        blkCnt--;
+    }
+}
+
+#else
+ARM_DSP_ATTRIBUTE void arm_cmplx_mag_approx_f32(
+  const float32_t * pSrc,
+        float32_t * pDst,
+        uint32_t numSamples)
+{
+  uint32_t blkCnt;                               /* loop counter */
+  float32_t real, imag, hi, lo;                  /* Temporary variables to hold input values */
+
+#if defined (ARM_MATH_LOOPUNROLL)
+
+  /* Loop unrolling: Compute 4 outputs at a time */
+  blkCnt = numSamples >> 2U;
+
+  while (blkCnt > 0U)
+  {
+    /* C[0] = alpha * max(|A[0]|, |A[1]|) + beta * min(|A[0]|, |A[1]|) */
+
+    real = fabsf(*pSrc++);
+    imag = fabsf(*pSrc++);
+    hi = real > imag ? real : imag;
+    lo = real > imag ? imag : real;
+    *pDst++ = CMPLX_MAG_ALPHA_F32 * hi + CMPLX_MAG_BETA_F32 * lo;
+
+    real = fabsf(*pSrc++);
+    imag = fabsf(*pSrc++);
+    hi = real > imag ? real : imag;
+    lo = real > imag ? imag : real;
+    *pDst++ = CMPLX_MAG_ALPHA_F32 * hi + CMPLX_MAG_BETA_F32 * lo;
+
+    real = fabsf(*pSrc++);
+    imag = fabsf(*pSrc++);
+    hi = real > imag ? real : imag;
+    lo = real > imag ? imag : real;
+    *pDst++ = CMPLX_MAG_ALPHA_F32 * hi + CMPLX_MAG_BETA_F32 * lo;
+
+    real = fabsf(*pSrc++);
+    imag = fabsf(*pSrc++);
+    hi = real > imag ? real : imag;
+    lo = real > imag ? imag : real;
+    *pDst++ = CMPLX_MAG_ALPHA_F32 * hi + CMPLX_MAG_BETA_F32 * lo;
+
+    /* Decrement loop counter */
+    blkCnt--;
+  }
+
+  /* Loop unrolling: Compute remaining outputs */
+  blkCnt = numSamples % 0x4U;
+
+#else
+
+  /* Initialize blkCnt with number of samples */
+  blkCnt = numSamples;
+
+#endif /* #if defined (ARM_MATH_LOOPUNROLL) */
+
+  while (blkCnt > 0U)
+  {
+    /* C[0] = alpha * max(|A[0]|, |A[1]|) + beta * min(|A[0]|, |A[1]|) */
+
+    real = fabsf(*pSrc++);
+    imag = fabsf(*pSrc++);
+    hi = real > imag ? real : imag;
+    lo = real > imag ? imag : real;
+
+    /* store result in destination buffer. */
+    *pDst++ = CMPLX_MAG_ALPHA_F32 * hi + CMPLX_MAG_BETA_F32 * lo;
+
+    /* Decrement loop counter */
+    blkCnt--;
+  }
+
+}
+#endif /* defined(ARM_MATH_MVEF) && !defined(ARM_MATH_AUTOVECTORIZE) */
+
+/**
+  @} end of cmplx_mag_approx group
+ */
@@ -0,0 +1,197 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_cmplx_mag_approx_q15.c
+ * Description:  Q15 approximate complex magnitude
+ *
+ * $Date:        17 October 2026
+ * $Revision:    V1.10.0
+ *
+ * Target Processor: Cortex-M and Cortex-A cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2021 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dsp/complex_math_functions.h"
+
+/**
+  @ingroup groupCmplxMath
+ */
+
+/**
+  @addtogroup cmplx_mag_approx
+  @{
+ */
+
+/**
+  @brief         Q15 approximate complex magnitude (alpha max plus beta min).
+  @param[in]     pSrc        points to input vector
+  @param[out]    pDst        points to output vector
+  @param[in]     numSamples  number of samples in each vector
+
+  @par           Scaling and Overflow Behavior
+                   The input is in 1.15 format and the output in 2.14 format, as
+                   for \ref arm_cmplx_mag_q15, so the two can be swapped. The
+                   coefficients are rounded to 1.15 and products truncated, which
+                   adds at most 1 LSB of 2.14 to the error below. No intermediate
+                   can overflow, -1 included.
+
+  @par           Accuracy
+                   Relative error within +/-3.96 %, plus the rounding above.
+ */
+
+#define CMPLX_MAG_ALPHA_Q15 31471   /* 0.960433870 */
+#define CMPLX_MAG_BETA_Q15  13036   /* 0.397824735 */
+
+#if defined(ARM_MATH_MVEI) && !defined(ARM_MATH_AUTOVECTORIZE)
+
+#include "arm_helium_utils.h"
+
+ARM_DSP_ATTRIBUTE void arm_cmplx_mag_approx_q15(
+  const q15_t * pSrc,
+        q15_t * pDst,
+        uint32_t numSamples)
+{
+    uint32_t  blkCnt;           /* loop counters */
+    q15x8x2_t vecSrc;
+    q15x8_t vecRe, vecIm, vecHi, vecLo;
+    q31_t real, imag, hi, lo;
+
+    /* Compute 8 complex samples at a time */
+    blkCnt = numSamples >> 3;
+    while (blkCnt > 0U)
+    {
+        vecSrc = vld2q(pSrc);
+        pSrc += 16;
+        /* |-1| saturates to 1 - 2^-15, within the error bound */
+        vecRe = vqabsq(vecSrc.val[0]);
+        vecIm = vqabsq(vecSrc.val[1]);
+        vecHi = vmaxq(vecRe, vecIm);
+        vecLo = vminq(vecRe, vecIm);
+
+        /* 1.15 x 1.15, high half: 2.14 */
+        vecHi = vqaddq(vmulhq(vecHi, vdupq_n_s16(CMPLX_MAG_ALPHA_Q15)),
+                       vmulhq(vecLo, vdupq_n_s16(CMPLX_MAG_BETA_Q15)));
+
+        vst1q(pDst, vecHi);
+        pDst += 8;
+
+        blkCnt--;
+    }
+
+    /* tail */
+    blkCnt = numSamples & 7;
+    while (blkCnt > 0U)
+    {
+        real = *pSrc++;
+        imag = *pSrc++;
+        real = real < 0 ? -real : real;
+        imag = imag < 0 ? -imag : imag;
+        hi = real > imag ? real : imag;
+        lo = real > imag ? imag : real;
+        *pDst++ = (q15_t) ((CMPLX_MAG_ALPHA_Q15 * hi + CMPLX_MAG_BETA_Q15 * lo) >> 16);
+
+        blkCnt--;
+    }
+}
+
+#else
+ARM_DSP_ATTRIBUTE void arm_cmplx_mag_approx_q15(
+  const q15_t * pSrc,
+        q15_t * pDst,
+        uint32_t numSamples)
+{
+  uint32_t blkCnt;                               /* loop counter */
+  q31_t real, imag, hi, lo;                      /* Temporary variables */
+
+#if defined (ARM_MATH_LOOPUNROLL)
+
+  /* Loop unrolling: Compute 4 outputs at a time */
+  blkCnt = numSamples >> 2U;
+
+  while (blkCnt > 0U)
+  {
+    /* C[0] = alpha * max(|A[0]|, |A[1]|) + beta * min(|A[0]|, |A[1]|) */
+
+    real = *pSrc++;
+    imag = *pSrc++;
+    real = real < 0 ? -real : real;
+    imag = imag < 0 ? -imag : imag;
+    hi = real > imag ? real : imag;
+    lo = real > imag ? imag : real;
+    *pDst++ = (q15_t) ((CMPLX_MAG_ALPHA_Q15 * hi + CMPLX_MAG_BETA_Q15 * lo) >> 16);
+
+    real = *pSrc++;
+    imag = *pSrc++;
+    real = real < 0 ? -real : real;
+    imag = imag < 0 ? -imag : imag;
+    hi = real > imag ? real : imag;
+    lo = real > imag ? imag : real;
+    *pDst++ = (q15_t) ((CMPLX_MAG_ALPHA_Q15 * hi + CMPLX_MAG_BETA_Q15 * lo) >> 16);
+
+    real = *pSrc++;
+    imag = *pSrc++;
+    real = real < 0 ? -real : real;
+    imag = imag < 0 ? -imag : imag;
+    hi = real > imag ? real : imag;
+    lo = real > imag ? imag : real;
+    *pDst++ = (q15_t) ((CMPLX_MAG_ALPHA_Q15 * hi + CMPLX_MAG_BETA_Q15 * lo) >> 16);
+
+    real = *pSrc++;
+    imag = *pSrc++;
+    real = real < 0 ? -real : real;
+    imag = imag < 0 ? -imag : imag;
+    hi = real > imag ? real : imag;
+    lo = real > imag ? imag : real;
+    *pDst++ = (q15_t) ((CMPLX_MAG_ALPHA_Q15 * hi + CMPLX_MAG_BETA_Q15 * lo) >> 16);
+
+    /* Decrement loop counter */
+    blkCnt--;
+  }
+
+  /* Loop unrolling: Compute remaining outputs */
+  blkCnt = numSamples % 0x4U;
+
+#else
+
+  /* Initialize blkCnt with number of samples */
+  blkCnt = numSamples;
+
+#endif /* #if defined (ARM_MATH_LOOPUNROLL) */
+
+  while (blkCnt > 0U)
+  {
+    /* C[0] = alpha * max(|A[0]|, |A[1]|) + beta * min(|A[0]|, |A[1]|) */
+
+    real = *pSrc++;
+    imag = *pSrc++;
+    real = real < 0 ? -real : real;
+    imag = imag < 0 ? -imag : imag;
+    hi = real > imag ? real : imag;
+    lo = real > imag ? imag : real;
+    *pDst++ = (q15_t) ((CMPLX_MAG_ALPHA_Q15 * hi + CMPLX_MAG_BETA_Q15 * lo) >> 16);
+
+    /* Decrement loop counter */
+    blkCnt--;
+  }
+
+}
+#endif /* defined(ARM_MATH_MVEI) && !defined(ARM_MATH_AUTOVECTORIZE) */
+
+/**
+  @} end of cmplx_mag_approx group
+ */
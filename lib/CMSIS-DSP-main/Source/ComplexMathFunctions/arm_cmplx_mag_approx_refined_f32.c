@@ -0,0 +1,192 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_cmplx_mag_approx_refined_f32.c
+ * Description:  Floating-point refined approximate complex magnitude
+ *
+ * $Date:        17 October 2026
+ * $Revision:    V1.10.0
+ *
+ * Target Processor: Cortex-M and Cortex-A cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2021 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dsp/complex_math_functions.h"
+
+/**
+  @ingroup groupCmplxMath
+ */
+
+/**
+  @addtogroup cmplx_mag_approx
+  @{
+ */
+
+/**
+  @brief         Floating-point approximate complex magnitude, two-line refinement.
+  @param[in]     pSrc        points to input vector
+  @param[out]    pDst        points to output vector
+  @param[in]     numSamples  number of samples in each vector
+
+  @par           Accuracy
+                   Relative error within +/-0.971 %.
+ */
+
+#define CMPLX_MAG_A0_F32 0.990299465f
+#define CMPLX_MAG_B0_F32 0.196981536f
+#define CMPLX_MAG_A1_F32 0.839535260f
+#define CMPLX_MAG_B1_F32 0.560959724f
+
+#if defined(ARM_MATH_MVEF) && !defined(ARM_MATH_AUTOVECTORIZE)
+
+#include "arm_helium_utils.h"
+
+ARM_DSP_ATTRIBUTE void arm_cmplx_mag_approx_refined_f32(
+  const float32_t * pSrc,
+        float32_t * pDst,
+        uint32_t numSamples)
+{
+    uint32_t  blkCnt;           /* loop counters */
+    f32x4x2_t vecSrc;
+    f32x4_t vecRe, vecIm, vecHi, vecLo, vecEst0, vecEst1;
+    float32_t real, imag, hi, lo, est0, est1;
+
+    /* Compute 4 complex samples at a time */
+    blkCnt = numSamples >> 2;
+    while (blkCnt > 0U)
+    {
+        vecSrc = vld2q(pSrc);
+        pSrc += 8;
+        vecRe = vabsq(vecSrc.val[0]);
+        vecIm = vabsq(vecSrc.val[1]);
+        vecHi = vmaxnmq(vecRe, vecIm);
+        vecLo = vminnmq(vecRe, vecIm);
+
+        vecEst0 = vmulq(vecHi, CMPLX_MAG_A0_F32);
+        vecEst0 = vfmaq(vecEst0, vecLo, CMPLX_MAG_B0_F32);
+        vecEst1 = vmulq(vecHi, CMPLX_MAG_A1_F32);
+        vecEst1 = vfmaq(vecEst1, vecLo, CMPLX_MAG_B1_F32);
+
+        vst1q(pDst, vmaxnmq(vecEst0, vecEst1));
+        pDst += 4;
+
+        blkCnt--;
+    }
+
+    /* tail */
+    blkCnt = numSamples & 3;
+    while (blkCnt > 0U)
+    {
+        real = fabsf(*pSrc++);
+        imag = fabsf(*pSrc++);
+        hi = real > imag ? real : imag;
+        lo = real > imag ? imag : real;
+        est0 = CMPLX_MAG_A0_F32 * hi + CMPLX_MAG_B0_F32 * lo;
+        est1 = CMPLX_MAG_A1_F32 * hi + CMPLX_MAG_B1_F32 * lo;
+        *pDst++ = est0 > est1 ? est0 : est1;
+
+        blkCnt--;
+    }
+}
+
+#else
+ARM_DSP_ATTRIBUTE void arm_cmplx_mag_approx_refined_f32(
+  const float32_t * pSrc,
+        float32_t * pDst,
+        uint32_t numSamples)
+{
+  uint32_t blkCnt;                               /* loop counter */
+  float32_t real, imag, hi, lo, est0, est1;      /* Temporary variables */
+
+#if defined (ARM_MATH_LOOPUNROLL)
+
+  /* Loop unrolling: Compute 4 outputs at a time */
+  blkCnt = numSamples >> 2U;
+
+  while (blkCnt > 0U)
+  {
+    /* C[0] = max(a0 * hi + b0 * lo, a1 * hi + b1 * lo) */
+
+    real = fabsf(*pSrc++);
+    imag = fabsf(*pSrc++);
+    hi = real > imag ? real : imag;
+    lo = real > imag ? imag : real;
+    est0 = CMPLX_MAG_A0_F32 * hi + CMPLX_MAG_B0_F32 * lo;
+    est1 = CMPLX_MAG_A1_F32 * hi + CMPLX_MAG_B1_F32 * lo;
+    *pDst++ = est0 > est1 ? est0 : est1;
+
+    real = fabsf(*pSrc++);
+    imag = fabsf(*pSrc++);
+    hi = real > imag ? real : imag;
+    lo = real > imag ? imag : real;
+    est0 = CMPLX_MAG_A0_F32 * hi + CMPLX_MAG_B0_F32 * lo;
+    est1 = CMPLX_MAG_A1_F32 * hi + CMPLX_MAG_B1_F32 * lo;
+    *pDst++ = est0 > est1 ? est0 : est1;
+
+    real = fabsf(*pSrc++);
+    imag = fabsf(*pSrc++);
+    hi = real > imag ? real : imag;
+    lo = real > imag ? imag : real;
+    est0 = CMPLX_MAG_A0_F32 * hi + CMPLX_MAG_B0_F32 * lo;
+    est1 = CMPLX_MAG_A1_F32 * hi + CMPLX_MAG_B1_F32 * lo;
+    *pDst++ = est0 > est1 ? est0 : est1;
+
+    real = fabsf(*pSrc++);
+    imag = fabsf(*pSrc++);
+    hi = real > imag ? real : imag;
+    lo = real > imag ? imag : real;
+    est0 = CMPLX_MAG_A0_F32 * hi + CMPLX_MAG_B0_F32 * lo;
+    est1 = CMPLX_MAG_A1_F32 * hi + CMPLX_MAG_B1_F32 * lo;
+    *pDst++ = est0 > est1 ? est0 : est1;
+
+    /* Decrement loop counter */
+    blkCnt--;
+  }
+
+  /* Loop unrolling: Compute remaining outputs */
+  blkCnt = numSamples % 0x4U;
+
+#else
+
+  /* Initialize blkCnt with number of samples */
+  blkCnt = numSamples;
+
+#endif /* #if defined (ARM_MATH_LOOPUNROLL) */
+
+  while (blkCnt > 0U)
+  {
+    /* C[0] = max(a0 * hi + b0 * lo, a1 * hi + b1 * lo) */
+
+    real = fabsf(*pSrc++);
+    imag = fabsf(*pSrc++);
+    hi = real > imag ? real : imag;
+    lo = real > imag ? imag : real;
+    est0 = CMPLX_MAG_A0_F32 * hi + CMPLX_MAG_B0_F32 * lo;
+    est1 = CMPLX_MAG_A1_F32 * hi + CMPLX_MAG_B1_F32 * lo;
+    *pDst++ = est0 > est1 ? est0 : est1;
+
+    /* Decrement loop counter */
+    blkCnt--;
+  }
+
+}
+#endif /* defined(ARM_MATH_MVEF) && !defined(ARM_MATH_AUTOVECTORIZE) */
+
+/**
+  @} end of cmplx_mag_approx group
+ */
@@ -90,6 +90,9 @@ target_sources(CMSISDSP PRIVATE StatisticsFunctions/arm_mse_f32.c)
 target_sources(CMSISDSP PRIVATE StatisticsFunctions/arm_mse_f64.c)
 target_sources(CMSISDSP PRIVATE StatisticsFunctions/arm_accumulate_f64.c)
 target_sources(CMSISDSP PRIVATE StatisticsFunctions/arm_accumulate_f32.c)
+target_sources(CMSISDSP PRIVATE StatisticsFunctions/arm_band_sum_f32.c)
+target_sources(CMSISDSP PRIVATE StatisticsFunctions/arm_band_prefix_f32.c)
+target_sources(CMSISDSP PRIVATE StatisticsFunctions/arm_band_sum_prefix_f32.c)
 
 
 if ((NOT ARMAC5) AND (NOT DISABLEFLOAT16))
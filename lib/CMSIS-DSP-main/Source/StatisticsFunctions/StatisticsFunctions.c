@@ -100,5 +100,8 @@
 #include "arm_mse_f64.c"
 #include "arm_accumulate_f32.c"
 #include "arm_accumulate_f64.c"
+#include "arm_band_sum_f32.c"
+#include "arm_band_prefix_f32.c"
+#include "arm_band_sum_prefix_f32.c"
 
 
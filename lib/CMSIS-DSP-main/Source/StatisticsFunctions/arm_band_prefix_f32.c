@@ -0,0 +1,105 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_band_prefix_f32.c
+ * Description:  Prefix sums of a floating-point vector for band queries
+ *
+ * $Date:        17 October 2026
+ * $Revision:    V1.0.0
+ *
+ * Target Processor: Cortex-M and Cortex-A cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2021 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dsp/statistics_functions.h"
+
+/**
+ @ingroup groupStats
+ */
+
+/**
+ @addtogroup BandSum
+ @{
+ */
+
+/**
+ @brief         Prefix sums of a floating-point vector, for arm_band_sum_prefix_f32().
+ @param[in]     pSrc       points to the input vector.
+ @param[in]     blockSize  number of samples in input vector.
+ @param[out]    pDst       points to blockSize + 1 prefix sums:
+                           pDst[0] = 0, pDst[k + 1] = pDst[k] + pSrc[k].
+
+ @par           The scan is a dependency chain, so it is the same scalar
+                loop on every target.
+ */
+ARM_DSP_ATTRIBUTE void arm_band_prefix_f32(
+                        const float32_t * pSrc,
+                        uint32_t blockSize,
+                        float32_t * pDst)
+{
+  uint32_t blkCnt;                               /* Loop counter */
+  float32_t sum = 0.0f;                          /* Running sum */
+
+  *pDst++ = sum;
+
+#if defined (ARM_MATH_LOOPUNROLL) && !defined(ARM_MATH_AUTOVECTORIZE)
+
+  /* Loop unrolling: Compute 4 outputs at a time */
+  blkCnt = blockSize >> 2U;
+
+  while (blkCnt > 0U)
+  {
+    sum += *pSrc++;
+    *pDst++ = sum;
+
+    sum += *pSrc++;
+    *pDst++ = sum;
+
+    sum += *pSrc++;
+    *pDst++ = sum;
+
+    sum += *pSrc++;
+    *pDst++ = sum;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* Loop unrolling: Compute remaining outputs */
+  blkCnt = blockSize % 0x4U;
+
+#else
+
+  /* Initialize blkCnt with number of samples */
+  blkCnt = blockSize;
+
+#endif /* #if defined (ARM_MATH_LOOPUNROLL) */
+
+  while (blkCnt > 0U)
+  {
+    sum += *pSrc++;
+    *pDst++ = sum;
+
+    /* Decrement loop counter */
+    blkCnt--;
+  }
+}
+
+/**
+  @} end of BandSum group
+ */
@@ -0,0 +1,231 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_band_sum_f32.c
+ * Description:  Sums of a floating-point vector over bin ranges
+ *
+ * $Date:        17 October 2026
+ * $Revision:    V1.0.0
+ *
+ * Target Processor: Cortex-M and Cortex-A cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2021 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dsp/statistics_functions.h"
+
+/**
+ @ingroup groupStats
+ */
+
+/**
+ @defgroup BandSum Band sums
+
+ Sums a vector over a table of bin ranges, typically the bands of a power
+ or magnitude spectrum. Each range is half-open, [start, end), and
+ ranges may overlap or come in any order:
+
+ <pre>
+ pDst[i] = pSrc[pBands[i].start] + ... + pSrc[pBands[i].end - 1]
+ </pre>
+
+ An empty range (start >= end) gives 0.
+
+ When many bands are queried from one vector, the prefix-sum mode does
+ one O(n) scan with arm_band_prefix_f32() and then answers every band in
+ O(1) with arm_band_sum_prefix_f32(). The difference of two prefix sums
+ carries an absolute error of the order of the float epsilon times the
+ sum up to the band's end, so narrow low-power bands above large ones
+ are better summed directly.
+ */
+
+/**
+ @addtogroup BandSum
+ @{
+ */
+
+/**
+ @brief         Sums of a floating-point vector over bin ranges.
+ @param[in]     pSrc       points to the input vector.
+ @param[in]     pBands     points to numBands [start, end) ranges.
+ @param[in]     numBands   number of ranges.
+ @param[out]    pDst       points to numBands sums.
+ */
+
+#if defined(ARM_MATH_MVEF) && !defined(ARM_MATH_AUTOVECTORIZE)
+
+#include "arm_helium_utils.h"
+
+ARM_DSP_ATTRIBUTE void arm_band_sum_f32(
+                        const float32_t * pSrc,
+                        const arm_band_range * pBands,
+                        uint32_t numBands,
+                        float32_t * pDst)
+{
+    f32x4_t vecA;
+    f32x4_t vecSum;
+    const float32_t *pIn;
+    int32_t blkCnt;
+
+    while (numBands > 0U)
+    {
+        pIn = pSrc + pBands->start;
+        blkCnt = (int32_t) pBands->end - (int32_t) pBands->start;
+        pBands++;
+
+        vecSum = vdupq_n_f32(0.0f);
+
+        /* tail predication covers the last 1 to 3 bins of the range */
+        while (blkCnt > 0)
+        {
+            mve_pred16_t p0 = vctp32q(blkCnt);
+            vecA = vld1q_z(pIn, p0);
+            vecSum = vaddq_m(vecSum, vecSum, vecA, p0);
+            pIn += 4;
+            blkCnt -= 4;
+        }
+
+        *pDst++ = vecAddAcrossF32Mve(vecSum);
+
+        numBands--;
+    }
+}
+
+#else
+
+#if defined(ARM_MATH_NEON) && !defined(ARM_MATH_AUTOVECTORIZE)
+ARM_DSP_ATTRIBUTE void arm_band_sum_f32(
+                        const float32_t * pSrc,
+                        const arm_band_range * pBands,
+                        uint32_t numBands,
+                        float32_t * pDst)
+{
+  float32_t sum;                                 /* Temporary result storage */
+  float32x4_t sumV;
+  float32x2_t sumV2;
+  float32x4_t inV;
+  const float32_t *pIn;
+  uint32_t blkCnt;                               /* Loop counter */
+  uint32_t len;
+
+  while (numBands > 0U)
+  {
+    pIn = pSrc + pBands->start;
+    len = pBands->end > pBands->start ? (uint32_t) (pBands->end - pBands->start) : 0U;
+    pBands++;
+
+    sumV = vdupq_n_f32(0.0f);
+
+    /* Compute 4 bins at a time */
+    blkCnt = len >> 2U;
+    while (blkCnt > 0U)
+    {
+      inV = vld1q_f32(pIn);
+      sumV = vaddq_f32(sumV, inV);
+      pIn += 4;
+      blkCnt--;
+    }
+
+    sumV2 = vpadd_f32(vget_low_f32(sumV), vget_high_f32(sumV));
+    sum = vget_lane_f32(sumV2, 0) + vget_lane_f32(sumV2, 1);
+
+    /* remaining 1 to 3 bins */
+    blkCnt = len & 3U;
+    while (blkCnt > 0U)
+    {
+      sum += *pIn++;
+      blkCnt--;
+    }
+
+    *pDst++ = sum;
+
+    numBands--;
+  }
+}
+
+#else
+ARM_DSP_ATTRIBUTE void arm_band_sum_f32(
+                        const float32_t * pSrc,
+                        const arm_band_range * pBands,
+                        uint32_t numBands,
+                        float32_t * pDst)
+{
+  float32_t sum;                                 /* Temporary result storage */
+  const float32_t *pIn;
+  uint32_t blkCnt;                               /* Loop counter */
+  uint32_t len;
+
+  while (numBands > 0U)
+  {
+    pIn = pSrc + pBands->start;
+    len = pBands->end > pBands->start ? (uint32_t) (pBands->end - pBands->start) : 0U;
+    pBands++;
+
+    sum = 0.0f;
+
+#if defined (ARM_MATH_LOOPUNROLL) && !defined(ARM_MATH_AUTOVECTORIZE)
+
+    /* Loop unrolling: Compute 4 bins at a time */
+    blkCnt = len >> 2U;
+
+    while (blkCnt > 0U)
+    {
+      /* C = A[start] + A[start + 1] + ... + A[end - 1] */
+      sum += *pIn++;
+
+      sum += *pIn++;
+
+      sum += *pIn++;
+
+      sum += *pIn++;
+
+      /* Decrement the loop counter */
+      blkCnt--;
+    }
+
+    /* Loop unrolling: Compute remaining bins */
+    blkCnt = len % 0x4U;
+
+#else
+
+    /* Initialize blkCnt with the number of bins */
+    blkCnt = len;
+
+#endif /* #if defined (ARM_MATH_LOOPUNROLL) */
+
+    while (blkCnt > 0U)
+    {
+      /* C = A[start] + A[start + 1] + ... + A[end - 1] */
+      sum += *pIn++;
+
+      /* Decrement loop counter */
+      blkCnt--;
+    }
+
+    /* Store result to destination */
+    *pDst++ = sum;
+
+    numBands--;
+  }
+}
+#endif /* #if defined(ARM_MATH_NEON) */
+
+#endif /* defined(ARM_MATH_MVEF) && !defined(ARM_MATH_AUTOVECTORIZE) */
+
+/**
+  @} end of BandSum group
+ */
@@ -0,0 +1,68 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_band_sum_prefix_f32.c
+ * Description:  Band sums from prefix sums
+ *
+ * $Date:        17 October 2026
+ * $Revision:    V1.0.0
+ *
+ * Target Processor: Cortex-M and Cortex-A cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2021 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dsp/statistics_functions.h"
+
+/**
+ @ingroup groupStats
+ */
+
+/**
+ @addtogroup BandSum
+ @{
+ */
+
+/**
+ @brief         Sums over bin ranges from the prefix sums of arm_band_prefix_f32(), O(1) per range.
+ @param[in]     pPrefix    points to the prefix sums (blockSize + 1 values).
+ @param[in]     pBands     points to numBands [start, end) ranges, end <= blockSize.
+ @param[in]     numBands   number of ranges.
+ @param[out]    pDst       points to numBands sums.
+ */
+ARM_DSP_ATTRIBUTE void arm_band_sum_prefix_f32(
+                        const float32_t * pPrefix,
+                        const arm_band_range * pBands,
+                        uint32_t numBands,
+                        float32_t * pDst)
+{
+  while (numBands > 0U)
+  {
+    /* C = P[end] - P[start] */
+    *pDst++ = pBands->end > pBands->start
+            ? pPrefix[pBands->end] - pPrefix[pBands->start]
+            : 0.0f;
+    pBands++;
+
+    /* Decrement loop counter */
+    numBands--;
+  }
+}
+
+/**
+  @} end of BandSum group
+ */
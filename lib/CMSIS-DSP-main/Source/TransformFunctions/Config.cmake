@@ -54,6 +54,7 @@ target_sources(CMSISDSP PRIVATE TransformFunctions/arm_cfft_radix4_f32.c)
 
 target_sources(CMSISDSP PRIVATE TransformFunctions/arm_rfft_init_q31.c)
 target_sources(CMSISDSP PRIVATE TransformFunctions/arm_rfft_q31.c)
+target_sources(CMSISDSP PRIVATE TransformFunctions/arm_rfft_inplace_q31.c)
 target_sources(CMSISDSP PRIVATE TransformFunctions/arm_cfft_q31.c)
 target_sources(CMSISDSP PRIVATE TransformFunctions/arm_cfft_init_q31.c)
 target_sources(CMSISDSP PRIVATE TransformFunctions/arm_cfft_radix4_init_q31.c)
@@ -61,12 +62,14 @@ target_sources(CMSISDSP PRIVATE TransformFunctions/arm_cfft_radix4_q31.c)
 
 target_sources(CMSISDSP PRIVATE TransformFunctions/arm_rfft_init_q15.c)
 target_sources(CMSISDSP PRIVATE TransformFunctions/arm_rfft_q15.c)
+target_sources(CMSISDSP PRIVATE TransformFunctions/arm_rfft_inplace_q15.c)
 target_sources(CMSISDSP PRIVATE TransformFunctions/arm_cfft_q15.c)
 target_sources(CMSISDSP PRIVATE TransformFunctions/arm_cfft_init_q15.c)
 target_sources(CMSISDSP PRIVATE TransformFunctions/arm_cfft_radix4_init_q15.c)
 target_sources(CMSISDSP PRIVATE TransformFunctions/arm_cfft_radix4_q15.c)
 
 target_sources(CMSISDSP PRIVATE TransformFunctions/arm_rfft_fast_f32.c)
+target_sources(CMSISDSP PRIVATE TransformFunctions/arm_rfft_fast_inplace_f32.c)
 target_sources(CMSISDSP PRIVATE TransformFunctions/arm_rfft_fast_init_f32.c)
 target_sources(CMSISDSP PRIVATE TransformFunctions/arm_cfft_f32.c)
 target_sources(CMSISDSP PRIVATE TransformFunctions/arm_cfft_init_f32.c)
@@ -77,6 +80,7 @@ target_sources(CMSISDSP PRIVATE TransformFunctions/arm_rfft_fast_init_f64.c)
 
 if ((NOT ARMAC5) AND (NOT DISABLEFLOAT16))
 target_sources(CMSISDSP PRIVATE TransformFunctions/arm_rfft_fast_f16.c)
+target_sources(CMSISDSP PRIVATE TransformFunctions/arm_rfft_fast_inplace_f16.c)
 target_sources(CMSISDSP PRIVATE TransformFunctions/arm_rfft_fast_init_f16.c)
 target_sources(CMSISDSP PRIVATE TransformFunctions/arm_cfft_f16.c)
 target_sources(CMSISDSP PRIVATE TransformFunctions/arm_cfft_init_f16.c)
@@ -88,12 +92,14 @@ target_sources(CMSISDSP PRIVATE TransformFunctions/arm_cfft_radix4_f32.c)
 
 target_sources(CMSISDSP PRIVATE TransformFunctions/arm_rfft_init_q15.c)
 target_sources(CMSISDSP PRIVATE TransformFunctions/arm_rfft_q15.c)
+target_sources(CMSISDSP PRIVATE TransformFunctions/arm_rfft_inplace_q15.c)
 target_sources(CMSISDSP PRIVATE TransformFunctions/arm_cfft_q15.c)
 target_sources(CMSISDSP PRIVATE TransformFunctions/arm_cfft_init_q15.c)
 target_sources(CMSISDSP PRIVATE TransformFunctions/arm_cfft_radix4_q15.c)
 
 target_sources(CMSISDSP PRIVATE TransformFunctions/arm_rfft_init_q31.c)
 target_sources(CMSISDSP PRIVATE TransformFunctions/arm_rfft_q31.c)
+target_sources(CMSISDSP PRIVATE TransformFunctions/arm_rfft_inplace_q31.c)
 target_sources(CMSISDSP PRIVATE TransformFunctions/arm_cfft_q31.c)
 target_sources(CMSISDSP PRIVATE TransformFunctions/arm_cfft_init_q31.c)
 target_sources(CMSISDSP PRIVATE TransformFunctions/arm_cfft_radix4_q31.c)
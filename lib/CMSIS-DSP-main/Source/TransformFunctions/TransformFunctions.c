@@ -44,6 +44,7 @@
 #include "arm_cfft_radix4_q31.c"
 #include "arm_cfft_radix8_f32.c"
 #include "arm_rfft_fast_f32.c"
+#include "arm_rfft_fast_inplace_f32.c"
 #include "arm_rfft_fast_f64.c"
 #include "arm_rfft_fast_init_f32.c"
 #include "arm_rfft_fast_init_f64.c"
@@ -61,6 +62,8 @@
 
 #include "arm_rfft_q15.c"
 #include "arm_rfft_q31.c"
+#include "arm_rfft_inplace_q15.c"
+#include "arm_rfft_inplace_q31.c"
 
 #include "arm_rfft_init_q15.c"
 #include "arm_rfft_init_q31.c"
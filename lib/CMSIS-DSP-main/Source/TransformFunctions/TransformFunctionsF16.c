@@ -32,6 +32,7 @@
 #include "arm_cfft_radix4_f16.c"
 #include "arm_rfft_fast_init_f16.c"
 #include "arm_rfft_fast_f16.c"
+#include "arm_rfft_fast_inplace_f16.c"
 #include "arm_cfft_radix8_f16.c"
 
 #include "arm_bitreversal_f16.c"
@@ -0,0 +1,190 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_rfft_fast_inplace_f16.c
+ * Description:  In-place RFFT & RIFFT Floating point (f16) process function
+ *
+ * $Date:        17 October 2026
+ * $Revision:    V1.10.0
+ *
+ * Target Processor: Cortex-M and Cortex-A cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2026 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "dsp/transform_functions_f16.h"
+
+#if defined(ARM_FLOAT16_SUPPORTED)
+
+#if !defined(ARM_MATH_NEON_FLOAT16) || defined(ARM_MATH_AUTOVECTORIZE)
+
+/* One bin of the forward split: X(k) from A = Z(k), B = Z(L-k) and the
+   twiddle of k, as stage_rfft_f16 computes it. */
+__STATIC_FORCEINLINE void split_bin_f16(
+        float16_t xAR,
+        float16_t xAI,
+        float16_t xBR,
+        float16_t xBI,
+  const float16_t * tw,
+        float16_t * pOut)
+{
+  float16_t t1a, t1b, p0, p1, p2, p3;
+
+  t1a = (_Float16)xBR - (_Float16)xAR ;
+  t1b = (_Float16)xBI + (_Float16)xAI ;
+
+  // real(tw * (xB - xA)) = twR * (xBR - xAR) - twI * (xBI - xAI);
+  // imag(tw * (xB - xA)) = twI * (xBR - xAR) + twR * (xBI - xAI);
+  p0 = (_Float16)tw[0] * (_Float16)t1a;
+  p1 = (_Float16)tw[1] * (_Float16)t1a;
+  p2 = (_Float16)tw[0] * (_Float16)t1b;
+  p3 = (_Float16)tw[1] * (_Float16)t1b;
+
+  pOut[0] = 0.5f16 * ((_Float16)xAR + (_Float16)xBR + (_Float16)p0 + (_Float16)p3 ); //xAR
+  pOut[1] = 0.5f16 * ((_Float16)xAI - (_Float16)xBI + (_Float16)p1 - (_Float16)p2 ); //xAI
+}
+
+/* One bin of the inverse merge, as merge_rfft_f16 computes it. */
+__STATIC_FORCEINLINE void merge_bin_f16(
+        float16_t xAR,
+        float16_t xAI,
+        float16_t xBR,
+        float16_t xBI,
+  const float16_t * tw,
+        float16_t * pOut)
+{
+  float16_t t1a, t1b, r, s, t, u;
+
+  t1a = (_Float16)xAR - (_Float16)xBR ;
+  t1b = (_Float16)xAI + (_Float16)xBI ;
+
+  r = (_Float16)tw[0] * (_Float16)t1a;
+  s = (_Float16)tw[1] * (_Float16)t1b;
+  t = (_Float16)tw[1] * (_Float16)t1a;
+  u = (_Float16)tw[0] * (_Float16)t1b;
+
+  // real(tw * (xA - xB)) = twR * (xAR - xBR) - twI * (xAI - xBI);
+  // imag(tw * (xA - xB)) = twI * (xAR - xBR) + twR * (xAI - xBI);
+  pOut[0] = 0.5f16 * ((_Float16)xAR + (_Float16)xBR - (_Float16)r - (_Float16)s ); //xAR
+  pOut[1] = 0.5f16 * ((_Float16)xAI - (_Float16)xBI + (_Float16)t - (_Float16)u ); //xAI
+}
+
+/**
+  @addtogroup RealFFTF16
+  @{
+*/
+
+/**
+  @brief         In-place processing function for the floating-point real FFT (f16).
+  @param[in]     S         points to an arm_rfft_fast_instance_f16 structure
+  @param[in,out] p         points to the N samples, overwritten by the result
+  @param[in]     ifftFlag
+                   - value = 0: RFFT
+                   - value = 1: RIFFT
+
+  @par           Same result and format as \ref arm_rfft_fast_f16, without the
+                 output buffer: the packed spectrum (DC and Nyquist in the first
+                 complex number) replaces the input, and for the RIFFT the
+                 signal replaces the spectrum. The split stage handles bins k
+                 and N/2-k together since each output needs both inputs.
+  @par           Not available in the Neon f16 build, whose real FFT has a
+                 different instance and needs a temporary buffer.
+*/
+ARM_DSP_ATTRIBUTE void arm_rfft_fast_inplace_f16(
+  const arm_rfft_fast_instance_f16 * S,
+  float16_t * p,
+  uint8_t ifftFlag)
+{
+  const arm_cfft_instance_f16 * Sint = &(S->Sint);
+  const float16_t * pCoeff = S->pTwiddleRFFT;
+        uint32_t L = Sint->fftLen;           /* complex points */
+        uint32_t k, j;
+        float16_t xAR, xAI, xBR, xBI;
+        float16_t outA[2], outB[2];
+
+  if (ifftFlag)
+  {
+    /* DC and Nyquist come packed in the first complex number */
+    xAR = p[0];
+    xAI = p[1];
+    p[0] = 0.5f16 * ( (_Float16)xAR + (_Float16)xAI );
+    p[1] = 0.5f16 * ( (_Float16)xAR - (_Float16)xAI );
+
+    for (k = 1U; k <= L / 2U; k++)
+    {
+      j = L - k;
+      xAR = p[2U * k];
+      xAI = p[2U * k + 1U];
+      xBR = p[2U * j];
+      xBI = p[2U * j + 1U];
+
+      merge_bin_f16(xAR, xAI, xBR, xBI, &pCoeff[2U * k], outA);
+      if (j != k)
+      {
+        merge_bin_f16(xBR, xBI, xAR, xAI, &pCoeff[2U * j], outB);
+        p[2U * j]      = outB[0];
+        p[2U * j + 1U] = outB[1];
+      }
+      p[2U * k]      = outA[0];
+      p[2U * k + 1U] = outA[1];
+    }
+
+    /* Complex IFFT process */
+    arm_cfft_f16( Sint, p, ifftFlag, 1);
+  }
+  else
+  {
+    /* Calculation of RFFT of input */
+    arm_cfft_f16( Sint, p, ifftFlag, 1);
+
+    /* Pack first and last sample of the frequency domain together */
+    xAR = p[0];
+    xAI = p[1];
+    xBR = (_Float16)xAR + (_Float16)xAR;
+    xBI = (_Float16)xAI + (_Float16)xAI;
+    p[0] = 0.5f16 * ( (_Float16)xBR + (_Float16)xBI );
+    p[1] = 0.5f16 * ( (_Float16)xBR - (_Float16)xBI );
+
+    for (k = 1U; k <= L / 2U; k++)
+    {
+      j = L - k;
+      xAR = p[2U * k];
+      xAI = p[2U * k + 1U];
+      xBR = p[2U * j];
+      xBI = p[2U * j + 1U];
+
+      split_bin_f16(xAR, xAI, xBR, xBI, &pCoeff[2U * k], outA);
+      if (j != k)
+      {
+        split_bin_f16(xBR, xBI, xAR, xAI, &pCoeff[2U * j], outB);
+        p[2U * j]      = outB[0];
+        p[2U * j + 1U] = outB[1];
+      }
+      p[2U * k]      = outA[0];
+      p[2U * k + 1U] = outA[1];
+    }
+  }
+}
+
+/**
+* @} end of RealFFTF16 group
+*/
+
+#endif /* !defined(ARM_MATH_NEON_FLOAT16) || defined(ARM_MATH_AUTOVECTORIZE) */
+
+#endif /* #if defined(ARM_FLOAT16_SUPPORTED) */
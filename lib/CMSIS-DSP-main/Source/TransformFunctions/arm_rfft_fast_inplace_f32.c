@@ -0,0 +1,186 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_rfft_fast_inplace_f32.c
+ * Description:  In-place RFFT & RIFFT Floating point process function
+ *
+ * $Date:        17 October 2026
+ * $Revision:    V1.10.0
+ *
+ * Target Processor: Cortex-M and Cortex-A cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2026 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "dsp/transform_functions.h"
+
+#if !defined(ARM_MATH_NEON) || defined(ARM_MATH_AUTOVECTORIZE)
+
+/* One bin of the forward split: X(k) from A = Z(k), B = Z(L-k) and the
+   twiddle of k, as stage_rfft_f32 computes it. */
+__STATIC_FORCEINLINE void split_bin_f32(
+        float32_t xAR,
+        float32_t xAI,
+        float32_t xBR,
+        float32_t xBI,
+  const float32_t * tw,
+        float32_t * pOut)
+{
+  float32_t t1a, t1b, p0, p1, p2, p3;
+
+  t1a = xBR - xAR ;
+  t1b = xBI + xAI ;
+
+  // real(tw * (xB - xA)) = twR * (xBR - xAR) - twI * (xBI - xAI);
+  // imag(tw * (xB - xA)) = twI * (xBR - xAR) + twR * (xBI - xAI);
+  p0 = tw[0] * t1a;
+  p1 = tw[1] * t1a;
+  p2 = tw[0] * t1b;
+  p3 = tw[1] * t1b;
+
+  pOut[0] = 0.5f * (xAR + xBR + p0 + p3 ); //xAR
+  pOut[1] = 0.5f * (xAI - xBI + p1 - p2 ); //xAI
+}
+
+/* One bin of the inverse merge, as merge_rfft_f32 computes it. */
+__STATIC_FORCEINLINE void merge_bin_f32(
+        float32_t xAR,
+        float32_t xAI,
+        float32_t xBR,
+        float32_t xBI,
+  const float32_t * tw,
+        float32_t * pOut)
+{
+  float32_t t1a, t1b, r, s, t, u;
+
+  t1a = xAR - xBR ;
+  t1b = xAI + xBI ;
+
+  r = tw[0] * t1a;
+  s = tw[1] * t1b;
+  t = tw[1] * t1a;
+  u = tw[0] * t1b;
+
+  // real(tw * (xA - xB)) = twR * (xAR - xBR) - twI * (xAI - xBI);
+  // imag(tw * (xA - xB)) = twI * (xAR - xBR) + twR * (xAI - xBI);
+  pOut[0] = 0.5f * (xAR + xBR - r - s ); //xAR
+  pOut[1] = 0.5f * (xAI - xBI + t - u ); //xAI
+}
+
+/**
+  @addtogroup RealFFTF32
+  @{
+*/
+
+/**
+  @brief         In-place processing function for the floating-point real FFT.
+  @param[in]     S         points to an arm_rfft_fast_instance_f32 structure
+  @param[in,out] p         points to the N samples, overwritten by the result
+  @param[in]     ifftFlag
+                   - value = 0: RFFT
+                   - value = 1: RIFFT
+
+  @par           Same result and format as \ref arm_rfft_fast_f32, without the
+                 output buffer: the packed spectrum (DC and Nyquist in the first
+                 complex number) replaces the input, and for the RIFFT the
+                 signal replaces the spectrum. The split stage handles bins k
+                 and N/2-k together since each output needs both inputs.
+  @par           Not available in the Neon build, whose real FFT has a
+                 different instance and needs a temporary buffer.
+*/
+ARM_DSP_ATTRIBUTE void arm_rfft_fast_inplace_f32(
+  const arm_rfft_fast_instance_f32 * S,
+  float32_t * p,
+  uint8_t ifftFlag)
+{
+  const arm_cfft_instance_f32 * Sint = &(S->Sint);
+  const float32_t * pCoeff = S->pTwiddleRFFT;
+        uint32_t L = Sint->fftLen;           /* complex points */
+        uint32_t k, j;
+        float32_t xAR, xAI, xBR, xBI;
+        float32_t outA[2], outB[2];
+
+  if (ifftFlag)
+  {
+    /* DC and Nyquist come packed in the first complex number */
+    xAR = p[0];
+    xAI = p[1];
+    p[0] = 0.5f * ( xAR + xAI );
+    p[1] = 0.5f * ( xAR - xAI );
+
+    for (k = 1U; k <= L / 2U; k++)
+    {
+      j = L - k;
+      xAR = p[2U * k];
+      xAI = p[2U * k + 1U];
+      xBR = p[2U * j];
+      xBI = p[2U * j + 1U];
+
+      merge_bin_f32(xAR, xAI, xBR, xBI, &pCoeff[2U * k], outA);
+      if (j != k)
+      {
+        merge_bin_f32(xBR, xBI, xAR, xAI, &pCoeff[2U * j], outB);
+        p[2U * j]      = outB[0];
+        p[2U * j + 1U] = outB[1];
+      }
+      p[2U * k]      = outA[0];
+      p[2U * k + 1U] = outA[1];
+    }
+
+    /* Complex radix-4 IFFT process */
+    arm_cfft_f32( Sint, p, ifftFlag, 1);
+  }
+  else
+  {
+    /* Calculation of RFFT of input */
+    arm_cfft_f32( Sint, p, ifftFlag, 1);
+
+    /* Pack first and last sample of the frequency domain together */
+    xAR = p[0];
+    xAI = p[1];
+    xBR = xAR + xAR;
+    xBI = xAI + xAI;
+    p[0] = 0.5f * ( xBR + xBI );
+    p[1] = 0.5f * ( xBR - xBI );
+
+    for (k = 1U; k <= L / 2U; k++)
+    {
+      j = L - k;
+      xAR = p[2U * k];
+      xAI = p[2U * k + 1U];
+      xBR = p[2U * j];
+      xBI = p[2U * j + 1U];
+
+      split_bin_f32(xAR, xAI, xBR, xBI, &pCoeff[2U * k], outA);
+      if (j != k)
+      {
+        split_bin_f32(xBR, xBI, xAR, xAI, &pCoeff[2U * j], outB);
+        p[2U * j]      = outB[0];
+        p[2U * j + 1U] = outB[1];
+      }
+      p[2U * k]      = outA[0];
+      p[2U * k + 1U] = outA[1];
+    }
+  }
+}
+
+/**
+* @} end of RealFFTF32 group
+*/
+
+#endif /* !defined(ARM_MATH_NEON) || defined(ARM_MATH_AUTOVECTORIZE) */
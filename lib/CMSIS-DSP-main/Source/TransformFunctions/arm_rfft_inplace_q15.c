@@ -0,0 +1,191 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_rfft_inplace_q15.c
+ * Description:  In-place RFFT & RIFFT Q15 process function
+ *
+ * $Date:        17 October 2026
+ * $Revision:    V1.10.0
+ *
+ * Target Processor: Cortex-M and Cortex-A cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2026 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "dsp/transform_functions.h"
+
+#if !defined(ARM_MATH_NEON) || defined(ARM_MATH_AUTOVECTORIZE)
+
+/* One bin of the forward split from A = Z(k), B = Z(N/2-k), as
+   arm_split_rfft_q15 computes it. */
+__STATIC_FORCEINLINE void split_bin_q15(
+        q15_t aR,
+        q15_t aI,
+        q15_t bR,
+        q15_t bI,
+  const q15_t * pCoefA,
+  const q15_t * pCoefB,
+        q15_t * pOut)
+{
+  q31_t outR, outI;
+
+  outR = aR * pCoefA[0];
+  outR = outR - (aI * pCoefA[1]);
+  outR = outR + (bR * pCoefB[0]);
+  outR = (outR + (bI * pCoefB[1])) >> 16;
+
+  outI = bR * pCoefB[1];
+  outI = outI - (bI * pCoefB[0]);
+  outI = outI + (aI * pCoefA[0]);
+  outI = outI + (aR * pCoefA[1]);
+
+  pOut[0] = (q15_t) outR;
+  pOut[1] = (q15_t) (outI >> 16);
+}
+
+/* One bin of the inverse split, as arm_split_rifft_q15 computes it. */
+__STATIC_FORCEINLINE void split_ibin_q15(
+        q15_t aR,
+        q15_t aI,
+        q15_t bR,
+        q15_t bI,
+  const q15_t * pCoefA,
+  const q15_t * pCoefB,
+        q15_t * pOut)
+{
+  q31_t outR, outI;
+
+  outR = bR * pCoefB[0];
+  outR = outR - (bI * pCoefB[1]);
+  outR = outR + (aR * pCoefA[0]);
+  outR = (outR + (aI * pCoefA[1])) >> 16;
+
+  outI = aI * pCoefA[0];
+  outI = outI - (aR * pCoefA[1]);
+  outI = outI - (bR * pCoefB[1]);
+  outI = outI - (bI * pCoefB[0]);
+
+  pOut[0] = (q15_t) outR;
+  pOut[1] = (q15_t) (outI >> 16);
+}
+
+/**
+  @addtogroup RealFFTQ15
+  @{
+ */
+
+/**
+  @brief         In-place processing function for the Q15 RFFT/RIFFT.
+  @param[in]     S     points to an instance of the Q15 RFFT/RIFFT structure
+  @param[in,out] p     points to the N samples, overwritten by the result
+
+  @par           Same arithmetic as \ref arm_rfft_q15, but the result replaces
+                 the input and only the non-redundant half of the spectrum is
+                 kept, packed as for the floating-point real FFT: p[0] is the
+                 DC term, p[1] the Nyquist term, then N/2-1 complex bins. The
+                 RIFFT takes the same packed layout. Output formats follow the
+                 tables of \ref arm_rfft_q15.
+  @par           The split stage handles bins k and N/2-k together since each
+                 output needs both inputs. Not available in the Neon build,
+                 whose real FFT has a different instance.
+ */
+ARM_DSP_ATTRIBUTE void arm_rfft_inplace_q15(
+  const arm_rfft_instance_q15 * S,
+        q15_t * p)
+{
+#if defined(ARM_MATH_MVEI) && !defined(ARM_MATH_AUTOVECTORIZE)
+  const arm_cfft_instance_q15 *S_CFFT = &(S->cfftInst);
+#else
+  const arm_cfft_instance_q15 *S_CFFT = S->pCfft;
+#endif
+  const q15_t *pATable = S->pTwiddleAReal;
+  const q15_t *pBTable = S->pTwiddleBReal;
+        uint32_t modifier = S->twidCoefRModifier;
+        uint32_t L2 = S->fftLenReal >> 1U;
+        uint32_t k, j;
+        q15_t aR, aI, bR, bI;
+        q15_t outA[2], outB[2];
+
+  if (S->ifftFlagR == 1U)
+  {
+     /* bin 0 pairs DC with Nyquist, both packed in the first complex number */
+     aR = p[0];
+     bR = p[1];
+     split_ibin_q15(aR, 0, bR, 0, pATable, pBTable, p);
+
+     for (k = 1U; k <= L2 / 2U; k++)
+     {
+        j = L2 - k;
+        aR = p[2U * k];
+        aI = p[2U * k + 1U];
+        bR = p[2U * j];
+        bI = p[2U * j + 1U];
+
+        split_ibin_q15(aR, aI, bR, bI, &pATable[2U * k * modifier], &pBTable[2U * k * modifier], outA);
+        if (j != k)
+        {
+           split_ibin_q15(bR, bI, aR, aI, &pATable[2U * j * modifier], &pBTable[2U * j * modifier], outB);
+           p[2U * j]      = outB[0];
+           p[2U * j + 1U] = outB[1];
+        }
+        p[2U * k]      = outA[0];
+        p[2U * k + 1U] = outA[1];
+     }
+
+     /* Complex IFFT process */
+     arm_cfft_q15 (S_CFFT, p, S->ifftFlagR, S->bitReverseFlagR);
+
+     arm_shift_q15(p, 1, p, S->fftLenReal);
+  }
+  else
+  {
+     /* Complex FFT process */
+     arm_cfft_q15 (S_CFFT, p, S->ifftFlagR, S->bitReverseFlagR);
+
+     /* DC and Nyquist, packed in the first complex number */
+     aR = p[0];
+     aI = p[1];
+     p[0] = (aR + aI) >> 1U;
+     p[1] = (aR - aI) >> 1U;
+
+     for (k = 1U; k <= L2 / 2U; k++)
+     {
+        j = L2 - k;
+        aR = p[2U * k];
+        aI = p[2U * k + 1U];
+        bR = p[2U * j];
+        bI = p[2U * j + 1U];
+
+        split_bin_q15(aR, aI, bR, bI, &pATable[2U * k * modifier], &pBTable[2U * k * modifier], outA);
+        if (j != k)
+        {
+           split_bin_q15(bR, bI, aR, aI, &pATable[2U * j * modifier], &pBTable[2U * j * modifier], outB);
+           p[2U * j]      = outB[0];
+           p[2U * j + 1U] = outB[1];
+        }
+        p[2U * k]      = outA[0];
+        p[2U * k + 1U] = outA[1];
+     }
+  }
+}
+
+/**
+  @} end of RealFFTQ15 group
+ */
+
+#endif /* !defined(ARM_MATH_NEON) || defined(ARM_MATH_AUTOVECTORIZE) */
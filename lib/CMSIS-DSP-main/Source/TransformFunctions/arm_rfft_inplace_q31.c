@@ -0,0 +1,192 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_rfft_inplace_q31.c
+ * Description:  In-place RFFT & RIFFT Q31 process function
+ *
+ * $Date:        17 October 2026
+ * $Revision:    V1.10.0
+ *
+ * Target Processor: Cortex-M and Cortex-A cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2026 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "dsp/transform_functions.h"
+
+#if !defined(ARM_MATH_NEON) || defined(ARM_MATH_AUTOVECTORIZE)
+
+/* One bin of the forward split from A = Z(k), B = Z(N/2-k), as
+   arm_split_rfft_q31 computes it. Each product is rounded on its own,
+   so the order of the sums does not change the result. */
+__STATIC_FORCEINLINE void split_bin_q31(
+        q31_t aR,
+        q31_t aI,
+        q31_t bR,
+        q31_t bI,
+  const q31_t * pCoefA,
+  const q31_t * pCoefB,
+        q31_t * pOut)
+{
+  q31_t outR, outI;
+  q31_t CoefA1 = pCoefA[0], CoefA2 = pCoefA[1], CoefB1 = pCoefB[0];
+
+  mult_32x32_keep32_R (outR, aR, CoefA1);
+  mult_32x32_keep32_R (outI, aR, CoefA2);
+  multSub_32x32_keep32_R (outR, aI, CoefA2);
+  multAcc_32x32_keep32_R (outI, aI, CoefA1);
+  multSub_32x32_keep32_R (outR, bI, CoefA2);
+  multSub_32x32_keep32_R (outI, bI, CoefB1);
+  multAcc_32x32_keep32_R (outR, bR, CoefB1);
+  multSub_32x32_keep32_R (outI, bR, CoefA2);
+
+  pOut[0] = outR;
+  pOut[1] = outI;
+}
+
+/* One bin of the inverse split, as arm_split_rifft_q31 computes it. */
+__STATIC_FORCEINLINE void split_ibin_q31(
+        q31_t aR,
+        q31_t aI,
+        q31_t bR,
+        q31_t bI,
+  const q31_t * pCoefA,
+  const q31_t * pCoefB,
+        q31_t * pOut)
+{
+  q31_t outR, outI;
+  q31_t CoefA1 = pCoefA[0], CoefA2 = pCoefA[1], CoefB1 = pCoefB[0];
+
+  mult_32x32_keep32_R (outR, aR, CoefA1);
+  mult_32x32_keep32_R (outI, aR, -CoefA2);
+  multAcc_32x32_keep32_R (outR, aI, CoefA2);
+  multAcc_32x32_keep32_R (outI, aI, CoefA1);
+  multAcc_32x32_keep32_R (outR, bI, CoefA2);
+  multSub_32x32_keep32_R (outI, bI, CoefB1);
+  multAcc_32x32_keep32_R (outR, bR, CoefB1);
+  multAcc_32x32_keep32_R (outI, bR, CoefA2);
+
+  pOut[0] = outR;
+  pOut[1] = outI;
+}
+
+/**
+  @addtogroup RealFFTQ31
+  @{
+ */
+
+/**
+  @brief         In-place processing function for the Q31 RFFT/RIFFT.
+  @param[in]     S     points to an instance of the Q31 RFFT/RIFFT structure
+  @param[in,out] p     points to the N samples, overwritten by the result
+
+  @par           Same arithmetic as \ref arm_rfft_q31, but the result replaces
+                 the input and only the non-redundant half of the spectrum is
+                 kept, packed as for the floating-point real FFT: p[0] is the
+                 DC term, p[1] the Nyquist term, then N/2-1 complex bins. The
+                 RIFFT takes the same packed layout. Output formats follow the
+                 tables of \ref arm_rfft_q31.
+  @par           The split stage handles bins k and N/2-k together since each
+                 output needs both inputs. Not available in the Neon build,
+                 whose real FFT has a different instance.
+ */
+ARM_DSP_ATTRIBUTE void arm_rfft_inplace_q31(
+  const arm_rfft_instance_q31 * S,
+        q31_t * p)
+{
+#if defined(ARM_MATH_MVEI) && !defined(ARM_MATH_AUTOVECTORIZE)
+  const arm_cfft_instance_q31 *S_CFFT = &(S->cfftInst);
+#else
+  const arm_cfft_instance_q31 *S_CFFT = S->pCfft;
+#endif
+  const q31_t *pATable = S->pTwiddleAReal;
+  const q31_t *pBTable = S->pTwiddleBReal;
+        uint32_t modifier = S->twidCoefRModifier;
+        uint32_t L2 = S->fftLenReal >> 1U;
+        uint32_t k, j;
+        q31_t aR, aI, bR, bI;
+        q31_t outA[2], outB[2];
+
+  if (S->ifftFlagR == 1U)
+  {
+     /* bin 0 pairs DC with Nyquist, both packed in the first complex number */
+     aR = p[0];
+     bR = p[1];
+     split_ibin_q31(aR, 0, bR, 0, pATable, pBTable, p);
+
+     for (k = 1U; k <= L2 / 2U; k++)
+     {
+        j = L2 - k;
+        aR = p[2U * k];
+        aI = p[2U * k + 1U];
+        bR = p[2U * j];
+        bI = p[2U * j + 1U];
+
+        split_ibin_q31(aR, aI, bR, bI, &pATable[2U * k * modifier], &pBTable[2U * k * modifier], outA);
+        if (j != k)
+        {
+           split_ibin_q31(bR, bI, aR, aI, &pATable[2U * j * modifier], &pBTable[2U * j * modifier], outB);
+           p[2U * j]      = outB[0];
+           p[2U * j + 1U] = outB[1];
+        }
+        p[2U * k]      = outA[0];
+        p[2U * k + 1U] = outA[1];
+     }
+
+     /* Complex IFFT process */
+     arm_cfft_q31 (S_CFFT, p, S->ifftFlagR, S->bitReverseFlagR);
+
+     arm_shift_q31(p, 1, p, S->fftLenReal);
+  }
+  else
+  {
+     /* Complex FFT process */
+     arm_cfft_q31 (S_CFFT, p, S->ifftFlagR, S->bitReverseFlagR);
+
+     /* DC and Nyquist, packed in the first complex number */
+     aR = p[0];
+     aI = p[1];
+     p[0] = (aR + aI) >> 1U;
+     p[1] = (aR - aI) >> 1U;
+
+     for (k = 1U; k <= L2 / 2U; k++)
+     {
+        j = L2 - k;
+        aR = p[2U * k];
+        aI = p[2U * k + 1U];
+        bR = p[2U * j];
+        bI = p[2U * j + 1U];
+
+        split_bin_q31(aR, aI, bR, bI, &pATable[2U * k * modifier], &pBTable[2U * k * modifier], outA);
+        if (j != k)
+        {
+           split_bin_q31(bR, bI, aR, aI, &pATable[2U * j * modifier], &pBTable[2U * j * modifier], outB);
+           p[2U * j]      = outB[0];
+           p[2U * j + 1U] = outB[1];
+        }
+        p[2U * k]      = outA[0];
+        p[2U * k + 1U] = outA[1];
+     }
+  }
+}
+
+/**
+  @} end of RealFFTQ31 group
+ */
+
+#endif /* !defined(ARM_MATH_NEON) || defined(ARM_MATH_AUTOVECTORIZE) */
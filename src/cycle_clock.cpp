@@ -0,0 +1,16 @@
+#include "cycle_clock.h"
+
+static cycle_clock_fn clock_now = 0;
+static uint32_t       clock_hz  = 1;
+
+void cycle_clock_set(cycle_clock_fn now, uint32_t hz) {
+    clock_now = now;
+    clock_hz  = hz ? hz : 1;
+}
+
+uint32_t cycle_clock_now() { return clock_now ? clock_now() : 0; }
+uint32_t cycle_clock_hz()  { return clock_hz; }
+
+uint32_t cycle_clock_to_us(uint32_t cycles) {
+    return (uint32_t)(((uint64_t)cycles * 1000000u) / clock_hz);
+}
@@ -0,0 +1,171 @@
+#include "deflog.h"
+
+#include <atomic>
+
+struct deflog_record {
+    uint8_t  fmt;
+    uint8_t  nargs;
+    uint16_t reserved;
+    uint32_t args[DEFLOG_MAX_ARGS];
+};
+
+static deflog_record records[DEFLOG_RECORDS];
+static std::atomic<uint32_t> rec_head(0);   // written by the producer
+static std::atomic<uint32_t> rec_tail(0);   // written by drain
+
+static char tx[DEFLOG_TX_BYTES];
+static std::atomic<uint32_t> tx_head(0);    // written by drain
+static std::atomic<uint32_t> tx_tail(0);    // written by the TX interrupt
+static std::atomic<bool> refill(false);
+
+static const char *const *fmt_table = 0;
+static int fmt_count = 0;
+static deflog_kick_fn kick_fn = 0;
+static deflog_stats stats;
+
+void deflog_init(const char *const *formats, int count) {
+    fmt_table = formats;
+    fmt_count = count;
+    rec_head = rec_tail = 0;
+    tx_head = tx_tail = 0;
+    memset(&stats, 0, sizeof(stats));
+}
+
+void deflog_set_kick(deflog_kick_fn kick) {
+    kick_fn = kick;
+}
+
+int deflog_pending() {
+    return (int)(rec_head.load(std::memory_order_acquire) -
+                 rec_tail.load(std::memory_order_acquire));
+}
+
+int deflog_space() {
+    return DEFLOG_RECORDS - deflog_pending();
+}
+
+bool deflog_write(uint8_t fmt, const uint32_t *args, int n) {
+    uint32_t h = rec_head.load(std::memory_order_relaxed);
+    uint32_t depth = h - rec_tail.load(std::memory_order_acquire);
+    if (depth >= DEFLOG_RECORDS) {
+        stats.dropped++;
+        return false;
+    }
+
+    deflog_record &r = records[h & (DEFLOG_RECORDS - 1)];
+    r.fmt = fmt;
+    r.nargs = (uint8_t)n;
+    for (int i=0; i < n; i++) r.args[i] = args[i];
+
+    rec_head.store(h + 1, std::memory_order_release);
+
+    stats.written++;
+    if (depth + 1 > stats.max_depth) stats.max_depth = depth + 1;
+    return true;
+}
+
+// ======= FORMATTING =======
+static char *put_uint(char *p, char *end, uint32_t v, int base, int width) {
+    char digits[12];
+    int n = 0;
+    do {
+        uint32_t d = v % base;
+        digits[n++] = (char)(d < 10 ? '0' + d : 'a' + d - 10);
+        v /= base;
+    } while (v && n < 12);
+    while (n < width && n < 12) digits[n++] = '0';
+    while (n && p < end) *p++ = digits[--n];
+    return p;
+}
+
+// Same output as the old print_float(): integer part, 3 decimals.
+static char *put_float(char *p, char *end, float v) {
+    if (v != v) {
+        for (const char *s = "nan"; *s && p < end; s++) *p++ = *s;
+        return p;
+    }
+    // unlike the old print_float, keeps the sign of -1 < v < 0
+    if (v < 0 && p < end) { *p++ = '-'; v = -v; }
+    if (v > 4.0e9f) v = 4.0e9f;
+    uint32_t ip = (uint32_t)v;
+    uint32_t fp = (uint32_t)((v - ip) * 1000);
+    p = put_uint(p, end, ip, 10, 0);
+    if (p < end) *p++ = '.';
+    return put_uint(p, end, fp, 10, 3);
+}
+
+static int format(const deflog_record &r, char *out, int cap) {
+    char *p = out, *end = out + cap;
+    const char *f = r.fmt < fmt_count ? fmt_table[r.fmt] : "?log\r\n";
+    int a = 0;
+
+    while (*f && p < end) {
+        if (*f != '%') { *p++ = *f++; continue; }
+        f++;
+
+        int width = 0;
+        while (*f >= '0' && *f <= '9') width = width * 10 + (*f++ - '0');
+
+        uint32_t v = a < r.nargs ? r.args[a] : 0;
+        switch (*f) {
+        case 'd':
+            if ((int32_t)v < 0 && p < end) { *p++ = '-'; v = 0u - v; }
+            p = put_uint(p, end, v, 10, width); a++; break;
+        case 'u': p = put_uint(p, end, v, 10, width); a++; break;
+        case 'x': p = put_uint(p, end, v, 16, width); a++; break;
+        case 'f': {
+            float fv;
+            memcpy(&fv, &v, 4);
+            p = put_float(p, end, fv); a++; break;
+        }
+        case '%': *p++ = '%'; break;
+        default:  if (*f) *p++ = *f; break;
+        }
+        if (*f) f++;
+    }
+    return (int)(p - out);
+}
+
+void deflog_drain() {
+    char line[160];
+    bool added = false;
+
+    while (deflog_pending() > 0) {
+        uint32_t t = rec_tail.load(std::memory_order_relaxed);
+        int n = format(records[t & (DEFLOG_RECORDS - 1)], line, sizeof(line));
+
+        uint32_t h = tx_head.load(std::memory_order_relaxed);
+        uint32_t used = h - tx_tail.load(std::memory_order_acquire);
+        if (DEFLOG_TX_BYTES - used < (uint32_t)n) break;   // retry later
+
+        for (int i=0; i < n; i++) tx[(h + i) & (DEFLOG_TX_BYTES - 1)] = line[i];
+        tx_head.store(h + n, std::memory_order_release);
+        rec_tail.store(t + 1, std::memory_order_release);
+        added = true;
+    }
+
+    if (added && kick_fn) kick_fn();
+}
+
+int deflog_tx_byte() {
+    uint32_t t = tx_tail.load(std::memory_order_relaxed);
+    uint32_t h = tx_head.load(std::memory_order_acquire);
+    if (t == h) return -1;
+
+    char c = tx[t & (DEFLOG_TX_BYTES - 1)];
+    tx_tail.store(t + 1, std::memory_order_release);
+    stats.tx_bytes++;
+
+    uint32_t left = h - (t + 1);
+    if ((left == DEFLOG_TX_BYTES / 4 || left == 0) && deflog_pending() > 0)
+        refill.store(true);
+    return (unsigned char)c;
+}
+
+bool deflog_refill_due() {
+    return refill.exchange(false);
+}
+
+const deflog_stats &deflog_get_stats() {
+    return stats;
+}
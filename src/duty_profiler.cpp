@@ -0,0 +1,45 @@
+#include "duty_profiler.h"
+#include "cycle_clock.h"
+
+#include <string.h>
+
+const char *const duty_names[DUTY_STAGES] = { "idle", "acq", "ana", "io" };
+
+static duty_report acc;
+static int      current;
+static uint32_t since;
+
+void duty_init() {
+    memset(&acc, 0, sizeof(acc));
+    current = DUTY_IDLE;
+    since   = cycle_clock_now();
+}
+
+void duty_switch(int stage) {
+    if (stage == current) return;
+
+    uint32_t now = cycle_clock_now();
+    acc.cycles[current] += now - since;
+    if (current == DUTY_IDLE) acc.wakes++;
+
+    current = stage;
+    since   = now;
+}
+
+void duty_take(duty_report &r) {
+    // charge the running stage up to now so the period is complete
+    uint32_t now = cycle_clock_now();
+    acc.cycles[current] += now - since;
+    since = now;
+
+    acc.period = 0;
+    for (int i=0; i < DUTY_STAGES; i++) acc.period += acc.cycles[i];
+
+    r = acc;
+    memset(&acc, 0, sizeof(acc));
+}
+
+uint32_t duty_permille(const duty_report &r, int stage) {
+    if (r.period == 0) return 0;
+    return (uint32_t)(((uint64_t)r.cycles[stage] * 1000u) / r.period);
+}
@@ -0,0 +1,124 @@
+#include "flight_recorder.h"
+
+#include <atomic>
+#include <string.h>
+
+static flight_block blocks[FR_BLOCKS];
+
+// Single-producer / single-consumer pointer rings. One slot is kept
+// empty, so each holds up to FR_BLOCKS entries.
+struct block_ring {
+    flight_block *slot[FR_BLOCKS + 1];
+    std::atomic<uint32_t> head;
+    std::atomic<uint32_t> tail;
+};
+
+static block_ring done;   // recorder -> consumer
+static block_ring spare;  // consumer -> recorder
+
+// The block being recorded has a pre-trigger ring in samples[0, FR_PRE)
+// and a linear post-trigger region in samples[FR_PRE, FR_LENGTH).
+static flight_block *rec;
+static uint32_t pre_idx;      // next write index in the pre ring
+static uint32_t pre_fill;     // valid samples in the pre ring
+static uint32_t post_left;    // > 0 while capturing after a trigger
+static uint32_t sample_count;
+static uint32_t next_seq;
+static flight_stats stats;
+
+static bool ring_put(block_ring &r, flight_block *b) {
+    uint32_t h = r.head.load(std::memory_order_relaxed);
+    uint32_t n = (h + 1) % (FR_BLOCKS + 1);
+    if (n == r.tail.load(std::memory_order_acquire)) return false;
+    r.slot[h] = b;
+    r.head.store(n, std::memory_order_release);
+    return true;
+}
+
+static flight_block *ring_get(block_ring &r) {
+    uint32_t t = r.tail.load(std::memory_order_relaxed);
+    if (t == r.head.load(std::memory_order_acquire)) return 0;
+    flight_block *b = r.slot[t];
+    r.tail.store((t + 1) % (FR_BLOCKS + 1), std::memory_order_release);
+    return b;
+}
+
+static void arm(flight_block *b) {
+    rec = b;
+    pre_idx = 0;
+    pre_fill = 0;
+    post_left = 0;
+}
+
+void flight_init() {
+    done.head = done.tail = 0;
+    spare.head = spare.tail = 0;
+    memset(&stats, 0, sizeof(stats));
+    sample_count = 0;
+    next_seq = 0;
+
+    arm(&blocks[0]);
+    for (int i=1; i < FR_BLOCKS; i++) ring_put(spare, &blocks[i]);
+}
+
+void flight_push(const int16_t raw[IMU_AXES]) {
+    sample_count++;
+    if (!rec) {
+        // every block is queued; take one back as soon as it is released
+        flight_block *b = ring_get(spare);
+        if (!b) return;
+        arm(b);
+    }
+
+    if (post_left == 0) {
+        memcpy(rec->samples[pre_idx], raw, sizeof(rec->samples[0]));
+        pre_idx = (pre_idx + 1) % FR_PRE;
+        if (pre_fill < FR_PRE) pre_fill++;
+        return;
+    }
+
+    memcpy(rec->samples[FR_PRE + rec->post], raw, sizeof(rec->samples[0]));
+    rec->post++;
+    if (--post_left == 0) {
+        stats.captured++;
+        ring_put(done, rec);   // cannot fail: at most FR_BLOCKS exist
+        rec = ring_get(spare);
+        if (rec) arm(rec);
+    }
+}
+
+void flight_trigger(uint32_t reason, uint32_t lag) {
+    if (!rec) { stats.dropped++; return; }
+
+    if (post_left > 0) {
+        rec->reason |= reason;
+        stats.merged++;
+        return;
+    }
+
+    rec->seq = next_seq++;
+    rec->trigger_sample = sample_count;
+    rec->reason = reason;
+    rec->lag = (uint16_t)lag;
+    rec->pre = (uint16_t)pre_fill;
+    rec->post = 0;
+    rec->start = (uint16_t)((pre_idx + FR_PRE - pre_fill) % FR_PRE);
+    post_left = FR_POST;
+}
+
+flight_block *flight_next() {
+    return ring_get(done);
+}
+
+void flight_release(flight_block *b) {
+    ring_put(spare, b);
+}
+
+const int16_t *flight_sample(const flight_block *b, int i) {
+    if (i < b->pre) return b->samples[(b->start + i) % FR_PRE];
+    return b->samples[FR_PRE + (i - b->pre)];
+}
+
+const flight_stats &flight_get_stats() {
+    return stats;
+}
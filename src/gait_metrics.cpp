@@ -0,0 +1,203 @@
+#include "gait_metrics.h"
+
+#include <math.h>
+#include "arm_math.h"
+#include "step_detector.h"
+
+// Step intervals in samples, and their sums over the ring. Parity is
+// that of the step's index in the stream; with an even ring the step
+// that leaves always has the parity of the one that enters.
+static uint16_t steps_ring[GAIT_STEPS];
+static uint32_t step_sum, parity_sum[2];
+static int step_n, step_head;
+static uint32_t step_index;
+
+static uint16_t stride_ring[GAIT_STRIDES];
+static uint32_t stride_sum, stride_sq;
+static int stride_n, stride_head;
+
+static uint32_t last_step;
+static bool have_step;
+static uint16_t prev_interval;
+
+// Gait band signal, written twice so the newest GAIT_ACF_LEN samples are
+// always contiguous at band + band_head.
+static float band[2 * GAIT_ACF_LEN];
+static int band_head, band_fill;
+static uint32_t sample_count;
+
+static gait_metrics cur;
+
+static gait_minute minute_acc;
+static gait_minute minutes[GAIT_MINUTES];
+static int min_head, min_tail;
+
+static void clear_bout() {
+    step_sum = parity_sum[0] = parity_sum[1] = 0;
+    step_n = step_head = 0;
+    stride_sum = stride_sq = 0;
+    stride_n = stride_head = 0;
+    prev_interval = 0;
+    cur.valid = false;
+}
+
+static void start_minute(uint32_t m) {
+    minute_acc = gait_minute();
+    minute_acc.minute = m;
+}
+
+void gait_init() {
+    clear_bout();
+    step_index = 0;
+    have_step = false;
+    band_head = band_fill = 0;
+    sample_count = 0;
+    cur = gait_metrics();
+    min_head = min_tail = 0;
+    start_minute(0);
+}
+
+static void close_minute() {
+    gait_minute &m = minute_acc;
+    if (m.scored) {
+        float inv = 1.0f / m.scored;
+        m.stride_s *= inv;
+        m.stride_cv *= inv;
+        m.asymmetry *= inv;
+        m.step_reg *= inv;
+        m.stride_reg *= inv;
+    }
+    int next = (min_head + 1) % GAIT_MINUTES;
+    if (next == min_tail) min_tail = (min_tail + 1) % GAIT_MINUTES;   // drop oldest
+    minutes[min_head] = m;
+    min_head = next;
+    start_minute(m.minute + 1);
+}
+
+void gait_samples(const float *x, int n) {
+    for (int i=0; i < n; i++) {
+        band[band_head] = band[band_head + GAIT_ACF_LEN] = x[i];
+        if (++band_head == GAIT_ACF_LEN) band_head = 0;
+        if (band_fill < GAIT_ACF_LEN) band_fill++;
+
+        if (++sample_count % (60u * STEP_RATE) == 0) close_minute();
+    }
+}
+
+// Unbiased autocorrelation at lag, normalised by lag 0.
+static float acf(const float *w, float energy, int lag) {
+    if (lag <= 0 || lag >= GAIT_ACF_LEN || energy <= 0.0f) return 0.0f;
+    float dot;
+    arm_dot_prod_f32(w, w + lag, GAIT_ACF_LEN - lag, &dot);
+    return (dot / (GAIT_ACF_LEN - lag)) / (energy / GAIT_ACF_LEN);
+}
+
+// Highest of lag - 1, lag, lag + 1.
+static float acf_peak(const float *w, float energy, int lag) {
+    float best = acf(w, energy, lag);
+    for (int d=-1; d <= 1; d += 2) {
+        float r = acf(w, energy, lag + d);
+        if (r > best) best = r;
+    }
+    return best;
+}
+
+static void score() {
+    if (step_n < GAIT_MIN_STEPS || stride_n < 2) {
+        cur.valid = false;
+        return;
+    }
+
+    float mean_step = (float)step_sum / step_n;
+    float mean_stride = (float)stride_sum / stride_n;
+    float var = ((float)stride_sq * stride_n - (float)stride_sum * stride_sum)
+              / ((float)stride_n * stride_n);
+
+    // the ring holds consecutive steps ending at step_index, so its
+    // parity class has the extra one when step_n is odd
+    int p = step_index & 1;
+    int n_same = (step_n + 1) / 2, n_other = step_n / 2;
+    float mean_same  = (float)parity_sum[p] / n_same;
+    float mean_other = (float)parity_sum[p ^ 1] / n_other;
+
+    cur.step_s = mean_step / STEP_RATE;
+    cur.stride_s = mean_stride / STEP_RATE;
+    cur.stride_cv = var > 0.0f ? sqrtf(var) / mean_stride : 0.0f;
+    cur.asymmetry = fabsf(mean_same - mean_other) / mean_step;
+
+    cur.step_reg = cur.stride_reg = 0;
+    if (band_fill == GAIT_ACF_LEN) {
+        const float *w = band + band_head;
+        float energy;
+        arm_dot_prod_f32(w, w, GAIT_ACF_LEN, &energy);
+        cur.step_reg   = acf_peak(w, energy, (int)lrintf(mean_step));
+        cur.stride_reg = acf_peak(w, energy, (int)lrintf(mean_stride));
+    }
+    cur.valid = true;
+}
+
+void gait_step(uint32_t t) {
+    minute_acc.steps++;
+
+    uint32_t interval = t - last_step;
+    bool first = !have_step;
+    have_step = true;
+    last_step = t;
+    if (first) return;
+
+    if (interval > STEP_MAX_GAP) {
+        clear_bout();
+        return;
+    }
+
+    // step ring
+    step_index++;
+    int p = step_index & 1;
+    if (step_n == GAIT_STEPS) {
+        step_sum -= steps_ring[step_head];
+        parity_sum[p] -= steps_ring[step_head];
+    } else {
+        step_n++;
+    }
+    steps_ring[step_head] = (uint16_t)interval;
+    step_sum += interval;
+    parity_sum[p] += interval;
+    step_head = (step_head + 1) % GAIT_STEPS;
+
+    // stride ring: this step and the one before
+    if (prev_interval) {
+        uint32_t stride = interval + prev_interval;
+        if (stride_n == GAIT_STRIDES) {
+            uint32_t old = stride_ring[stride_head];
+            stride_sum -= old;
+            stride_sq -= old * old;
+        } else {
+            stride_n++;
+        }
+        stride_ring[stride_head] = (uint16_t)stride;
+        stride_sum += stride;
+        stride_sq += stride * stride;
+        stride_head = (stride_head + 1) % GAIT_STRIDES;
+    }
+    prev_interval = (uint16_t)interval;
+
+    score();
+    if (cur.valid) {
+        gait_minute &m = minute_acc;
+        m.scored++;
+        m.stride_s   += cur.stride_s;
+        m.stride_cv  += cur.stride_cv;
+        m.asymmetry  += cur.asymmetry;
+        m.step_reg   += cur.step_reg;
+        m.stride_reg += cur.stride_reg;
+    }
+}
+
+void gait_get(gait_metrics &m) { m = cur; }
+
+bool gait_minute_take(gait_minute &m) {
+    if (min_tail == min_head) return false;
+    m = minutes[min_tail];
+    min_tail = (min_tail + 1) % GAIT_MINUTES;
+    return true;
+}
@@ -0,0 +1,87 @@
+#include "gyro_bias.h"
+
+#include <string.h>
+
+static void block_reset(gyro_bias &b) {
+    b.n = 0;
+    memset(b.sum, 0, sizeof(b.sum));
+    memset(b.sq, 0, sizeof(b.sq));
+}
+
+// n · Σx² − (Σx)² <= n² · (rms / scale)², all in LSB
+static int64_t variance_limit(float rms, float per_lsb) {
+    float lsb = rms / per_lsb;
+    return (int64_t)((float)GB_BLOCK * GB_BLOCK * lsb * lsb);
+}
+
+void gyro_bias_init(gyro_bias &b) {
+    memset(&b, 0, sizeof(b));
+    b.limit[0] = variance_limit(GB_ACCEL_STILL, ACCEL_G_PER_LSB);
+    b.limit[1] = variance_limit(GB_GYRO_STILL, GYRO_DPS_PER_LSB);
+    block_reset(b);
+}
+
+bool gyro_bias_push(gyro_bias &b, const int16_t raw[IMU_AXES]) {
+    for (int a=0; a < IMU_AXES; a++) {
+        int32_t v = raw[a];
+        b.sum[a] += v;
+        b.sq[a] += v * v;
+    }
+    if (++b.n < GB_BLOCK) return false;
+
+    b.blocks++;
+    bool still = true;
+    for (int a=0; a < IMU_AXES && still; a++) {
+        int64_t s = b.sum[a];
+        still = GB_BLOCK * b.sq[a] - s * s <= b.limit[a >= 3];
+    }
+    float mean[3];
+    for (int i=0; i < 3 && still; i++) {
+        mean[i] = b.sum[3 + i] * (GYRO_DPS_PER_LSB / GB_BLOCK);
+        still = mean[i] < GB_MAX_BIAS && mean[i] > -GB_MAX_BIAS;
+    }
+    block_reset(b);
+    if (!still) return false;
+
+    b.still_blocks++;
+    if (b.still < GB_SETTLE) b.still++;
+    float k = 1.0f / b.still;
+    for (int i=0; i < 3; i++) b.bias[i] += k * (mean[i] - b.bias[i]);
+    return true;
+}
+
+static uint32_t cal_check(const gyro_bias_cal &c) {
+    uint32_t h = c.magic ^ c.still;
+    for (int i=0; i < 3; i++) {
+        uint32_t u;
+        memcpy(&u, &c.bias[i], 4);
+        h = (h ^ u) * 16777619u;
+    }
+    return ~h;
+}
+
+void gyro_bias_save(const gyro_bias &b, gyro_bias_cal &c) {
+    c.magic = GB_CAL_MAGIC;
+    memcpy(c.bias, b.bias, sizeof(c.bias));
+    c.still = b.still;
+    c.check = cal_check(c);
+}
+
+bool gyro_bias_save_due(const gyro_bias &b, const gyro_bias_cal &saved) {
+    if (b.still < GB_SETTLE / 2) return false;
+    if (saved.magic != GB_CAL_MAGIC) return true;
+    for (int i=0; i < 3; i++) {
+        float d = b.bias[i] - saved.bias[i];
+        if (d > GB_SAVE_DPS || d < -GB_SAVE_DPS) return true;
+    }
+    return false;
+}
+
+bool gyro_bias_restore(gyro_bias &b, const gyro_bias_cal &c) {
+    if (c.magic != GB_CAL_MAGIC || c.check != cal_check(c)) return false;
+    for (int i=0; i < 3; i++)
+        if (!(c.bias[i] < GB_MAX_BIAS && c.bias[i] > -GB_MAX_BIAS)) return false;
+    memcpy(b.bias, c.bias, sizeof(b.bias));
+    b.still = c.still < GB_SETTLE / 2 ? c.still : GB_SETTLE / 2;
+    return true;
+}
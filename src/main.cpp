@@ -1,5 +1,21 @@
 #include "mbed.h"
 #include "arm_math.h"
+#include "detector.h"
+#include "wcet_monitor.h"
+#include "scheduler.h"
+#include "duty_profiler.h"
+#include "spectrogram.h"
+#include "imu.h"
+#include "flight_recorder.h"
+#include "deflog.h"
+#include "vote.h"
+#include "tremor_tracker.h"
+#include "step_detector.h"
+#include "gait_metrics.h"
+#include "board_graph.h"
+#include "symptom_summary.h"
+#include "packetizer.h"
+#include "gyro_bias.h"
 
 // ========= SERIAL ==========
 UnbufferedSerial pc(USBTX, USBRX, 115200);
@@ -15,11 +31,21 @@ I2C i2c(PB_11, PB_10);
 
 #define LSM6DSL_ADDR (0x6A << 1)
 
+#define FIFO_CTRL1  0x06
+#define FIFO_CTRL2  0x07
+#define FIFO_CTRL3  0x08
+#define FIFO_CTRL5  0x0A
+#define DRDY_PULSE_CFG_G 0x0B
+#define INT1_CTRL   0x0D
 #define WHO_AM_I    0x0F
 #define CTRL1_XL    0x10
 #define CTRL2_G     0x11
 #define CTRL3_C     0x12
 
+#define FIFO_STATUS1    0x3A
+#define FIFO_STATUS2    0x3B
+#define FIFO_DATA_OUT_L 0x3E
+
 #define OUTX_L_XL   0x28
 #define OUTY_L_XL   0x2A
 #define OUTZ_L_XL   0x2C
@@ -48,176 +74,664 @@ int16_t read_axis(uint8_t low_addr) {
     return (int16_t)((hi << 8) | lo);
 }
 
+// Samples the IMU batches per wake-up. 1 = one data-ready interrupt per
+// sample; larger values let the FIFO collect samples while the MCU sleeps.
+#define SAMPLES_PER_WAKE 13
+
+// Telemetry frames (telemetry.h) batched into radio packets. 0 leaves the
+// packetizer out; the board has no radio yet, so 1 only counts packets.
+#define TELEMETRY_PACKETS 0
+
+// 1 builds the analysis graph on the dual-resolution front end
+// (dual_graph, dual_front_end.h): a decision every 64 samples (1.23 s)
+// instead of every 3 s window, walk and fog updated every 9.8 s. It has
+// no detector spectra, so the spectral history and tremor tracker are
+// left out (no TREND / TRACK lines), and the worst-case dump holds only
+// the last 64-sample hop, which tools/replay cannot rerun. Downstream
+// counts decisions as windows: summary hours and telemetry hop numbers
+// assume 3 s, so an "hour" is ~25 min.
+#define DUAL_FRONT_END 0
+
+// Register writes of init_sensor(), in order, as a table in flash.
+struct reg_write { uint8_t reg, val; };
+
+// FIFO watermark counts 16-bit words, 6 per sample
+#define FIFO_THRESHOLD (SAMPLES_PER_WAKE * 6)
+
+const reg_write imu_setup[] = {
+    { CTRL3_C,  0x44 },     // BDU + auto-increment
+    { CTRL1_XL, 0x40 },     // ACCEL: 52 Hz, ±2g
+    { CTRL2_G,  0x40 },     // *** GYRO ON: 52 Hz, ±250 dps ***
+#if SAMPLES_PER_WAKE > 1
+    // FIFO: gyro + accel, no decimation, 52 Hz, continuous mode.
+    { FIFO_CTRL1, FIFO_THRESHOLD & 0xFF },
+    { FIFO_CTRL2, (FIFO_THRESHOLD >> 8) & 0x07 },
+    { FIFO_CTRL3, 0x09 },
+    { FIFO_CTRL5, 0x1E },
+    { INT1_CTRL,  0x08 },   // INT1 = FIFO threshold
+#else
+    { DRDY_PULSE_CFG_G, 0x80 },   // pulsed DRDY, no missed edges
+    { INT1_CTRL, 0x01 },          // INT1 = accel data-ready
+#endif
+};
+
 bool init_sensor() {
     uint8_t who;
     read_reg(WHO_AM_I, who);
     if (who != 0x6A) return false;
 
-    write_reg(CTRL3_C, 0x44);  // BDU + auto-increment
-    write_reg(CTRL1_XL, 0x40); // ACCEL: 52 Hz, ±2g
-    write_reg(CTRL2_G,  0x40); // *** GYRO ON: 52 Hz, ±250 dps ***
+    for (unsigned i=0; i < sizeof(imu_setup) / sizeof(imu_setup[0]); i++)
+        write_reg(imu_setup[i].reg, imu_setup[i].val);
     return true;
 }
 
-// ========= FFT PARAMETERS =========
-#define SAMPLE_RATE 52
-#define WINDOW_SEC  3
-#define RAW_SAMPLES (SAMPLE_RATE * WINDOW_SEC)  // 156
-#define FFT_SIZE    256
+// Reads one 6-axis sample: accel x,y,z then gyro x,y,z.
+void read_sample(int16_t raw[IMU_AXES]) {
+#if SAMPLES_PER_WAKE > 1
+    // FIFO pattern with equal decimation is gyro first, then accel
+    for (int i=0; i < 3; i++) raw[3 + i] = read_axis(FIFO_DATA_OUT_L);
+    for (int i=0; i < 3; i++) raw[i]     = read_axis(FIFO_DATA_OUT_L);
+#else
+    raw[0] = read_axis(OUTX_L_XL);
+    raw[1] = read_axis(OUTY_L_XL);
+    raw[2] = read_axis(OUTZ_L_XL);
+    raw[3] = read_axis(OUTX_L_G);
+    raw[4] = read_axis(OUTY_L_G);
+    raw[5] = read_axis(OUTZ_L_G);
+#endif
+}
+
+// Number of complete samples waiting. Sets overrun if the FIFO
+// wrapped and older samples were lost.
+int samples_ready(bool &overrun) {
+#if SAMPLES_PER_WAKE > 1
+    uint8_t lo = 0, hi = 0;
+    read_reg(FIFO_STATUS1, lo);
+    read_reg(FIFO_STATUS2, hi);
+    overrun = (hi & 0x40) != 0;
+    return (((hi & 0x07) << 8) | lo) / 6;
+#else
+    overrun = false;
+    return 1;
+#endif
+}
 
-float accel_buf[RAW_SAMPLES];
-float gyro_buf[RAW_SAMPLES];
+// ========= ANALYSIS GRAPH =========
+// magnitudes -> detector -> vote; buffers sized at compile time
+#if DUAL_FRONT_END
+typedef dual_graph analysis_graph;
+#else
+typedef board_graph analysis_graph;
+#endif
+analysis_graph graph;
 
-int buf_idx = 0;
+// samples per analysis hop
+const int HOP_SAMPLES = analysis_graph::input_tokens;
 
-float fft_in[FFT_SIZE];
-float fft_out[FFT_SIZE];
-float fft_mag[FFT_SIZE/2];
+#if !DUAL_FRONT_END
+board_history history;
 
-arm_rfft_fast_instance_f32 rfft;
+// tremor frequency / amplitude, read off the detector's gyro spectrum
+TremorTracker<board_detector> tracker;
 
-volatile bool sample_flag = false;
+board_sink spectra = { &history, &tracker };
+#endif
 
-void tick_isr() { sample_flag = true; }
+// per-hour counters and histograms, exported instead of every window
+symptom_summary summary;
 
-// ========= SAFE FLOAT PRINT =========
-void print_float(const char *label, float v) {
-    int ip = (int)v;
-    int fp = (int)((v - ip) * 1000);
-    if (fp < 0) fp = -fp;
-    printf("%s%d.%03d", label, ip, fp);
+// ========= EVENTS =========
+InterruptIn imu_int1(PD_11);
+
+volatile uint32_t irq_count = 0;
+volatile char rx_char = 0;
+
+void imu_isr() { irq_count++; sched_post(EVT_SENSOR); }
+
+void serial_isr() {
+    char c;
+    if (pc.read(&c, 1) == 1) {
+        rx_char = c;
+        sched_post(EVT_SERIAL);
+    }
 }
 
-// ========= MAIN =========
-int main() {
+// Sleep until the next interrupt. The pending check is repeated with
+// interrupts masked so a post between sched_wait() and here still wakes us.
+void idle_sleep() {
+    core_util_critical_section_enter();
+    if (!sched_pending()) sleep();
+    core_util_critical_section_exit();
+}
 
-    printf("Parkinson Real FFT Detector (Option C)\r\n");
+// ========= TIMING =========
+wcet_stage acq_stage;
+wcet_stage ana_stage;
 
-    if (!init_sensor()) {
-        printf("IMU init failed!\r\n");
-        while (1);
+float wc_accel[HOP_SAMPLES];
+float wc_gyro[HOP_SAMPLES];
+wcet_capture worst_window = { 0, HOP_SAMPLES, wc_accel, wc_gyro };
+
+uint32_t dwt_cycles() { return DWT->CYCCNT; }
+
+void init_cycle_clock() {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    cycle_clock_set(&dwt_cycles, SystemCoreClock);
+}
+
+// ========= LOG FORMATS =========
+// Records carry only the id; the text is produced in idle time.
+enum {
+    LOG_RESULT,
+    LOG_FLAGS,
+    LOG_TREND,
+    LOG_TRACK,
+    LOG_STEP,
+    LOG_GAIT,
+    LOG_GAITQ,
+    LOG_SCORE,
+    LOG_VOTE,
+    LOG_WCET,
+    LOG_DUTY,
+    LOG_STATS,
+    LOG_WC_BEGIN,
+    LOG_WC_LINE,
+    LOG_WC_END,
+    LOG_FR_BEGIN,
+    LOG_FR_LINE,
+    LOG_FR_END,
+    LOG_BOOT,
+    LOG_HOUR,
+    LOG_HIST,
+    LOG_RADIO,
+    LOG_GBIAS,
+    LOG_COUNT
+};
+
+const char *const log_formats[LOG_COUNT] = {
+    "Tremor=%f  Dysk=%f  FogRatio=%f  Walk=%f  \r\n",
+    "Freeze=%d  Is tremor?=%d  Is dysk?=%d\r\n",
+    "TREND persist=%f  drift=%fHz/s  onset=%f/hop\r\n",
+    "TRACK lock=%d f=%fHz drift=%fHz/s amp=%f\r\n",
+    "STEP t=%ums\r\n",
+    "GAIT steps=%u bout=%u cadence=%f/min intent=%fg stopped=%d hint=%d\r\n",
+    "GAITQ min=%u steps=%u stride=%fs cv=%f asym=%f reg=%f/%f\r\n",
+    "SCORE %d %d %d %d\r\n",
+    "VOTE %d %d %d %d %x\r\n",
+    "WCET acq=%u/%uus miss=%u drop=%u  ana=%u/%uus miss=%u\r\n",
+    "DUTY idle=%f%%  acq=%f%%  ana=%f%%  io=%f%%  wakes=%u\r\n",
+    "LOG written=%u dropped=%u depth=%u\r\n",
+    "WCDUMP BEGIN %u %u %u\r\n",
+    "%08x %08x\r\n",
+    "WCDUMP END\r\n",
+    "FRDUMP BEGIN %u %u %u %u %u %u\r\n",
+    "%04x %04x %04x %04x %04x %04x\r\n",
+    "FRDUMP END\r\n",
+    "BOOT ready=%uus first_sample=%uus first_decision=%ums\r\n",
+    "HOUR %u win=%u on=%u/%u/%u/%u ep=%08x\r\n",
+    "HIST %08x %08x %08x %08x\r\n",
+    "RADIO packets=%u bytes=%u frames=%u full=%u due=%u urgent=%u dropped=%u\r\n",
+    "GBIAS %f %f %f still=%u/%u saved=%d\r\n",
+};
+
+// ========= UART TX =========
+// The TX interrupt is attached only while deflog has bytes to send.
+volatile bool tx_active = false;
+
+void tx_isr() {
+    int c = deflog_tx_byte();
+    if (c < 0) {
+        pc.attach(nullptr, SerialBase::TxIrq);
+        tx_active = false;
+    } else {
+        char ch = (char)c;
+        pc.write(&ch, 1);
     }
+    if (deflog_refill_due()) sched_post(EVT_LOG);
+}
 
-    arm_rfft_fast_init_f32(&rfft, FFT_SIZE);
+void tx_kick() {
+    core_util_critical_section_enter();
+    if (!tx_active) {
+        tx_active = true;
+        pc.attach(&tx_isr, SerialBase::TxIrq);
+    }
+    core_util_critical_section_exit();
+}
 
-    Ticker tick;
-    tick.attach(&tick_isr, 1.0f / SAMPLE_RATE);
+// ========= RADIO =========
+// Window results and instrumentation are routine and go out batched
+// every RADIO_FLUSH_MS; episode changes are urgent and go at the next
+// wake-up, taking any routine frames along.
+#if TELEMETRY_PACKETS
+#define RADIO_MTU       244     // BLE data length extension, one notification
+#define RADIO_FLUSH_MS  30000
+
+packetizer radio;
+uint32_t radio_ms = 0;          // from samples read: the IMU clock runs through sleep
+uint32_t radio_shown = 0;       // symptoms shown in the last TM_EPISODE
+
+// No radio driver yet: this is where a packet becomes a BLE notification
+// or an uplink. Packets and bytes are counted in radio.st.
+bool radio_send(void *, const uint8_t *, size_t) { return true; }
+
+void radio_init() {
+    pk_config cfg = { RADIO_MTU, RADIO_FLUSH_MS, 0 };
+    pk_init(radio, cfg, HAL_GetUIDw0() ^ HAL_GetUIDw1() ^ HAL_GetUIDw2(), &radio_send, 0);
+}
 
-    Timer timer;
-    timer.start();
+void radio_hop(uint32_t hop, const detector_result &r, uint32_t shown) {
+    tm_window w = tm_window_from(hop, r, shown);
+    pk_put(radio, PK_ROUTINE, TM_WINDOW, &w, sizeof(w), radio_ms);
+    if (shown != radio_shown) {
+        tm_episode e = { hop, shown & ~radio_shown, radio_shown & ~shown, shown };
+        pk_put(radio, PK_URGENT, TM_EPISODE, &e, sizeof(e), radio_ms);
+        radio_shown = shown;
+    }
+}
+#endif
+
+// A record for the UART log and, with TELEMETRY_PACKETS, the radio.
+template <class... T>
+void log_record(uint8_t fmt, T... args) {
+    deflog(fmt, args...);
+#if TELEMETRY_PACKETS
+    static_assert(sizeof...(T) <= TM_LOG_MAX_ARGS, "too many log arguments");
+    tm_log l = { fmt, { deflog_arg(args)... } };
+    pk_put(radio, PK_ROUTINE, TM_LOG, &l, 4 + 4 * sizeof...(T), radio_ms);
+#endif
+}
 
-    while (true) {
+void log_stages() {
+    log_record(LOG_WCET,
+           cycle_clock_to_us(acq_stage.last), cycle_clock_to_us(acq_stage.worst),
+           acq_stage.misses, acq_stage.dropped,
+           cycle_clock_to_us(ana_stage.last), cycle_clock_to_us(ana_stage.worst),
+           ana_stage.misses);
+}
 
-        // ======= SAMPLE DATA ========
-        if (sample_flag) {
-            sample_flag = false;
-
-            // --- ACCEL ---
-            int16_t x = read_axis(OUTX_L_XL);
-            int16_t y = read_axis(OUTY_L_XL);
-            int16_t z = read_axis(OUTZ_L_XL);
-            float ax = x * 0.000061f;
-            float ay = y * 0.000061f;
-            float az = z * 0.000061f;
-            float amag = sqrtf(ax*ax + ay*ay + az*az);
-
-            // --- GYRO (OPTION C — MAIN FOR TREMOR/DYSK) ---
-            int16_t gx = read_axis(OUTX_L_G);
-            int16_t gy = read_axis(OUTY_L_G);
-            int16_t gz = read_axis(OUTZ_L_G);
-            float fgx = gx * 0.00875f;  // ±250 dps scale
-            float fgy = gy * 0.00875f;
-            float fgz = gz * 0.00875f;
-            float gmag = sqrtf(fgx*fgx + fgy*fgy + fgz*fgz);
-
-            accel_buf[buf_idx] = amag;
-            gyro_buf[buf_idx]  = gmag;
-            buf_idx++;
-            if (buf_idx >= RAW_SAMPLES) buf_idx = 0;
-        }
+void log_duty() {
+    duty_report d;
+    duty_take(d);
+    log_record(LOG_DUTY,
+           duty_permille(d, DUTY_IDLE) / 10.0f, duty_permille(d, DUTY_ACQ) / 10.0f,
+           duty_permille(d, DUTY_ANA) / 10.0f,  duty_permille(d, DUTY_IO) / 10.0f,
+           d.wakes);
+}
+
+void log_stats() {
+    const deflog_stats &st = deflog_get_stats();
+    deflog(LOG_STATS, st.written, st.dropped, st.max_depth);
+#if TELEMETRY_PACKETS
+    const pk_stats &rs = radio.st;
+    deflog(LOG_RADIO, rs.packets, rs.sent_bytes, rs.frames, rs.full, rs.due, rs.urgent,
+           rs.dropped[PK_ROUTINE] + rs.dropped[PK_URGENT]);
+#endif
+}
 
-        // ======= PROCESS EVERY 3 SECONDS ========
-        if (timer.elapsed_time().count() >= WINDOW_SEC * 1000000) {
-            timer.reset();
+// ========= GYRO CALIBRATION =========
+// The zero-rate bias estimate (gyro_bias.h) is kept in the last flash
+// sector, so a restart begins calibrated. It is rewritten in idle time
+// when it moved GB_SAVE_DPS, at most once an hour: an erase takes about
+// 25 ms (the IMU FIFO covers it) and the sector is good for 10k erases.
+#define CAL_SAVE_HOPS   (3600 * board_detector::sample_rate / HOP_SAMPLES)
+
+FlashIAP flash;
+uint32_t cal_addr = 0;
+gyro_bias_cal cal_saved;        // magic 0: nothing saved
+uint32_t cal_hops = CAL_SAVE_HOPS;
+bool cal_due = false;
+
+gyro_bias &gyro_cal() { return graph.node<NODE_MAGNITUDE>().bias; }
+
+// saved=1: the estimate is the one in flash
+void log_gyro_bias() {
+    const gyro_bias &b = gyro_cal();
+    bool saved = cal_saved.magic == GB_CAL_MAGIC && !memcmp(cal_saved.bias, b.bias, sizeof(b.bias));
+    deflog(LOG_GBIAS, b.bias[0], b.bias[1], b.bias[2], b.still_blocks, b.blocks, (int)saved);
+}
 
-            // ======= ACCEL FFT FOR WALK + FREEZE =======
-            float mean = 0;
-            for (int i=0; i < RAW_SAMPLES; i++) mean += accel_buf[i];
-            mean /= RAW_SAMPLES;
+void cal_load() {
+    memset(&cal_saved, 0, sizeof(cal_saved));
+    if (flash.init() != 0) return;
+    uint32_t end = flash.get_flash_start() + flash.get_flash_size();
+    cal_addr = end - flash.get_sector_size(end - 1);
+    gyro_bias_cal c;
+    if (flash.read(&c, cal_addr, sizeof(c)) == 0 && gyro_bias_restore(gyro_cal(), c))
+        cal_saved = c;
+}
 
-            for (int i=0; i < RAW_SAMPLES; i++)
-                fft_in[i] = accel_buf[i] - mean;
-            for (int i=RAW_SAMPLES; i < FFT_SIZE; i++)
-                fft_in[i] = 0.0f;
+// idle-time work; a failed write is tried again an hour later
+void cal_store() {
+    cal_due = false;
+    cal_hops = 0;
+    if (!cal_addr) return;
+    uint8_t page[32];
+    uint32_t n = (sizeof(gyro_bias_cal) + flash.get_page_size() - 1) / flash.get_page_size()
+               * flash.get_page_size();
+    if (n > sizeof(page)) return;
+    gyro_bias_cal c;
+    gyro_bias_save(gyro_cal(), c);
+    memset(page, 0xFF, sizeof(page));
+    memcpy(page, &c, sizeof(c));
+    if (flash.erase(cal_addr, flash.get_sector_size(cal_addr)) != 0) return;
+    if (flash.program(page, cal_addr, n) != 0) return;
+    cal_saved = c;
+    log_gyro_bias();
+}
 
-            arm_rfft_fast_f32(&rfft, fft_in, fft_out, 0);
-            arm_cmplx_mag_f32(fft_out, fft_mag, FFT_SIZE/2);
+// ========= BULK DUMPS =========
+// Worst-case window and flight-recorder captures go out a few lines at a
+// time, only while the log ring has room to spare, so they never push
+// out the per-hop records.
+#define DUMP_RESERVE 12
 
-            float hz_per_bin = (float)SAMPLE_RATE / FFT_SIZE;
+// Raw float bits so tools/replay reruns the exact window.
+int wc_sent = -1;            // -1: no dump in progress
 
-            float walk = 0, fog = 0;
-            for (int k=1; k < FFT_SIZE/2; k++) {
-                float f = k * hz_per_bin;
-                if (f >= 0.5f && f <= 3.0f) walk += fft_mag[k];
-                if (f > 3.0f && f <= 8.0f)  fog  += fft_mag[k];
-            }
+void drain_worst_window() {
+    const wcet_capture &c = worst_window;
+    if (wc_sent == 0) {
+        if (deflog_space() <= DUMP_RESERVE) return;
+        deflog(LOG_WC_BEGIN, c.length, c.cycles, cycle_clock_hz());
+    }
+    while (wc_sent < (int)c.length && deflog_space() > DUMP_RESERVE) {
+        uint32_t a, g;
+        memcpy(&a, &c.accel[wc_sent], 4);
+        memcpy(&g, &c.gyro[wc_sent], 4);
+        deflog(LOG_WC_LINE, a, g);
+        wc_sent++;
+    }
+    if (wc_sent == (int)c.length && deflog_space() > DUMP_RESERVE) {
+        deflog(LOG_WC_END);
+        wc_sent = -1;
+    }
+}
 
-            // ======= GYRO FFT FOR TREMOR + DYSK =======
-            mean = 0;
-            for (int i=0; i < RAW_SAMPLES; i++) mean += gyro_buf[i];
-            mean /= RAW_SAMPLES;
+flight_block *fr_out = 0;
+int fr_sent = 0;
+
+void drain_flight() {
+    if (!fr_out) {
+        if (deflog_space() <= DUMP_RESERVE) return;
+        fr_out = flight_next();
+        if (!fr_out) return;
+        fr_sent = 0;
+        log_gyro_bias();   // tools/replay takes it off the capture's gyro
+        deflog(LOG_FR_BEGIN, fr_out->seq, fr_out->reason, fr_out->trigger_sample,
+               (unsigned)fr_out->pre, (unsigned)fr_out->post, (unsigned)fr_out->lag);
+    }
 
-            for (int i=0; i < RAW_SAMPLES; i++)
-                fft_in[i] = gyro_buf[i] - mean;
-            for (int i=RAW_SAMPLES; i < FFT_SIZE; i++)
-                fft_in[i] = 0.0f;
+    int total = fr_out->pre + fr_out->post;
+    while (fr_sent < total && deflog_space() > DUMP_RESERVE) {
+        const int16_t *s = flight_sample(fr_out, fr_sent);
+        deflog(LOG_FR_LINE,
+               (unsigned)(uint16_t)s[0], (unsigned)(uint16_t)s[1], (unsigned)(uint16_t)s[2],
+               (unsigned)(uint16_t)s[3], (unsigned)(uint16_t)s[4], (unsigned)(uint16_t)s[5]);
+        fr_sent++;
+    }
 
-            arm_rfft_fast_f32(&rfft, fft_in, fft_out, 0);
-            arm_cmplx_mag_f32(fft_out, fft_mag, FFT_SIZE/2);
+    if (fr_sent == total && deflog_space() > DUMP_RESERVE) {
+        deflog(LOG_FR_END);
+        flight_release(fr_out);
+        fr_out = 0;
+    }
+}
 
-            float tremor = 0, dysk = 0;
-            for (int k=1; k < FFT_SIZE/2; k++) {
-                float f = k * hz_per_bin;
-                if (f >= 3.0f && f <= 5.0f) tremor += fft_mag[k];
-                if (f > 5.0f && f <= 7.0f)  dysk   += fft_mag[k];
-            }
+// ========= HOURLY SUMMARY =========
+// A closed hour as two lines: counters, then the histogram bytes in
+// record order (tremor, dysk, frequency), four per word, first byte lowest.
+void log_hours() {
+    summary_hour h;
+    while (summary_take(summary, h)) {
+        uint32_t w[4];
+        memcpy(w, h.tremor_hist, sizeof(w));
+        deflog(LOG_HOUR, h.hour, h.windows, h.on[SYM_TREMOR], h.on[SYM_DYSK],
+               h.on[SYM_FREEZE], h.on[SYM_TREMOR_PRESENT],
+               (uint32_t)h.episodes[0] | h.episodes[1] << 8 | h.episodes[2] << 16
+               | (uint32_t)h.episodes[3] << 24);
+        deflog(LOG_HIST, w[0], w[1], w[2], w[3]);
+#if TELEMETRY_PACKETS
+        pk_put(radio, PK_ROUTINE, TM_HOUR, &h, sizeof(h), radio_ms);
+#endif
+    }
+}
+
+// ========= BOOT TIMING =========
+// Cycle counts since the counter was started at the top of main(); the
+// startup code before main() is not included. Logged once, with the
+// first decision.
+uint32_t boot_ready = 0;          // set-up done, waiting for the IMU
+uint32_t boot_first_sample = 0;   // first sample read
+bool boot_logged = false;
+
+void log_boot(uint32_t first_decision) {
+    deflog(LOG_BOOT, cycle_clock_to_us(boot_ready), cycle_clock_to_us(boot_first_sample),
+           cycle_clock_to_us(first_decision) / 1000u);
+    boot_logged = true;
+}
 
-            float fog_ratio = fog / (walk + 0.0001f);
+// ========= MAIN =========
+int main() {
 
-            // ======= LOGIC =======
-            bool tremor_present = tremor > 5.0f;
-            bool dysk_present   = dysk   > 5.0f;
-            bool low_walk       = walk < 5.0f;
+    // first, so boot timing starts here
+    init_cycle_clock();
 
-            bool freezing = false;
-            if (fog_ratio > 3.0f && low_walk && !dysk_present)
-                freezing = true;
+    printf("Parkinson Real FFT Detector (Option C)\r\n");
 
-            led_tremor = 0;
-            led_dysk = 0;
-            led_freeze = 0;
+    if (!init_sensor()) {
+        printf("IMU init failed!\r\n");
+        while (1);
+    }
 
-            if (freezing) {
-                led_freeze = 1;
-                if (tremor_present) led_tremor = 1;
+    board_graph_init(graph);
+    auto &det = graph.node<NODE_DETECTOR>();
+#if !DUAL_FRONT_END
+    det.sink = &spectra;
+    tracker.init();
+#endif
+    cal_load();
+    summary_init(summary);
+#if TELEMETRY_PACKETS
+    radio_init();
+#endif
+    step_init();
+    gait_init();
+
+    // both stages must finish before the next IMU wake-up is due
+    uint32_t wake_budget = SystemCoreClock / board_detector::sample_rate * SAMPLES_PER_WAKE;
+    wcet_stage_init(acq_stage, "acq", wake_budget);
+    wcet_stage_init(ana_stage, "ana", wake_budget);
+    uint32_t irqs_seen = 0;
+
+    flight_init();
+    uint32_t episodes = 0;   // FR_* bits active after the previous hop
+    int since_window = 0;    // samples read after the last full window
+    uint32_t hops = 0;       // analysis windows since boot
+    uint32_t samples_read = 0;
+
+    // console printf is only used above; from here on all output is deferred
+    deflog_init(log_formats, LOG_COUNT);
+    deflog_set_kick(&tx_kick);
+    log_gyro_bias();
+
+    duty_init();
+    sched_set_idle(&idle_sleep);
+    pc.attach(&serial_isr, SerialBase::RxIrq);
+    imu_int1.rise(&imu_isr);
+
+    // drain anything latched before the edge handler was attached
+    sched_post(EVT_SENSOR);
+    boot_ready = cycle_clock_now();
+
+    while (true) {
+
+        // ======= LOG OUTPUT (IDLE-TIME WORK) ========
+        duty_switch(DUTY_IO);
+        if (cal_due) cal_store();
+        if (wc_sent >= 0) drain_worst_window();
+        drain_flight();
+        deflog_drain();
+#if TELEMETRY_PACKETS
+        pk_poll(radio, radio_ms);
+#endif
+
+        duty_switch(DUTY_IDLE);
+        uint32_t ev = sched_wait();
+
+        // ======= SAMPLE DATA ========
+        if (ev & EVT_SENSOR) {
+            duty_switch(DUTY_ACQ);
+
+#if SAMPLES_PER_WAKE == 1
+            // interrupts that fired while we were busy were never sampled
+            uint32_t irqs = irq_count;
+            if (irqs - irqs_seen > 1)
+                wcet_note_dropped(acq_stage, irqs - irqs_seen - 1);
+            irqs_seen = irqs;
+#else
+            (void)irqs_seen;
+#endif
+
+            wcet_begin(acq_stage);
+
+            bool overrun;
+            int n = samples_ready(overrun);
+            if (overrun) wcet_note_dropped(acq_stage, 1);
+            if (n > 0 && !boot_first_sample) boot_first_sample = cycle_clock_now();
+
+            float step_in[STEP_BLOCK], step_band[STEP_BLOCK];
+            int step_n = 0;
+            bool hint_was = step_freeze_hint();
+
+            for (int i=0; i < n; i++) {
+                int16_t raw[IMU_AXES];
+                read_sample(raw);
+                flight_push(raw);
+                since_window++;
+                samples_read++;
+
+                imu_sample in;
+                memcpy(in.raw, raw, sizeof(in.raw));
+                if (!graph.push(in)) wcet_note_dropped(ana_stage, 1);
+
+                // steps need the accel magnitude now, not at the window:
+                // the graph's magnitude node has just made it
+                step_in[step_n++] = graph.head_output().accel;
+                if (step_n == STEP_BLOCK) {
+                    step_push(step_in, step_n, step_band);
+                    gait_samples(step_band, step_n);
+                    step_n = 0;
+                }
+
+                // ======= PROCESS EVERY HOP (3 s; 1.23 s dual) ========
+                if (graph.buffered() == HOP_SAMPLES) {
+                    since_window = 0;
+                    sched_post(EVT_ANALYZE);
+                }
             }
-            else {
-                if (low_walk && tremor_present && tremor > dysk * 1.2f)
-                    led_tremor = 1;
 
-                if (low_walk && dysk_present && dysk > tremor * 1.2f)
-                    led_dysk = 1;
+            // steps as they happen; a stopped walk with trembling
+            // lights the freeze LED without waiting for the window
+            if (step_n) {
+                step_push(step_in, step_n, step_band);
+                gait_samples(step_band, step_n);
             }
+            uint32_t step_t[4];
+            int steps = step_take(step_t, 4);
+            for (int i=0; i < steps; i++) {
+                gait_step(step_t[i]);
+                deflog(LOG_STEP, (uint32_t)((uint64_t)step_t[i] * 1000u / STEP_RATE));
+            }
+            if (step_freeze_hint() && !hint_was) led_freeze = 1;
+
+#if TELEMETRY_PACKETS
+            radio_ms = (uint32_t)((uint64_t)samples_read * 1000u / board_detector::sample_rate);
+#endif
+            wcet_end(acq_stage);
+        }
 
-            // ======= PRINT OUTPUT =======
-            print_float("Tremor=", tremor); printf("  ");
-            print_float("Dysk=", dysk);     printf("  ");
-            print_float("FogRatio=", fog_ratio); printf("  ");
-            print_float("Walk=", walk);     printf("  \r\n");
+        // ======= SERIAL COMMANDS ========
+        if (ev & EVT_SERIAL) {
+            duty_switch(DUTY_IO);
+            if (rx_char == 'd' && wc_sent < 0) wc_sent = 0;
+        }
 
-            printf("Freeze=%d  ", freezing);
-            printf("Is tremor?=%d  ", (low_walk && tremor_present && tremor > dysk * 1.2f));
-            printf("Is dysk?=%d\r\n", (low_walk && dysk_present && dysk > tremor * 1.2f));
+        if (ev & EVT_ANALYZE) {
+            duty_switch(DUTY_ANA);
+            wcet_begin(ana_stage);
+
+            const board_decision &d = *graph.run();
+            const detector_result &r = d.r;
+
+            if (wcet_end(ana_stage))
+                wcet_capture_store(worst_window, ana_stage.worst,
+                                   det.accel, det.gyro);
+
+            float tremor = r.tremor, dysk = r.dysk;
+            float walk = r.walk, fog_ratio = r.fog_ratio;
+            bool freezing = (d.active & (1u << SYM_FREEZE)) || step_freeze_hint();
+
+            // Freeze dominates; tremor is allowed during a freeze,
+            // dyskinesia is not.
+            bool show_tremor = freezing ? d.active & (1u << SYM_TREMOR_PRESENT)
+                                        : d.active & (1u << SYM_TREMOR);
+            bool show_dysk   = freezing ? false : d.active & (1u << SYM_DYSK);
+
+            led_tremor = show_tremor;
+            led_dysk   = show_dysk;
+            led_freeze = freezing;
+
+            // capture raw data around each episode onset
+            uint32_t now = (show_tremor ? FR_TREMOR : 0)
+                         | (show_dysk   ? FR_DYSK   : 0)
+                         | (freezing    ? FR_FREEZE : 0);
+            if (now & ~episodes) flight_trigger(now & ~episodes, since_window);
+            episodes = now;
+
+            uint32_t shown = (d.active & ~(1u << SYM_FREEZE)) | (freezing ? 1u << SYM_FREEZE : 0);
+#if DUAL_FRONT_END
+            summary_window(summary, r, shown, 0.0f);
+#else
+            summary_window(summary, r, shown, tracker.locked() ? tracker.frequency() : 0.0f);
+#endif
+#if TELEMETRY_PACKETS
+            radio_hop(hops, r, shown);
+#endif
+            hops++;
+
+            // ======= LOG OUTPUT =======
+            deflog(LOG_RESULT, tremor, dysk, fog_ratio, walk);
+            deflog(LOG_FLAGS, (int)r.freezing, (int)r.is_tremor, (int)r.is_dysk);
+            deflog(LOG_SCORE, r.score[SYM_TREMOR], r.score[SYM_DYSK],
+                   r.score[SYM_FREEZE], r.score[SYM_TREMOR_PRESENT]);
+            deflog(LOG_VOTE, d.conf[SYM_TREMOR], d.conf[SYM_DYSK],
+                   d.conf[SYM_FREEZE], d.conf[SYM_TREMOR_PRESENT], d.active);
+#if !DUAL_FRONT_END
+            deflog(LOG_TREND, history.tremor.persistence(),
+                   history.drift_hz_per_s(), history.tremor.onset_slope());
+#endif
+            step_status gait;
+            step_get_status(gait);
+            deflog(LOG_GAIT, gait.steps, gait.bout, gait.cadence, gait.intent_g,
+                   (int)gait.stopped, (int)gait.freeze_hint);
+            gait_minute gm;
+            while (gait_minute_take(gm))
+                deflog(LOG_GAITQ, gm.minute, gm.steps, gm.stride_s, gm.stride_cv,
+                       gm.asymmetry, gm.step_reg, gm.stride_reg);
+#if !DUAL_FRONT_END
+            deflog(LOG_TRACK, (int)tracker.locked(), tracker.frequency(),
+                   tracker.drift_hz_per_s(), tracker.amplitude());
+#endif
+            log_hours();
+            if (++cal_hops >= CAL_SAVE_HOPS && gyro_bias_save_due(gyro_cal(), cal_saved))
+                cal_due = true;
+            log_stages();
+            log_duty();
+            log_stats();
+            if (!boot_logged) log_boot(cycle_clock_now());
         }
     }
 }
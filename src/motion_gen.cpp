@@ -0,0 +1,230 @@
+#include "motion_gen.h"
+
+#include <math.h>
+#include "arm_math.h"
+
+static const float TWO_PI = 2.0f * PI;
+static const float DT = 1.0f / MOTION_RATE;
+static const float RAD = PI / 180.0f;
+
+// ======= RANDOM =======
+static float uniform(motion_gen &g) {
+    g.rng = g.rng * 1664525u + 1013904223u;
+    return (float)(g.rng >> 8) / 16777216.0f;
+}
+
+static float between(motion_gen &g, float lo, float hi) {
+    return lo + (hi - lo) * uniform(g);
+}
+
+// sum of uniforms, roughly normal with unit variance
+static float normal(motion_gen &g) {
+    float s = 0;
+    for (int i=0; i < 4; i++) s += uniform(g) - 0.5f;
+    return s * 1.732f;
+}
+
+static float advance(float ph, float hz) {
+    ph += TWO_PI * hz * DT;
+    if (ph >= TWO_PI) ph -= TWO_PI;
+    return ph;
+}
+
+static int16_t to_raw(float v, float per_lsb, bool &clipped) {
+    float c = v / per_lsb;
+    if (c > 32767.0f)  { clipped = true; return 32767; }
+    if (c < -32768.0f) { clipped = true; return -32768; }
+    return (int16_t)lrintf(c);
+}
+
+void motion_default_config(motion_config &c) {
+    c.noise_g = 0.002f;
+    c.noise_dps = 0.1f;
+    c.bias_dps = 3.0f;
+    c.bias_walk_dps = 0.02f;
+    c.wander_deg = 10.0f;
+    c.wander_hz = 0.05f;
+}
+
+void motion_init(motion_gen &g, uint32_t seed, const motion_config *cfg) {
+    g = motion_gen();
+    if (cfg) g.cfg = *cfg;
+    else     motion_default_config(g.cfg);
+    g.rng = seed * 2654435761u + 1;
+
+    for (int i=0; i < 3; i++) g.bias[i] = between(g, -g.cfg.bias_dps, g.cfg.bias_dps);
+    for (int i=0; i < 4; i++) {
+        g.ph_wander[i] = between(g, 0.0f, TWO_PI);
+        g.hz_wander[i] = g.cfg.wander_hz * between(g, 0.2f, 1.0f);
+    }
+}
+
+void motion_script(motion_gen &g, const motion_segment *segs, int n) {
+    g.script = n > 0 ? segs : 0;
+    g.script_len = n > 0 ? n : 0;
+    g.script_pos = 0;
+    g.seg_left = 0;
+}
+
+uint32_t motion_labels(const motion_segment &s) {
+    uint32_t l = 0;
+    if (s.tremor_dps > 0) l |= MOTION_TREMOR;
+    if (s.dysk_dps > 0)   l |= MOTION_DYSK;
+    if (s.step_g > 0)     l |= MOTION_WALK;
+    if (s.fog_g > 0)      l |= MOTION_FREEZE;
+    return l;
+}
+
+// Ranges keep each symptom inside its detector band, with some margin.
+void motion_random_segment(motion_gen &g, motion_segment &s) {
+    s = motion_segment();
+
+    if (g.pending_fog) {
+        g.pending_fog = false;
+        s.seconds = between(g, 4.0f, 12.0f);
+        s.fog_hz = between(g, 3.5f, 7.0f);
+        s.fog_g = between(g, 0.03f, 0.1f);
+        return;
+    }
+
+    float r = uniform(g);
+    if (r < 0.25f) {
+        s.seconds = between(g, 6.0f, 20.0f);
+    } else if (r < 0.5f) {
+        s.seconds = between(g, 9.0f, 30.0f);
+        s.tremor_hz = between(g, 3.4f, 4.8f);
+        s.tremor_dps = between(g, 6.0f, 40.0f);
+    } else if (r < 0.65f) {
+        s.seconds = between(g, 9.0f, 24.0f);
+        s.dysk_hz = between(g, 5.3f, 6.7f);
+        s.dysk_dps = between(g, 20.0f, 80.0f);
+    } else {
+        // walking, and in a quarter of the bouts it ends in a freeze
+        g.pending_fog = r >= 0.9f;
+        s.seconds = g.pending_fog ? between(g, 6.0f, 15.0f) : between(g, 9.0f, 30.0f);
+        s.cadence_spm = between(g, 90.0f, 125.0f);
+        s.step_g = between(g, 0.1f, 0.3f);
+    }
+}
+
+static void next_segment(motion_gen &g) {
+    if (g.script) {
+        g.seg = g.script[g.script_pos];
+        if (++g.script_pos == g.script_len) g.script_pos = 0;
+    } else {
+        motion_random_segment(g, g.seg);
+    }
+    g.seg_left = (uint32_t)lrintf(g.seg.seconds * MOTION_RATE);
+    if (g.seg_left == 0) g.seg_left = 1;
+    g.labels = motion_labels(g.seg);
+    g.burst_len = g.burst_pos = g.burst_gap = 0;
+    g.stats.segments++;
+}
+
+// Next dyskinesia burst: 0.5-2 s long after a 0.2-1 s gap, frequency
+// within 8 % of the segment's, about a random axis.
+static void next_burst(motion_gen &g) {
+    g.burst_len = (uint32_t)(between(g, 0.5f, 2.0f) * MOTION_RATE);
+    g.burst_gap = (uint32_t)(between(g, 0.2f, 1.0f) * MOTION_RATE);
+    g.burst_pos = 0;
+    g.burst_hz = g.seg.dysk_hz * between(g, 0.92f, 1.08f);
+
+    float a[3], n2 = 0;
+    for (int i=0; i < 3; i++) {
+        a[i] = normal(g);
+        n2 += a[i] * a[i];
+    }
+    float inv = n2 > 1e-6f ? 1.0f / sqrtf(n2) : 0.0f;
+    if (inv == 0.0f) a[0] = inv = 1.0f;
+    for (int i=0; i < 3; i++) g.burst_axis[i] = a[i] * inv;
+}
+
+void motion_generate(motion_gen &g, int16_t (*raw)[IMU_AXES], uint8_t *labels, int n) {
+    const motion_config &c = g.cfg;
+    float bias_step = c.bias_walk_dps * sqrtf(DT);
+
+    for (int k=0; k < n; k++) {
+        if (g.seg_left == 0) next_segment(g);
+        g.seg_left--;
+        const motion_segment &s = g.seg;
+
+        // rotation rates (dps) and the angles they produce (degrees)
+        float rate[3] = { 0, 0, 0 };
+        float roll = 0, pitch = 0;
+        float vertical = 0;         // linear, along gravity, g
+
+        for (int i=0; i < 4; i++) {
+            g.ph_wander[i] = advance(g.ph_wander[i], g.hz_wander[i]);
+            float w = TWO_PI * g.hz_wander[i];
+            float a = arm_sin_f32(g.ph_wander[i]) * c.wander_deg;
+            float r = arm_cos_f32(g.ph_wander[i]) * c.wander_deg * w;
+            if (i < 2) { roll += a;  rate[0] += r; }
+            else       { pitch += a; rate[1] += r; }
+        }
+
+        if (s.tremor_dps > 0) {
+            g.ph_tremor = advance(g.ph_tremor, s.tremor_hz);
+            float w = TWO_PI * s.tremor_hz;
+            float r = s.tremor_dps * arm_sin_f32(g.ph_tremor);
+            float a = -s.tremor_dps / w * arm_cos_f32(g.ph_tremor);
+            rate[0] += r;         roll += a;
+            rate[1] += 0.3f * r;  pitch += 0.3f * a;
+        }
+
+        if (s.dysk_dps > 0) {
+            if (g.burst_pos < g.burst_len) {
+                float env = 0.5f - 0.5f * arm_cos_f32(TWO_PI * g.burst_pos / g.burst_len);
+                g.ph_dysk = advance(g.ph_dysk, g.burst_hz);
+                float w = TWO_PI * g.burst_hz;
+                float r = env * s.dysk_dps * arm_sin_f32(g.ph_dysk);
+                float a = -env * s.dysk_dps / w * arm_cos_f32(g.ph_dysk);
+                for (int i=0; i < 3; i++) rate[i] += r * g.burst_axis[i];
+                roll += a * g.burst_axis[0];
+                pitch += a * g.burst_axis[1];
+                g.burst_pos++;
+            } else if (g.burst_gap) {
+                g.burst_gap--;
+            } else {
+                next_burst(g);
+            }
+        }
+
+        if (s.step_g > 0) {
+            // ph_step is the stride phase; steps come twice per stride
+            float stride_hz = s.cadence_spm / 120.0f;
+            float prev = g.ph_step;
+            g.ph_step = advance(g.ph_step, stride_hz);
+            if (g.ph_step < prev || (prev < PI && g.ph_step >= PI)) g.stats.steps++;
+            float step = 2.0f * g.ph_step;
+            vertical += s.step_g * (arm_sin_f32(step) + 0.3f * arm_sin_f32(2.0f * step));
+
+            float swing = 150.0f * s.step_g;        // 30 dps at 0.2 g bounce
+            float w = TWO_PI * stride_hz;
+            rate[1] += swing * arm_sin_f32(g.ph_step);
+            pitch -= swing / w * arm_cos_f32(g.ph_step);
+        }
+
+        if (s.fog_g > 0) {
+            g.ph_fog = advance(g.ph_fog, s.fog_hz);
+            vertical += s.fog_g * arm_sin_f32(g.ph_fog);
+        }
+
+        // gravity in the body frame, plus the vertical acceleration
+        float sr = arm_sin_f32(roll * RAD),  cr = arm_cos_f32(roll * RAD);
+        float sp = arm_sin_f32(pitch * RAD), cp = arm_cos_f32(pitch * RAD);
+        float up = 1.0f + vertical;
+        float acc[3] = { -sp * up, sr * cp * up, cr * cp * up };
+
+        bool clipped = false;
+        for (int i=0; i < 3; i++) {
+            g.bias[i] += bias_step * normal(g);
+            raw[k][i] = to_raw(acc[i] + c.noise_g * normal(g), ACCEL_G_PER_LSB, clipped);
+            raw[k][3 + i] = to_raw(rate[i] + g.bias[i] + c.noise_dps * normal(g),
+                                   GYRO_DPS_PER_LSB, clipped);
+        }
+
+        if (labels) labels[k] = (uint8_t)g.labels;
+        g.stats.samples++;
+        if (clipped) g.stats.saturated++;
+    }
+}
@@ -0,0 +1,142 @@
+#include "packetizer.h"
+
+#include <string.h>
+
+#define PK_ENTRY 6              // u16 length, u32 time
+
+static uint16_t entry_len(const pk_queue &q, uint16_t at) {
+    uint16_t n;
+    memcpy(&n, q.buf + at, 2);
+    return n;
+}
+
+static uint32_t entry_time(const pk_queue &q, uint16_t at) {
+    uint32_t t;
+    memcpy(&t, q.buf + at + 2, 4);
+    return t;
+}
+
+static void queue_reset(pk_queue &q) {
+    q.head = q.tail = 0;
+    q.frames = q.bytes = 0;
+}
+
+void pk_init(packetizer &p, const pk_config &cfg, uint32_t device, pk_send_fn send, void *ctx) {
+    p.cfg = cfg;
+    if (p.cfg.mtu > PK_MAX_MTU) p.cfg.mtu = PK_MAX_MTU;
+    p.send = send;
+    p.ctx = ctx;
+    p.device = device;
+    p.seq = 0;
+    for (pk_queue &q : p.q) queue_reset(q);
+    memset(&p.st, 0, sizeof(p.st));
+}
+
+bool pk_put(packetizer &p, int prio, uint8_t type, const void *payload, size_t len, uint32_t now_ms) {
+    pk_queue &q = p.q[prio];
+    size_t n = TM_HEADER + len + TM_TRAILER;
+    if (n > p.cfg.mtu || len > TM_MAX_PAYLOAD) {
+        p.st.dropped[prio]++;
+        return false;
+    }
+    if (q.tail + PK_ENTRY + n > PK_QUEUE_BYTES) {
+        // move the live entries to the front
+        memmove(q.buf, q.buf + q.head, q.tail - q.head);
+        q.tail -= q.head;
+        q.head = 0;
+        if (q.tail + PK_ENTRY + n > PK_QUEUE_BYTES) {
+            p.st.dropped[prio]++;
+            return false;
+        }
+    }
+    uint16_t n16 = (uint16_t)n;
+    memcpy(q.buf + q.tail, &n16, 2);
+    memcpy(q.buf + q.tail + 2, &now_ms, 4);
+    tm_encode(q.buf + q.tail + PK_ENTRY, type, p.device, p.seq++, payload, len);
+    q.tail += PK_ENTRY + n;
+    q.frames++;
+    q.bytes += n;
+    p.st.frames++;
+    p.st.bytes += n;
+    return true;
+}
+
+// One packet: urgent frames first, then routine, while they fit. Frames
+// leave their queues only once the transport took the packet.
+static bool send_packet(packetizer &p, uint32_t now_ms) {
+    uint8_t pkt[PK_MAX_MTU];
+    size_t len = 0;
+    uint16_t take[PK_PRIORITIES], at[PK_PRIORITIES];
+    uint32_t delay[PK_PRIORITIES];
+    for (int k=PK_PRIORITIES - 1; k >= 0; k--) {
+        pk_queue &q = p.q[k];
+        take[k] = 0;
+        at[k] = q.head;
+        delay[k] = 0;
+        while (at[k] != q.tail) {
+            uint16_t n = entry_len(q, at[k]);
+            if (len + n > p.cfg.mtu) break;
+            if (!take[k]) delay[k] = now_ms - entry_time(q, at[k]);
+            memcpy(pkt + len, q.buf + at[k] + PK_ENTRY, n);
+            len += n;
+            at[k] += PK_ENTRY + n;
+            take[k]++;
+        }
+    }
+    if (!len) return false;
+    if (!p.send(p.ctx, pkt, len)) {
+        p.st.send_failed++;
+        return false;
+    }
+
+    for (int k=0; k < PK_PRIORITIES; k++) {
+        pk_queue &q = p.q[k];
+        if (!take[k]) continue;
+        q.bytes -= (uint16_t)(at[k] - q.head - PK_ENTRY * take[k]);
+        q.frames -= take[k];
+        q.head = at[k];
+        if (q.head == q.tail) queue_reset(q);
+        if (delay[k] > p.st.max_delay_ms[k]) p.st.max_delay_ms[k] = delay[k];
+    }
+    p.st.packets++;
+    p.st.sent_bytes += len;
+    return true;
+}
+
+static bool due(const packetizer &p, int k, uint32_t now_ms) {
+    const pk_queue &q = p.q[k];
+    uint32_t limit = k == PK_URGENT ? p.cfg.urgent_ms : p.cfg.flush_ms;
+    return q.frames && now_ms - entry_time(q, q.head) >= limit;
+}
+
+void pk_poll(packetizer &p, uint32_t now_ms) {
+    for (;;) {
+        uint32_t *reason;
+        if (due(p, PK_URGENT, now_ms))                              reason = &p.st.urgent;
+        else if (p.q[PK_URGENT].bytes + p.q[PK_ROUTINE].bytes >= p.cfg.mtu) reason = &p.st.full;
+        else if (due(p, PK_ROUTINE, now_ms))                        reason = &p.st.due;
+        else return;
+        if (!send_packet(p, now_ms)) return;
+        (*reason)++;
+    }
+}
+
+void pk_flush(packetizer &p, uint32_t now_ms) {
+    while (p.q[PK_URGENT].frames || p.q[PK_ROUTINE].frames) {
+        if (!send_packet(p, now_ms)) return;
+        p.st.due++;
+    }
+}
+
+uint32_t pk_next_due(const packetizer &p, uint32_t now_ms) {
+    uint32_t next = UINT32_MAX;
+    for (int k=0; k < PK_PRIORITIES; k++) {
+        const pk_queue &q = p.q[k];
+        if (!q.frames) continue;
+        uint32_t limit = k == PK_URGENT ? p.cfg.urgent_ms : p.cfg.flush_ms;
+        uint32_t age = now_ms - entry_time(q, q.head);
+        uint32_t left = age >= limit ? 0 : limit - age;
+        if (left < next) next = left;
+    }
+    return next;
+}
@@ -0,0 +1,26 @@
+#include "scheduler.h"
+
+#include <atomic>
+
+static std::atomic<uint32_t> pending(0);
+static sched_idle_fn idle_hook = 0;
+
+void sched_set_idle(sched_idle_fn idle) {
+    idle_hook = idle;
+}
+
+void sched_post(uint32_t events) {
+    pending.fetch_or(events);
+}
+
+uint32_t sched_pending() {
+    return pending.load();
+}
+
+uint32_t sched_wait() {
+    for (;;) {
+        uint32_t ev = pending.exchange(0);
+        if (ev) return ev;
+        if (idle_hook) idle_hook();
+    }
+}
@@ -0,0 +1,169 @@
+#include "step_detector.h"
+
+#include <math.h>
+#include <string.h>
+#include "arm_math.h"
+#include "const_math.h"
+
+#define STEP_QUEUE  16
+
+// Two 2nd-order Butterworth sections, high-pass then low-pass, in CMSIS
+// df2T order {b0, b1, b2, -a1, -a2} per section. Designed by the
+// compiler; only the filter state is in RAM.
+struct bandpass {
+    float c[10];
+
+    constexpr bandpass(double lo_hz, double hi_hz) : c() {
+        section(0, lo_hz, true);
+        section(5, hi_hz, false);
+    }
+
+    constexpr void section(int at, double fc, bool highpass) {
+        double w = 2.0 * CE_PI * fc / STEP_RATE;
+        double cw = ce_cos(w), alpha = ce_sin(w) / (2.0 * 0.70710678118654752);
+        double a0 = 1.0 + alpha;
+        double b = highpass ? (1.0 + cw) / 2.0 : (1.0 - cw) / 2.0;
+        c[at]     = (float)(b / a0);
+        c[at + 1] = (float)((highpass ? -2.0 * b : 2.0 * b) / a0);
+        c[at + 2] = (float)(b / a0);
+        c[at + 3] = (float)(2.0 * cw / a0);
+        c[at + 4] = (float)(-(1.0 - alpha) / a0);
+    }
+};
+
+static constexpr bandpass gait_design(0.5, 3.0);
+static constexpr bandpass tremble_design(3.0, 8.0);
+
+static float gait_state[4], tremble_state[4];
+
+static const arm_biquad_cascade_df2T_instance_f32 gait_bp = { 2, gait_state, gait_design.c };
+static const arm_biquad_cascade_df2T_instance_f32 tremble_bp = { 2, tremble_state, tremble_design.c };
+
+static float offset;            // first sample, so the filters start settled
+static bool  started;
+
+static uint32_t sample_count;
+static float prev1, prev2;      // band-passed samples t-1, t-2
+static float env;               // decaying peak envelope of the gait band
+static constexpr float env_decay = (float)ce_exp(-1.0 / (2.0 * STEP_RATE));   // 2 s
+static float energy;            // mean square of the 3-8 Hz band
+
+static uint32_t hist[STEP_HISTORY];
+static int hist_head, hist_n;
+
+static uint32_t queue[STEP_QUEUE];
+static int q_head, q_tail;
+
+static step_status st;
+
+void step_init() {
+    for (int i=0; i < 4; i++) gait_state[i] = tremble_state[i] = 0;
+
+    started = false;
+    sample_count = 0;
+    prev1 = prev2 = env = energy = 0;
+    hist_head = hist_n = 0;
+    q_head = q_tail = 0;
+    st = step_status();
+}
+
+static float stride_samples() {
+    if (hist_n < 2) return 0;
+    uint32_t newest = hist[(hist_head + STEP_HISTORY - 1) % STEP_HISTORY];
+    uint32_t oldest = hist[(hist_head + STEP_HISTORY - hist_n) % STEP_HISTORY];
+    return (float)(newest - oldest) / (hist_n - 1);
+}
+
+static void on_step(uint32_t t) {
+    if (st.steps && t - st.last_step > STEP_MAX_GAP) {
+        st.bout = 0;
+        hist_n = 0;
+    }
+    st.steps++;
+    st.bout++;
+    st.last_step = t;
+    st.stopped = false;
+
+    hist[hist_head] = t;
+    hist_head = (hist_head + 1) % STEP_HISTORY;
+    if (hist_n < STEP_HISTORY) hist_n++;
+
+    float stride = stride_samples();
+    st.cadence = stride > 0 ? 60.0f * STEP_RATE / stride : 0.0f;
+
+    int next = (q_head + 1) % STEP_QUEUE;
+    if (next != q_tail) {
+        queue[q_head] = t;
+        q_head = next;
+    }
+}
+
+int step_push(const float *accel, int n, float *band) {
+    float in[STEP_BLOCK], gait[STEP_BLOCK], tremble[STEP_BLOCK];
+    if (n > STEP_BLOCK) n = STEP_BLOCK;
+    if (n <= 0) return 0;
+
+    if (!started) {
+        offset = accel[0];
+        started = true;
+    }
+    arm_offset_f32(accel, -offset, in, n);
+    arm_biquad_cascade_df2T_f32(&gait_bp, in, gait, n);
+    arm_biquad_cascade_df2T_f32(&tremble_bp, in, tremble, n);
+    if (band) memcpy(band, gait, n * sizeof(float));
+
+    int found = 0;
+    for (int i=0; i < n; i++) {
+        uint32_t t = sample_count++;
+        float y = gait[i];
+
+        energy += (tremble[i] * tremble[i] - energy) * (1.0f / STEP_RATE);
+
+        float a = fabsf(y);
+        env = a > env ? a : env * env_decay;
+        float thr = 0.5f * env;
+        if (thr < STEP_MIN_G) thr = STEP_MIN_G;
+
+        // prev1 is a peak: rising into it, not rising after it
+        if (prev1 > prev2 && prev1 >= y && prev1 > thr
+            && (st.steps == 0 || t - 1 - st.last_step >= STEP_REFRACTORY)) {
+            on_step(t - 1);
+            found++;
+        }
+        prev2 = prev1;
+        prev1 = y;
+
+        if (st.bout >= STEP_MIN_BOUT) {
+            float stride = stride_samples();
+            float since = (float)(t - st.last_step);
+            if (!st.stopped && stride > 0 && since > 1.5f * stride) {
+                st.stopped = true;
+                st.cadence = 0;
+            } else if (st.stopped && since > STEP_HINT_STRIDES * stride) {
+                // standing or sitting by now; resting tremor must not
+                // keep the hint up
+                st.stopped = false;
+                st.bout = 0;
+            }
+        }
+    }
+
+    st.intent_g = sqrtf(energy);
+    st.freeze_hint = st.stopped && st.intent_g > STEP_INTENT_G;
+    return found;
+}
+
+int step_take(uint32_t *t, int max) {
+    int n = 0;
+    while (n < max && q_tail != q_head) {
+        t[n++] = queue[q_tail];
+        q_tail = (q_tail + 1) % STEP_QUEUE;
+    }
+    return n;
+}
+
+uint32_t step_now() { return sample_count; }
+
+bool step_freeze_hint() { return st.freeze_hint; }
+
+void step_get_status(step_status &s) { s = st; }
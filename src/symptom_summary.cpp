@@ -0,0 +1,97 @@
+#include "symptom_summary.h"
+
+#include <math.h>
+#include <string.h>
+
+// power bucket edges 0.625 * 8^k: bucket 1 starts at 0.625, 2 at 5, ...
+static const float POWER_BASE = 0.625f;
+
+// the tremor band of the detector, in Hz
+static const float FREQ_LO = parkinson_bands::tremor::lo * 0.001f;
+static const float FREQ_HI = parkinson_bands::tremor::hi * 0.001f;
+
+int summary_power_bin(float power) {
+    if (!(power >= POWER_BASE)) return 0;
+    // power / base = m * 2^e, m in [0.5, 1): e = 1..3 -> bucket 1, ...
+    int e;
+    frexpf(power * (1.0f / POWER_BASE), &e);
+    int b = 1 + (e - 1) / 3;
+    return b < SUMMARY_POWER_BINS ? b : SUMMARY_POWER_BINS - 1;
+}
+
+int summary_freq_bin(float hz) {
+    if (!(hz > FREQ_LO)) return 0;
+    int b = (int)(SUMMARY_FREQ_BINS * logf(hz / FREQ_LO) / logf(FREQ_HI / FREQ_LO));
+    return b < SUMMARY_FREQ_BINS ? b : SUMMARY_FREQ_BINS - 1;
+}
+
+static void open_hour(symptom_summary &s, uint16_t hour) {
+    s.hour = hour;
+    s.windows = 0;
+    memset(s.on, 0, sizeof(s.on));
+    memset(s.episodes, 0, sizeof(s.episodes));
+    memset(s.tremor_n, 0, sizeof(s.tremor_n));
+    memset(s.dysk_n, 0, sizeof(s.dysk_n));
+    memset(s.freq_n, 0, sizeof(s.freq_n));
+}
+
+void summary_init(symptom_summary &s) {
+    open_hour(s, 0);
+    s.prev_active = 0;
+    s.head = s.queued = 0;
+    s.dropped = 0;
+}
+
+// count / windows in 1/255, rounded
+static uint8_t share(uint32_t count, uint32_t windows) {
+    return (uint8_t)((count * 255u + windows / 2) / windows);
+}
+
+static void close_hour(symptom_summary &s) {
+    if (s.queued == SUMMARY_HOURS) {        // drop oldest
+        s.head = (s.head + 1) % SUMMARY_HOURS;
+        s.queued--;
+        s.dropped++;
+    }
+    summary_hour &h = s.queue[(s.head + s.queued++) % SUMMARY_HOURS];
+    h.hour = s.hour;
+    h.windows = s.windows;
+    for (int k=0; k < SYM_COUNT; k++) {
+        h.on[k] = s.on[k];
+        h.episodes[k] = (uint8_t)(s.episodes[k] < 255 ? s.episodes[k] : 255);
+    }
+    for (int b=0; b < SUMMARY_POWER_BINS; b++) {
+        h.tremor_hist[b] = share(s.tremor_n[b], s.windows);
+        h.dysk_hist[b]   = share(s.dysk_n[b], s.windows);
+    }
+    for (int b=0; b < SUMMARY_FREQ_BINS; b++) h.freq_hist[b] = share(s.freq_n[b], s.windows);
+    open_hour(s, s.hour + 1);
+}
+
+void summary_window(symptom_summary &s, const detector_result &r, uint32_t active, float tremor_hz) {
+    s.windows++;
+    uint32_t onset = active & ~s.prev_active;
+    for (int k=0; k < SYM_COUNT; k++) {
+        s.on[k] += (active >> k) & 1;
+        s.episodes[k] += (onset >> k) & 1;
+    }
+    s.prev_active = active;
+
+    s.tremor_n[summary_power_bin(r.tremor)]++;
+    s.dysk_n[summary_power_bin(r.dysk)]++;
+    if (tremor_hz > 0.0f) s.freq_n[summary_freq_bin(tremor_hz)]++;
+
+    if (s.windows == SUMMARY_HOUR_WINDOWS) close_hour(s);
+}
+
+void summary_flush(symptom_summary &s) {
+    if (s.windows) close_hour(s);
+}
+
+bool summary_take(symptom_summary &s, summary_hour &h) {
+    if (!s.queued) return false;
+    h = s.queue[s.head];
+    s.head = (s.head + 1) % SUMMARY_HOURS;
+    s.queued--;
+    return true;
+}
@@ -0,0 +1,116 @@
+#include "telemetry.h"
+
+#include <string.h>
+
+// CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF), table built by the
+// compiler.
+struct crc16_table {
+    uint16_t t[256];
+};
+
+static constexpr crc16_table make_crc16_table() {
+    crc16_table c = {};
+    for (int i=0; i < 256; i++) {
+        uint16_t r = (uint16_t)(i << 8);
+        for (int b=0; b < 8; b++) r = (uint16_t)(r & 0x8000 ? (r << 1) ^ 0x1021 : r << 1);
+        c.t[i] = r;
+    }
+    return c;
+}
+
+static constexpr crc16_table crc16 = make_crc16_table();
+
+uint16_t tm_crc16(const uint8_t *p, size_t n) {
+    uint16_t c = 0xFFFF;
+    for (size_t i=0; i < n; i++) c = (uint16_t)((c << 8) ^ crc16.t[(c >> 8) ^ p[i]]);
+    return c;
+}
+
+tm_window tm_window_from(uint32_t hop, const detector_result &r, uint32_t active) {
+    tm_window w;
+    w.hop = hop;
+    w.tremor = r.tremor;
+    w.dysk = r.dysk;
+    w.walk = r.walk;
+    w.fog = r.fog;
+    w.fog_ratio = r.fog_ratio;
+    w.active = active;
+    for (int s=0; s < SYM_COUNT; s++) w.score[s] = r.score[s];
+    w.flags = (r.tremor_present ? TM_FLAG_TREMOR_PRESENT : 0)
+            | (r.freezing       ? TM_FLAG_FREEZING : 0)
+            | (r.is_tremor      ? TM_FLAG_IS_TREMOR : 0)
+            | (r.is_dysk        ? TM_FLAG_IS_DYSK : 0);
+    return w;
+}
+
+void tm_window_result(const tm_window &w, detector_result &r) {
+    r.tremor = w.tremor;
+    r.dysk = w.dysk;
+    r.walk = w.walk;
+    r.fog = w.fog;
+    r.fog_ratio = w.fog_ratio;
+    r.tremor_present = w.flags & TM_FLAG_TREMOR_PRESENT;
+    r.freezing  = w.flags & TM_FLAG_FREEZING;
+    r.is_tremor = w.flags & TM_FLAG_IS_TREMOR;
+    r.is_dysk   = w.flags & TM_FLAG_IS_DYSK;
+    for (int s=0; s < SYM_COUNT; s++) r.score[s] = w.score[s];
+}
+
+size_t tm_encode(uint8_t *out, uint8_t type, uint32_t device, uint16_t seq,
+                 const void *payload, size_t len) {
+    if (len > TM_MAX_PAYLOAD) return 0;
+    out[0] = TM_SYNC0;
+    out[1] = TM_SYNC1;
+    out[2] = type;
+    out[3] = (uint8_t)len;
+    memcpy(out + 4, &device, 4);
+    memcpy(out + 8, &seq, 2);
+    memcpy(out + TM_HEADER, payload, len);
+    uint16_t crc = tm_crc16(out + 2, TM_HEADER - 2 + len);
+    memcpy(out + TM_HEADER + len, &crc, 2);
+    return TM_HEADER + len + TM_TRAILER;
+}
+
+size_t tm_decode(const uint8_t *p, size_t n, tm_frame_fn fn, void *ctx, tm_decode_stats &st) {
+    size_t i = 0;
+    while (i < n) {
+        if (p[i] != TM_SYNC0) {
+            // next candidate sync byte
+            const uint8_t *s = (const uint8_t *)memchr(p + i, TM_SYNC0, n - i);
+            size_t next = s ? (size_t)(s - p) : n;
+            st.skipped += next - i;
+            i = next;
+            continue;
+        }
+        if (n - i < TM_HEADER) break;
+        if (p[i + 1] != TM_SYNC1) {
+            st.skipped++;
+            i++;
+            continue;
+        }
+        size_t len = p[i + 3];
+        size_t frame = TM_HEADER + len + TM_TRAILER;
+        if (n - i < frame) break;
+
+        uint16_t crc;
+        memcpy(&crc, p + i + TM_HEADER + len, 2);
+        if (crc != tm_crc16(p + i + 2, TM_HEADER - 2 + len)) {
+            // not a frame after all, or a damaged one: look further on
+            st.crc_errors++;
+            st.skipped++;
+            i++;
+            continue;
+        }
+
+        tm_frame f;
+        f.type = p[i + 2];
+        f.len = (uint8_t)len;
+        memcpy(&f.device, p + i + 4, 4);
+        memcpy(&f.seq, p + i + 8, 2);
+        f.payload = p + i + TM_HEADER;
+        st.frames++;
+        fn(ctx, f);
+        i += frame;
+    }
+    return i;
+}
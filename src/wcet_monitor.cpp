@@ -0,0 +1,33 @@
+#include "wcet_monitor.h"
+
+#include <string.h>
+
+void wcet_stage_init(wcet_stage &s, const char *name, uint32_t budget) {
+    memset(&s, 0, sizeof(s));
+    s.name   = name;
+    s.budget = budget;
+}
+
+void wcet_begin(wcet_stage &s) {
+    s.start = cycle_clock_now();
+}
+
+bool wcet_end(wcet_stage &s) {
+    // unsigned subtraction handles counter wrap
+    uint32_t dt = cycle_clock_now() - s.start;
+
+    s.last = dt;
+    s.total += dt;
+    s.runs++;
+    if (dt > s.budget) s.misses++;
+
+    if (dt > s.worst) {
+        s.worst = dt;
+        return true;
+    }
+    return false;
+}
+
+void wcet_note_dropped(wcet_stage &s, uint32_t ticks) {
+    s.dropped += ticks;
+}
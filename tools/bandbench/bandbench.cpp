@@ -0,0 +1,121 @@
+// ========= BAND SUMS =========
+// Checks arm_band_sum_f32 and the prefix-sum mode (arm_band_prefix_f32 +
+// arm_band_sum_prefix_f32) against a double reference, then times them
+// and a plain per-band loop for growing numbers of bands over a
+// 256-point magnitude spectrum.
+//
+//   pio run -e bandbench && .pio/build/bandbench/program [iterations]
+//
+// Exit status 1 if a sum is off by more than its bound: relative 1e-5
+// for the direct sums, and for prefix sums 1e-6 of the spectrum total,
+// since their error follows the running sum, not the band.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <chrono>
+
+#include "detector.h"
+
+typedef Detector<52, 3, 256, parkinson_bands> det_board;
+
+static const int BINS = 129;
+static const int MAX_BANDS = 256;
+
+static float mag[BINS], prefix[BINS + 1];
+static float direct[MAX_BANDS], from_prefix[MAX_BANDS], loop[MAX_BANDS];
+static arm_band_range bands[MAX_BANDS];
+
+static unsigned seed = 1;
+static unsigned rnd(unsigned n) {
+    seed = seed * 1664525u + 1013904223u;
+    return (seed >> 8) % n;
+}
+
+// numBands ranges of 1 to 32 bins anywhere in the spectrum; the first
+// four are the board detector's walk, fog, tremor and dysk bands.
+static void make_bands(int n) {
+    const arm_band_range board[4] = {
+        { det_board::walk_bins::first,   det_board::walk_bins::last + 1 },
+        { det_board::fog_bins::first,    det_board::fog_bins::last + 1 },
+        { det_board::tremor_bins::first, det_board::tremor_bins::last + 1 },
+        { det_board::dysk_bins::first,   det_board::dysk_bins::last + 1 },
+    };
+    for (int i=0; i < n; i++) {
+        if (i < 4) { bands[i] = board[i]; continue; }
+        unsigned len = 1 + rnd(32);
+        unsigned start = rnd(BINS - len + 1);
+        bands[i].start = (uint16_t)start;
+        bands[i].end = (uint16_t)(start + len);
+    }
+}
+
+// what Detector::band_sum did per band before the table kernel
+static void loop_sums(int n) {
+    for (int i=0; i < n; i++) {
+        float sum = 0;
+        for (int k=bands[i].start; k < bands[i].end; k++) sum += mag[k];
+        loop[i] = sum;
+    }
+}
+
+template <class F>
+static double ns_per_call(F fn, int iterations) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i=0; i < iterations; i++) fn();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / iterations;
+}
+
+int main(int argc, char **argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 200000;
+    if (iterations <= 0) iterations = 1;
+
+    // ======= ACCURACY =======
+    double worst_direct = 0, worst_prefix = 0;
+    for (int rep=0; rep < 2000; rep++) {
+        // magnitudes over six decades, like a spectrum with a strong peak
+        double total = 0;
+        for (int k=0; k < BINS; k++) {
+            mag[k] = powf(10.0f, (float)rnd(6000) / 1000.0f - 3.0f);
+            total += mag[k];
+        }
+        make_bands(MAX_BANDS);
+        arm_band_sum_f32(mag, bands, MAX_BANDS, direct);
+        arm_band_prefix_f32(mag, BINS, prefix);
+        arm_band_sum_prefix_f32(prefix, bands, MAX_BANDS, from_prefix);
+
+        for (int i=0; i < MAX_BANDS; i++) {
+            double ref = 0;
+            for (int k=bands[i].start; k < bands[i].end; k++) ref += mag[k];
+            double ed = fabs(direct[i] - ref) / ref;
+            double ep = fabs(from_prefix[i] - ref) / total;
+            if (ed > worst_direct) worst_direct = ed;
+            if (ep > worst_prefix) worst_prefix = ep;
+        }
+    }
+    bool ok = worst_direct <= 1e-5 && worst_prefix <= 1e-6;
+    printf("direct: worst relative error %.2e (bound 1e-5)\n", worst_direct);
+    printf("prefix: worst error %.2e of the spectrum total (bound 1e-6)  %s\n\n",
+           worst_prefix, ok ? "ok" : "FAIL");
+
+    // ======= TIME =======
+    printf("%6s %12s %12s %14s %8s\n", "bands", "loop ns", "direct ns", "prefix ns", "agree");
+    static const int counts[] = { 2, 4, 16, 64, 256 };
+    for (int c : counts) {
+        make_bands(c);
+        double tl = ns_per_call([&] { loop_sums(c); }, iterations);
+        double td = ns_per_call([&] { arm_band_sum_f32(mag, bands, c, direct); }, iterations);
+        double tp = ns_per_call([&] {
+            arm_band_prefix_f32(mag, BINS, prefix);
+            arm_band_sum_prefix_f32(prefix, bands, c, from_prefix);
+        }, iterations);
+
+        // the direct kernel sums in the loop's order on the host
+        bool agree = true;
+        for (int i=0; i < c; i++) agree = agree && direct[i] == loop[i];
+        ok = ok && agree;
+        printf("%6d %12.1f %12.1f %14.1f %8s\n", c, tl, td, tp, agree ? "yes" : "NO");
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,74 @@
+// ========= CONFIGURATION BENCHMARK =========
+// Instantiates several Detector configurations in one binary and times
+// an analysis hop for each on the same synthetic tremor recording
+// (motion_gen.h), converted to magnitudes as on the board.
+//
+//   pio run -e bench && .pio/build/bench/program [iterations]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <chrono>
+
+#include "board_graph.h"
+#include "motion_gen.h"
+
+// 4 Hz, 8 dps rest tremor. The generator runs at 52 Hz; faster
+// configurations see the same recording repeated sample by sample.
+static void make_window(float *accel, float *gyro, int n, int rate) {
+    static const motion_segment tremor = { 60.0f, 4.0f, 8.0f, 0, 0, 0, 0, 0, 0 };
+    motion_gen g;
+    motion_init(g, 1);
+    motion_script(g, &tremor, 1);
+
+    MagnitudeNode mag;
+    mag.init();
+    imu_sample s;
+    mag_sample m;
+    for (int i=0; i < n; i++) {
+        if (i * MOTION_RATE / rate != (i - 1) * MOTION_RATE / rate || i == 0)
+            motion_generate(g, &s.raw, 0, 1);
+        mag.run(&s, &m);
+        accel[i] = m.accel;
+        gyro[i] = m.gyro;
+    }
+}
+
+template <class D>
+static void run(const char *name, int iterations) {
+    static D det;
+    static float accel[D::raw_samples];
+    static float gyro[D::raw_samples];
+
+    det.init();
+    make_window(accel, gyro, D::raw_samples, D::sample_rate);
+
+    detector_result r;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i=0; i < iterations; i++) det.analyze(accel, gyro, r);
+    auto t1 = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / iterations;
+
+    printf("%-22s %4d %6d %5d  %6.3f  %3d-%-3d  %9.0f  %8.1f  T=%.2f D=%.2f W=%.2f F=%.2f\n",
+           name, D::sample_rate, D::raw_samples, D::fft_size,
+           (double)D::hz_per_bin, D::tremor_bins::first, D::tremor_bins::last,
+           ns, ns / D::window_sec,
+           r.tremor, r.dysk, r.walk, r.fog);
+}
+
+int main(int argc, char **argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 20000;
+    if (iterations <= 0) iterations = 1;
+
+    printf("%-22s %4s %6s %5s  %6s  %7s  %9s  %8s  result\n",
+           "config", "Hz", "window", "fft", "Hz/bin", "tremor", "ns/hop", "ns/s");
+
+    run<board_detector>                                ("52Hz 3s 256 (board)", iterations);
+    run<Detector<52, 3, 512, parkinson_bands> >        ("52Hz 3s 512", iterations);
+    run<Detector<52, 2, 128, parkinson_bands> >        ("52Hz 2s 128", iterations);
+    run<Detector<52, 5, 512, parkinson_bands> >        ("52Hz 5s 512", iterations);
+    run<Detector<104, 2, 256, parkinson_bands> >       ("104Hz 2s 256", iterations);
+    run<Detector<104, 3, 512, parkinson_bands> >       ("104Hz 3s 512", iterations);
+    return 0;
+}
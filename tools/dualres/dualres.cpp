@@ -0,0 +1,146 @@
+// ========= DUAL-RESOLUTION FRONT END =========
+// Runs the board graph (two 256-point FFTs per 3 s window) and the dual
+// graph (128-point gyro path every 1.23 s, 512-point accel path every
+// 9.8 s, see dual_front_end.h) side by side over a labelled synthetic
+// corpus. Reports the per-second budget of both front ends, as modelled
+// transform work and as measured time, the time of a hop that runs
+// every transform, memory, and how the votes follow the labels sample
+// by sample.
+//
+//   pio run -e dualres && .pio/build/dualres/program [minutes] [seed]
+//
+// Exit status 1 if the dual front end needs more time per second of
+// signal than the board detector, modelled or measured. Host times
+// only compare the two; the modelled work counts N log2 N per FFT.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+
+#include "board_graph.h"
+#include "motion_gen.h"
+
+static board_graph board;
+static dual_graph  dual;
+static motion_gen  gen;
+
+struct front_stats {
+    const char *name;
+    std::vector<double> plain_ns, peak_ns;     // peak: hops that run every transform
+    uint32_t runs;
+    uint32_t active;                    // vote mask in force
+    uint32_t hit[SYM_COUNT], fa[SYM_COUNT];
+};
+
+static front_stats stats[2];
+
+static const struct { const char *name; uint32_t bit; int sym; } symptoms[] = {
+    { "tremor", MOTION_TREMOR, SYM_TREMOR },
+    { "dysk",   MOTION_DYSK,   SYM_DYSK },
+    { "freeze", MOTION_FREEZE, SYM_FREEZE },
+};
+static const int NSYM = sizeof(symptoms) / sizeof(symptoms[0]);
+
+static bool peak_hop(board_graph &) { return true; }
+static bool peak_hop(dual_graph &g) {
+    return g.node<NODE_DETECTOR>().front.features().slow_age == 0;
+}
+
+// Median times: on the host, the mean and the worst hop move with
+// whatever else the OS runs.
+template <class G>
+static void step(G &g, front_stats &s) {
+    if (!g.ready()) return;
+    auto t0 = std::chrono::steady_clock::now();
+    const board_decision &d = *g.run();
+    auto t1 = std::chrono::steady_clock::now();
+    s.active = d.active;
+    // the first run pays for cold caches and page faults
+    if (s.runs++ == 0) return;
+    double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+    (peak_hop(g) ? s.peak_ns : s.plain_ns).push_back(ns);
+}
+
+static double median(std::vector<double> &v) {
+    if (v.empty()) return 0;
+    std::nth_element(v.begin(), v.begin() + v.size() / 2, v.end());
+    return v[v.size() / 2];
+}
+
+// median hop times weighted by how often each kind of hop runs
+static double ns_per_s(front_stats &f, double seconds) {
+    return (median(f.plain_ns) * f.plain_ns.size() + median(f.peak_ns) * f.peak_ns.size()) / seconds;
+}
+
+int main(int argc, char **argv) {
+    int minutes = argc > 1 ? atoi(argv[1]) : 240;
+    uint32_t seed = argc > 2 ? (uint32_t)strtoul(argv[2], 0, 0) : 1;
+    if (minutes <= 0) minutes = 1;
+
+    board_graph_init(board);
+    dual.init();
+    stats[0].name = "board";
+    stats[1].name = "dual";
+    motion_init(gen, seed);
+
+    uint32_t samples = (uint32_t)minutes * 60 * MOTION_RATE;
+    uint32_t pos[SYM_COUNT] = {}, neg[SYM_COUNT] = {};
+    for (uint32_t n=0; n < samples; n++) {
+        int16_t raw[1][IMU_AXES];
+        uint8_t label;
+        motion_generate(gen, raw, &label, 1);
+
+        imu_sample s;
+        for (int a=0; a < IMU_AXES; a++) s.raw[a] = raw[0][a];
+        board.push(s);
+        dual.push(s);
+        step(board, stats[0]);
+        step(dual, stats[1]);
+
+        for (int k=0; k < NSYM; k++) {
+            int sym = symptoms[k].sym;
+            bool labelled = label & symptoms[k].bit;
+            if (labelled) pos[sym]++;
+            else          neg[sym]++;
+            for (front_stats &f : stats) {
+                bool on = f.active & (1u << sym);
+                if (labelled) f.hit[sym] += on;
+                else          f.fa[sym] += on;
+            }
+        }
+    }
+
+    double seconds = (double)samples / MOTION_RATE;
+    printf("corpus: %d min, seed %lu\n\n", minutes, (unsigned long)seed);
+    printf("%-6s %10s %10s %10s %11s %10s %9s\n",
+           "front", "hop", "work/s", "ns/s", "vs board", "peak hop", "bytes");
+
+    const double hop_s[2] = { (double)board_graph::input_tokens / MOTION_RATE,
+                              (double)dual_graph::input_tokens / MOTION_RATE };
+    const long long work[2] = { board_detector::fft_work_per_s, board_dual::fft_work_per_s };
+    const size_t bytes[2] = { sizeof(board_graph), sizeof(dual_graph) };
+    const double ns[2] = { ns_per_s(stats[0], seconds), ns_per_s(stats[1], seconds) };
+    for (int i=0; i < 2; i++) {
+        printf("%-6s %9.2fs %10lld %10.0f %9.1f%% %9.0fns %9zu\n",
+               stats[i].name, hop_s[i], work[i], ns[i], 100.0 * ns[i] / ns[0],
+               median(stats[i].peak_ns), bytes[i]);
+    }
+
+    printf("\nvote active, per sample\n%-8s %10s %10s %10s %10s\n",
+           "symptom", "board rec", "board fa", "dual rec", "dual fa");
+    for (int k=0; k < NSYM; k++) {
+        int sym = symptoms[k].sym;
+        printf("%-8s", symptoms[k].name);
+        for (const front_stats &f : stats)
+            printf(" %10.3f %10.3f",
+                   pos[sym] ? (double)f.hit[sym] / pos[sym] : 0.0,
+                   neg[sym] ? (double)f.fa[sym] / neg[sym] : 0.0);
+        printf("\n");
+    }
+
+    bool ok = work[1] < work[0] && ns[1] < ns[0];
+    printf("\ndual front end %s the board detector's budget\n", ok ? "within" : "OVER");
+    return ok ? 0 : 1;
+}
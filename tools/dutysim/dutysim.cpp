@@ -0,0 +1,123 @@
+// ========= DUTY-CYCLE SIMULATOR =========
+// Runs the event scheduler and duty profiler against a simulated cycle
+// clock, so the active/idle accounting can be checked on the host.
+//
+//   pio run -e dutysim && .pio/build/dutysim/program [seconds] [per_wake]
+//
+// The idle hook jumps the clock to the next IMU interrupt; stage costs
+// are fixed cycle counts, so the expected duty cycle is known exactly
+// and compared against what the profiler reports.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "detector.h"
+#include "cycle_clock.h"
+#include "scheduler.h"
+#include "duty_profiler.h"
+
+#define CORE_HZ        80000000u
+#define ACQ_CYCLES     1800u     // I2C reads + magnitudes, per sample
+#define WAKE_CYCLES    400u      // FIFO status + interrupt entry, per wake
+#define ANA_CYCLES     95000u    // two 256-point FFTs + band sums
+#define IO_CYCLES      40000u    // result lines
+
+static uint32_t sim_now = 0;
+static uint32_t next_irq = 0;
+static uint32_t irq_period = 0;
+
+static uint32_t sim_clock() { return sim_now; }
+
+// Advances simulated time, firing any IMU interrupts that fall inside.
+static void sim_advance(uint32_t cycles) {
+    uint32_t target = sim_now + cycles;
+    while ((int32_t)(target - next_irq) >= 0) {
+        sim_now = next_irq;
+        next_irq += irq_period;
+        sched_post(EVT_SENSOR);
+    }
+    sim_now = target;
+}
+
+static void sim_idle() {
+    sim_advance(next_irq - sim_now);
+}
+
+int main(int argc, char **argv) {
+    int seconds  = argc > 1 ? atoi(argv[1]) : 60;
+    int per_wake = argc > 2 ? atoi(argv[2]) : 13;
+    if (seconds <= 0 || per_wake <= 0) {
+        fprintf(stderr, "usage: dutysim [seconds] [samples_per_wake]\n");
+        return 2;
+    }
+
+    irq_period = CORE_HZ / board_detector::sample_rate * per_wake;
+    next_irq   = irq_period;
+
+    cycle_clock_set(&sim_clock, CORE_HZ);
+    duty_init();
+    sched_set_idle(&sim_idle);
+
+    uint32_t wakes_total = (uint32_t)((uint64_t)seconds * board_detector::sample_rate / per_wake);
+    uint32_t fill = 0, hops = 0;
+    uint64_t expect[DUTY_STAGES] = { 0 };
+    uint64_t got[DUTY_STAGES] = { 0 };
+    uint64_t span = 0;
+
+    for (uint32_t w = 0; w < wakes_total; ) {
+        duty_switch(DUTY_IDLE);
+        uint32_t ev = sched_wait();
+
+        if (ev & EVT_SENSOR) {
+            duty_switch(DUTY_ACQ);
+            uint32_t c = WAKE_CYCLES + ACQ_CYCLES * per_wake;
+            sim_advance(c);
+            expect[DUTY_ACQ] += c;
+            fill += per_wake;
+            if (fill >= board_detector::raw_samples) {
+                fill -= board_detector::raw_samples;
+                sched_post(EVT_ANALYZE);
+            }
+            w++;
+        }
+
+        if (ev & EVT_ANALYZE) {
+            duty_switch(DUTY_ANA);
+            sim_advance(ANA_CYCLES);
+            expect[DUTY_ANA] += ANA_CYCLES;
+
+            duty_switch(DUTY_IO);
+            sim_advance(IO_CYCLES);
+            expect[DUTY_IO] += IO_CYCLES;
+
+            duty_report d;
+            duty_take(d);
+            for (int i=0; i < DUTY_STAGES; i++) got[i] += d.cycles[i];
+            span += d.period;
+            hops++;
+        }
+    }
+
+    duty_switch(DUTY_IDLE);
+    duty_report d;
+    duty_take(d);
+    for (int i=0; i < DUTY_STAGES; i++) got[i] += d.cycles[i];
+    span += d.period;
+
+    expect[DUTY_IDLE] = span - expect[DUTY_ACQ] - expect[DUTY_ANA] - expect[DUTY_IO];
+
+    printf("%d s simulated, %d samples/wake, %lu wakes, %lu hops\n",
+           seconds, per_wake, (unsigned long)wakes_total, (unsigned long)hops);
+    printf("%-6s %14s %14s %8s\n", "stage", "profiled", "expected", "duty");
+
+    int bad = 0;
+    for (int i=0; i < DUTY_STAGES; i++) {
+        printf("%-6s %14llu %14llu %7.3f%%\n", duty_names[i],
+               (unsigned long long)got[i], (unsigned long long)expect[i],
+               span ? 100.0 * got[i] / span : 0.0);
+        if (got[i] != expect[i]) bad++;
+    }
+    printf("accounting %s\n", bad ? "MISMATCH" : "exact");
+    return bad ? 1 : 0;
+}
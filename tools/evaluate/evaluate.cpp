@@ -0,0 +1,285 @@
+// ========= DETECTION QUALITY =========
+// Runs the board analysis graph over a labelled synthetic corpus on all
+// cores and reports, per symptom:
+//
+//   ROC / PR     swept over the single-window score (detector_result::
+//                score, q15 margin) and over the vote confidence
+//   latency      hops from the onset of a labelled episode to the first
+//                window the vote is active
+//   episodes     labelled episodes detected / missed, and false episodes
+//                (active runs touching no labelled window)
+//
+//   pio run -e evaluate && .pio/build/evaluate/program [recordings] [minutes] [threads] [seed] > report.json
+//
+// Recording i is motion_gen seed + i with random segments. Each worker
+// takes the next recording and fills that recording's slot; slots are
+// merged in recording order after all workers finish, and everything
+// merged is an integer count, so the JSON report on stdout is the same
+// byte for byte for any thread count. Timing goes to stderr.
+//
+// The step detector's freeze hint is not included: it is module state
+// and cannot run on several threads. tools/synth covers it.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "board_graph.h"
+#include "motion_gen.h"
+
+#define EV_SYMS     3           // tremor, dysk, freeze
+#define EV_BINS     256         // histogram bins over the q15 range
+#define EV_MAX_LAT  16          // latency histogram, hops; last bin is "later"
+
+static const int W = board_graph::input_tokens;
+static const float HOP_S = (float)board_detector::window_sec;
+
+static const struct {
+    const char *name;
+    uint32_t bit;               // MOTION_*
+    int sym;                    // SYM_*
+} symptoms[EV_SYMS] = {
+    { "tremor", MOTION_TREMOR, SYM_TREMOR },
+    { "dysk",   MOTION_DYSK,   SYM_DYSK },
+    { "freeze", MOTION_FREEZE, SYM_FREEZE },
+};
+
+struct sym_eval {
+    uint32_t pos[EV_BINS], neg[EV_BINS];        // score of labelled / other windows
+    uint32_t vpos[EV_BINS], vneg[EV_BINS];      // vote confidence, same
+    uint32_t episodes, detected, false_episodes;
+    uint32_t latency[EV_MAX_LAT + 1];           // of detected episodes, hops
+};
+
+struct rec_eval {
+    uint32_t windows;
+    uint32_t checksum;
+    sym_eval sym[EV_SYMS];
+};
+
+// Scores and vote confidences are both signed q15: 256 bins over the
+// full range, so negative values keep their order on the curves.
+static int q15_bin(int16_t q) { return (q + 32768) >> 8; }
+
+static uint32_t fnv(uint32_t h, const void *p, size_t n) {
+    const uint8_t *b = (const uint8_t *)p;
+    for (size_t i=0; i < n; i++) h = (h ^ b[i]) * 16777619u;
+    return h;
+}
+
+// Episodes from per-window labels and vote decisions. An episode counts
+// as detected if the vote is active in it or in the window after it
+// (the vote lags by design); latency is from its first window.
+static void episodes(const std::vector<uint8_t> &label, const std::vector<uint8_t> &active,
+                     sym_eval &e) {
+    int n = (int)label.size();
+    for (int i=0; i < n; ) {
+        if (!label[i]) { i++; continue; }
+        int start = i;
+        while (i < n && label[i]) i++;
+        int end = i < n ? i + 1 : n;    // one window of slack
+        e.episodes++;
+        for (int k=start; k < end; k++) {
+            if (active[k]) {
+                e.detected++;
+                int lat = k - start;
+                e.latency[lat < EV_MAX_LAT ? lat : EV_MAX_LAT]++;
+                break;
+            }
+        }
+    }
+    for (int i=0; i < n; ) {
+        if (!active[i]) { i++; continue; }
+        bool touches = false;
+        int lo = i > 0 ? i - 1 : 0;
+        while (i < n && active[i]) i++;
+        for (int k=lo; k < n && k <= i; k++) touches = touches || label[k];
+        if (!touches) e.false_episodes++;
+    }
+}
+
+static void run_recording(uint32_t seed, int windows, board_graph &graph, rec_eval &out) {
+    static thread_local int16_t raw[W][IMU_AXES];
+    static thread_local uint8_t labels[W];
+
+    memset(&out, 0, sizeof(out));
+    board_graph_init(graph);
+
+    motion_gen gen;
+    motion_init(gen, seed);
+
+    std::vector<uint8_t> label[EV_SYMS], active[EV_SYMS];
+    uint32_t sum = 2166136261u;
+
+    for (int w=0; w < windows; w++) {
+        motion_generate(gen, raw, labels, W);
+        sum = fnv(sum, raw, sizeof(raw));
+
+        int count[EV_SYMS] = {};
+        for (int i=0; i < W; i++) {
+            imu_sample s;
+            memcpy(s.raw, raw[i], sizeof(s.raw));
+            graph.push(s);
+            for (int k=0; k < EV_SYMS; k++)
+                if (labels[i] & symptoms[k].bit) count[k]++;
+        }
+        const board_decision &d = *graph.run();
+
+        for (int k=0; k < EV_SYMS; k++) {
+            sym_eval &e = out.sym[k];
+            int sym = symptoms[k].sym;
+            bool pos = count[k] * 2 >= W;
+            (pos ? e.pos : e.neg)[q15_bin(d.r.score[sym])]++;
+            (pos ? e.vpos : e.vneg)[q15_bin(d.conf[sym])]++;
+            label[k].push_back(pos);
+            active[k].push_back((d.active >> sym) & 1);
+        }
+    }
+
+    for (int k=0; k < EV_SYMS; k++) episodes(label[k], active[k], out.sym[k]);
+    out.windows = windows;
+    out.checksum = sum;
+}
+
+static void merge(sym_eval &a, const sym_eval &b) {
+    for (int i=0; i < EV_BINS; i++) {
+        a.pos[i] += b.pos[i];
+        a.neg[i] += b.neg[i];
+        a.vpos[i] += b.vpos[i];
+        a.vneg[i] += b.vneg[i];
+    }
+    a.episodes += b.episodes;
+    a.detected += b.detected;
+    a.false_episodes += b.false_episodes;
+    for (int i=0; i <= EV_MAX_LAT; i++) a.latency[i] += b.latency[i];
+}
+
+// ======= REPORT =======
+// Curve points are "decide positive when bin >= t", emitted only where a
+// count changes; AUCs are trapezoids over all thresholds.
+static void curve(const char *name, const uint32_t *pos, const uint32_t *neg,
+                  float (*edge)(int), bool last) {
+    uint64_t P = 0, N = 0;
+    for (int i=0; i < EV_BINS; i++) { P += pos[i]; N += neg[i]; }
+
+    printf("      \"%s\": {\n        \"points\": [", name);
+    uint64_t tp = 0, fp = 0;
+    double auc = 0, ap = 0, prev_tpr = 0, prev_fpr = 0;
+    bool first = true;
+    for (int t=EV_BINS - 1; t >= 0; t--) {
+        tp += pos[t];
+        fp += neg[t];
+        if (!pos[t] && !neg[t]) continue;
+        double tpr = P ? (double)tp / P : 0, fpr = N ? (double)fp / N : 0;
+        double prec = tp + fp ? (double)tp / (tp + fp) : 1;
+        auc += (fpr - prev_fpr) * (tpr + prev_tpr) / 2;
+        ap += (tpr - prev_tpr) * prec;
+        prev_tpr = tpr;
+        prev_fpr = fpr;
+        printf("%s\n          {\"threshold\": %.5f, \"tpr\": %.5f, \"fpr\": %.5f, \"precision\": %.5f}",
+               first ? "" : ",", edge(t), tpr, fpr, prec);
+        first = false;
+    }
+    auc += (1.0 - prev_fpr) * (1.0 + prev_tpr) / 2;
+    printf("\n        ],\n        \"auc_roc\": %.5f,\n        \"average_precision\": %.5f\n      }%s\n",
+           auc, ap, last ? "" : ",");
+}
+
+static float q15_edge(int b) { return (b * 256 - 32768) / 32768.0f; }
+
+static void latency(const sym_eval &e) {
+    uint32_t n = e.detected;
+    uint64_t sum = 0;
+    uint32_t p50 = 0, p90 = 0, max = 0, acc = 0;
+    bool have50 = false, have90 = false;
+    for (int i=0; i <= EV_MAX_LAT; i++) {
+        sum += (uint64_t)i * e.latency[i];
+        acc += e.latency[i];
+        if (e.latency[i]) max = i;
+        if (!have50 && acc * 2 >= n && n) { p50 = i; have50 = true; }
+        if (!have90 && acc * 10 >= n * 9 && n) { p90 = i; have90 = true; }
+    }
+    printf("      \"latency_s\": {\"n\": %lu, \"mean\": %.3f, \"p50\": %.1f, \"p90\": %.1f, \"max\": %.1f, "
+           "\"hop_hist\": [", (unsigned long)n, n ? HOP_S * sum / n : 0.0,
+           HOP_S * p50, HOP_S * p90, HOP_S * max);
+    for (int i=0; i <= EV_MAX_LAT; i++) printf("%s%lu", i ? ", " : "", (unsigned long)e.latency[i]);
+    printf("]},\n");
+}
+
+static void episode_metrics(const sym_eval &e) {
+    double rec = e.episodes ? (double)e.detected / e.episodes : 0;
+    uint32_t claimed = e.detected + e.false_episodes;
+    double prec = claimed ? (double)e.detected / claimed : 0;
+    double f1 = rec + prec > 0 ? 2 * rec * prec / (rec + prec) : 0;
+    printf("      \"episodes\": {\"labelled\": %lu, \"detected\": %lu, \"missed\": %lu, "
+           "\"false\": %lu, \"recall\": %.5f, \"precision\": %.5f, \"f1\": %.5f},\n",
+           (unsigned long)e.episodes, (unsigned long)e.detected,
+           (unsigned long)(e.episodes - e.detected), (unsigned long)e.false_episodes,
+           rec, prec, f1);
+}
+
+int main(int argc, char **argv) {
+    int recordings = argc > 1 ? atoi(argv[1]) : 32;
+    int minutes    = argc > 2 ? atoi(argv[2]) : 30;
+    int threads    = argc > 3 ? atoi(argv[3]) : (int)std::thread::hardware_concurrency();
+    uint32_t seed  = argc > 4 ? (uint32_t)strtoul(argv[4], 0, 0) : 1;
+    if (recordings < 1) recordings = 1;
+    if (minutes < 1) minutes = 1;
+    if (threads < 1) threads = 1;
+    if (threads > recordings) threads = recordings;
+
+    int windows = minutes * 60 * MOTION_RATE / W;
+    std::vector<rec_eval> slots(recordings);
+    std::vector<board_graph> graphs(threads);
+    std::atomic<int> next(0);
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int t=0; t < threads; t++) {
+        pool.emplace_back([&, t] {
+            for (int i; (i = next++) < recordings; )
+                run_recording(seed + i, windows, graphs[t], slots[i]);
+        });
+    }
+    for (std::thread &th : pool) th.join();
+    auto t1 = std::chrono::steady_clock::now();
+
+    rec_eval total;
+    memset(&total, 0, sizeof(total));
+    uint32_t sum = 2166136261u;
+    for (int i=0; i < recordings; i++) {
+        total.windows += slots[i].windows;
+        sum = fnv(sum, &slots[i].checksum, sizeof(slots[i].checksum));
+        for (int k=0; k < EV_SYMS; k++) merge(total.sym[k], slots[i].sym[k]);
+    }
+
+    printf("{\n  \"corpus\": {\"recordings\": %d, \"minutes\": %d, \"seed\": %lu, "
+           "\"windows\": %lu, \"hop_s\": %.1f, \"checksum\": \"%08lx\"},\n",
+           recordings, minutes, (unsigned long)seed, (unsigned long)total.windows,
+           HOP_S, (unsigned long)sum);
+    printf("  \"symptoms\": {\n");
+    for (int k=0; k < EV_SYMS; k++) {
+        const sym_eval &e = total.sym[k];
+        uint64_t P = 0, N = 0;
+        for (int i=0; i < EV_BINS; i++) { P += e.pos[i]; N += e.neg[i]; }
+        printf("    \"%s\": {\n      \"windows\": {\"labelled\": %llu, \"other\": %llu},\n",
+               symptoms[k].name, (unsigned long long)P, (unsigned long long)N);
+        episode_metrics(e);
+        latency(e);
+        curve("score", e.pos, e.neg, q15_edge, false);
+        curve("vote", e.vpos, e.vneg, q15_edge, true);
+        printf("    }%s\n", k < EV_SYMS - 1 ? "," : "");
+    }
+    printf("  }\n}\n");
+
+    double s = std::chrono::duration<double>(t1 - t0).count();
+    double hours = (double)total.windows * HOP_S / 3600.0;
+    fprintf(stderr, "%d recordings, %.1f h of data, %d threads: %.2f s (%.0f h of data per s)\n",
+            recordings, hours, threads, s, hours / s);
+    return 0;
+}
@@ -0,0 +1,121 @@
+// ========= F16 / F32 COMPARISON =========
+// Runs the board's detector node at f32 and f16 side by side over a
+// sweep of synthetic windows and reports how often the decisions agree,
+// the band power error of the f16 pipeline, working set and time per
+// hop. Fails if a decision differs or a band is off by more than
+// max_band_error.
+//
+//   pio run -e f16cmp && .pio/build/f16cmp/program [iterations]
+//
+// Host timings of _Float16 are emulated on most x86 parts and only say
+// how the two compare here; the Cortex-M4 has no f16 arithmetic at all.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <chrono>
+
+#include "board_graph.h"
+
+#if !defined(ARM_FLOAT16_SUPPORTED)
+#error "f16cmp needs a compiler with _Float16"
+#endif
+
+typedef Detector<52, 3, 256, parkinson_bands, prec_f32> det32;
+typedef Detector<52, 3, 256, parkinson_bands, prec_f16> det16;
+typedef DetectorNode<det32, SpectralHistory<det32, 16, spec_log_q15> > node32;
+typedef DetectorNode<det16, SpectralHistory<det16, 16, spec_log_q15> > node16;
+
+static const int N = det32::raw_samples;
+
+// relative, any band of any window
+static const float max_band_error = 0.02f;
+
+// Accel in g, gyro in dps. Gait sway in the walk band, a rotational
+// component at tone_hz, plus a little broadband noise.
+static void make_window(float *accel, float *gyro, float walk_g,
+                        float tone_hz, float tone_dps, unsigned seed) {
+    for (int i=0; i < N; i++) {
+        float t = (float)i / det32::sample_rate;
+        seed = seed * 1664525u + 1013904223u;
+        float noise = ((int)(seed >> 16) - 32768) / 32768.0f;
+        accel[i] = 1.0f + walk_g * sinf(2.0f * PI * 1.2f * t) + 0.002f * noise;
+        gyro[i]  = 5.0f + tone_dps * sinf(2.0f * PI * tone_hz * t) + 0.5f * noise;
+    }
+}
+
+static float rel_err(float a, float ref) {
+    float d = fabsf(a - ref);
+    return ref > 1e-3f ? d / ref : d;
+}
+
+static node32 n32;
+static node16 n16;
+static float a32[N], g32[N];
+static mag_sample in[N];
+
+int main(int argc, char **argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 2000;
+    if (iterations <= 0) iterations = 1;
+
+    n32.init();
+    n16.init();
+
+    static const float walks[] = { 0.0f, 0.01f, 0.05f, 0.2f, 0.6f };
+    static const float tones[] = { 1.0f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f };
+    static const float amps[]  = { 0.0f, 0.5f, 2.0f, 10.0f, 60.0f, 200.0f };
+
+    int windows = 0, agree = 0;
+    float worst[4] = {0, 0, 0, 0};
+    detector_result r32, r16;
+
+    for (float w : walks)
+    for (float f : tones)
+    for (float a : amps) {
+        make_window(a32, g32, w, f, a, (unsigned)windows + 1);
+        for (int i=0; i < N; i++) {
+            in[i].accel = a32[i];
+            in[i].gyro  = g32[i];
+        }
+        n32.run(in, &r32);
+        n16.run(in, &r16);
+
+        windows++;
+        bool same = r32.is_tremor == r16.is_tremor && r32.is_dysk == r16.is_dysk
+                 && r32.freezing == r16.freezing;
+        if (same) agree++;
+        else printf("disagree: walk=%.2fg tone=%.1fHz %.1fdps  T/D/F %d%d%d vs %d%d%d\n",
+                    (double)w, (double)f, (double)a,
+                    r32.is_tremor, r32.is_dysk, r32.freezing,
+                    r16.is_tremor, r16.is_dysk, r16.freezing);
+
+        float e[4] = { rel_err(r16.tremor, r32.tremor), rel_err(r16.dysk, r32.dysk),
+                       rel_err(r16.walk, r32.walk), rel_err(r16.fog, r32.fog) };
+        for (int k=0; k < 4; k++) if (e[k] > worst[k]) worst[k] = e[k];
+    }
+
+    printf("decisions agree  %d / %d windows\n", agree, windows);
+    printf("worst band error tremor %.4f  dysk %.4f  walk %.4f  fog %.4f (relative, max %.4f)\n",
+           (double)worst[0], (double)worst[1], (double)worst[2], (double)worst[3],
+           (double)max_band_error);
+    bool bands_ok = true;
+    for (int k=0; k < 4; k++) bands_ok = bands_ok && worst[k] <= max_band_error;
+
+    // Time both on the last window
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i=0; i < iterations; i++) n32.run(in, &r32);
+    auto t1 = std::chrono::steady_clock::now();
+    for (int i=0; i < iterations; i++) n16.run(in, &r16);
+    auto t2 = std::chrono::steady_clock::now();
+
+    double ns32 = std::chrono::duration<double, std::nano>(t1 - t0).count() / iterations;
+    double ns16 = std::chrono::duration<double, std::nano>(t2 - t1).count() / iterations;
+
+    printf("%-4s %9s %9s %10s\n", "prec", "detector", "samples", "ns/hop");
+    printf("%-4s %9zu %9zu %10.0f\n", "f32", sizeof(n32.detector),
+           sizeof(n32.accel) + sizeof(n32.gyro), ns32);
+    printf("%-4s %9zu %9zu %10.0f\n", "f16", sizeof(n16.detector),
+           sizeof(n16.accel) + sizeof(n16.gyro), ns16);
+
+    return agree == windows && bands_ok ? 0 : 1;
+}
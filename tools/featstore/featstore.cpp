@@ -0,0 +1,255 @@
+// ========= FEATURE STORE =========
+// Builds a month of per-window features for a few patients in the
+// columnar store (tools/store/feature_store.h), then checks and times
+// the queries trend analysis needs: tremor per hour for one patient in
+// March (block headers only), per 15 minutes (decodes one column),
+// windows of strong tremor (min / max skipping), and a full
+// read of a day. Also cuts the tail off a file and reopens it for
+// append, as after a crash.
+//
+//   pio run -e featstore && .pio/build/featstore/program [patients] [days] [dir]
+//
+// Features come from the board graph over a 2 h synthetic recording per
+// patient (motion_gen seed = patient + 1), repeated to fill the days,
+// one row per 3 s window from 2026-03-01 00:00 UTC. Everything read is
+// compared with the rows written; exit status 1 on any difference.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <chrono>
+#include <vector>
+
+#include "board_graph.h"
+#include "motion_gen.h"
+#include "feature_store.h"
+
+static const int64_t MARCH_2026 = 1772323200000LL;     // ms, UTC
+static const int64_t HOP_MS = 3000;
+static const int64_t HOUR_MS = 3600000;
+static const int64_t DAY_MS = 24 * HOUR_MS;
+
+static board_graph graph;
+
+static double seconds_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// Two hours of board decisions for one patient.
+static void recording(uint32_t patient, std::vector<feature_row> &rows) {
+    static int16_t raw[board_graph::input_tokens][IMU_AXES];
+    motion_gen gen;
+    motion_init(gen, patient + 1);
+    board_graph_init(graph);
+
+    int windows = 2 * 3600 * MOTION_RATE / board_graph::input_tokens;
+    rows.clear();
+    for (int w=0; w < windows; w++) {
+        motion_generate(gen, raw, 0, board_graph::input_tokens);
+        for (int i=0; i < board_graph::input_tokens; i++) {
+            imu_sample s;
+            memcpy(s.raw, raw[i], sizeof(s.raw));
+            graph.push(s);
+        }
+        const board_decision &d = *graph.run();
+        rows.push_back(feature_row_from(0, d.r, d.active));
+    }
+}
+
+static feature_row row_at(const std::vector<feature_row> &rec, int64_t k) {
+    feature_row r = rec[k % rec.size()];
+    r.t_ms = MARCH_2026 + k * HOP_MS;
+    return r;
+}
+
+static bool same(const feature_row &a, const feature_row &b) {
+    return a.t_ms == b.t_ms && !memcmp(&a.tremor, &b.tremor, 5 * sizeof(float))
+        && a.flags == b.flags && !memcmp(a.score, b.score, sizeof(a.score));
+}
+
+static bool ok = true;
+
+static void check(bool pass, const char *what) {
+    if (!pass) {
+        ok = false;
+        printf("FAIL: %s\n", what);
+    }
+}
+
+static void print_stats(const char *name, double s, const fs_scan_stats &st, uint64_t rows) {
+    printf("%-26s %9.3f ms  %6llu decoded %6llu header %6llu skipped  %8.2f MB  %7.0f Mrow/s\n",
+           name, s * 1e3, (unsigned long long)st.blocks_decoded,
+           (unsigned long long)st.blocks_header, (unsigned long long)st.blocks_skipped,
+           st.bytes_decoded / 1e6, rows / s / 1e6);
+}
+
+int main(int argc, char **argv) {
+    int patients = argc > 1 ? atoi(argv[1]) : 4;
+    int days = argc > 2 ? atoi(argv[2]) : 31;
+    const char *dir = argc > 3 ? argv[3] : "featstore_data";
+    if (patients <= 0) patients = 1;
+    if (days <= 0) days = 1;
+    mkdir(dir, 0755);
+
+    int64_t per_patient = days * DAY_MS / HOP_MS;
+    char path[512];
+
+    // ======= APPEND =======
+    std::vector<feature_row> rec;
+    double append_s = 0;
+    uint64_t file_bytes = 0;
+    for (int p=0; p < patients; p++) {
+        recording(p, rec);
+        feature_store_path(path, sizeof(path), dir, p);
+        unlink(path);
+        FeatureWriter w;
+        if (!w.open(path)) {
+            printf("cannot create %s\n", path);
+            return 1;
+        }
+        auto t0 = std::chrono::steady_clock::now();
+        for (int64_t k=0; k < per_patient; k++) check(w.append(row_at(rec, k)), "append");
+        w.close();
+        append_s += seconds_since(t0);
+        file_bytes += w.bytes();
+    }
+    uint64_t total_rows = (uint64_t)patients * per_patient;
+    printf("%d patients x %d days: %llu rows, %.1f MB on disk (%.2f bytes/row, %zu raw), "
+           "%.1f Mrow/s appended\n\n",
+           patients, days, (unsigned long long)total_rows, file_bytes / 1e6,
+           (double)file_bytes / total_rows, sizeof(feature_row), total_rows / append_s / 1e6);
+
+    // patient 0 is the one queried
+    recording(0, rec);
+    feature_store_path(path, sizeof(path), dir, 0);
+    FeatureReader r;
+    if (!r.open(path)) {
+        printf("cannot open %s\n", path);
+        return 1;
+    }
+    check(r.rows() == (uint64_t)per_patient, "row count");
+
+    printf("%-14s %8s\n", "column", "bytes/row");
+    for (int c=0; c < FS_COLUMNS; c++)
+        printf("%-14s %8.3f\n", feature_column_name(c), (double)r.column_bytes(c) / r.rows());
+    printf("\n%zu blocks\n\n", r.blocks());
+
+    int64_t t0 = MARCH_2026, t1 = MARCH_2026 + days * DAY_MS;
+    int hours = days * 24;
+
+    // naive per-hour / per-quarter tremor from the rows themselves
+    std::vector<fs_bucket> want_h(hours), want_q(hours * 4);
+    for (int64_t k=0; k < per_patient; k++) {
+        feature_row x = row_at(rec, k);
+        fs_bucket *bk[2] = { &want_h[(x.t_ms - t0) / HOUR_MS], &want_q[(x.t_ms - t0) / (HOUR_MS / 4)] };
+        for (fs_bucket *b : bk) {
+            if (!b->count || x.tremor < b->min) b->min = x.tremor;
+            if (!b->count || x.tremor > b->max) b->max = x.tremor;
+            b->count++;
+            b->sum += x.tremor;
+        }
+    }
+    auto same_buckets = [](const std::vector<fs_bucket> &a, const std::vector<fs_bucket> &b) {
+        for (size_t i=0; i < a.size(); i++) {
+            if (a[i].count != b[i].count || a[i].min != b[i].min || a[i].max != b[i].max
+                || fabs(a[i].sum - b[i].sum) > 1e-9 * (fabs(b[i].sum) + 1))
+                return false;
+        }
+        return true;
+    };
+
+    // ======= QUERIES =======
+    printf("patient 0, March (%d days)\n", days);
+    std::vector<fs_bucket> got(hours * 4);
+
+    r.reset_stats();
+    auto q0 = std::chrono::steady_clock::now();
+    r.aggregate(FS_TREMOR, t0, t1, HOUR_MS, got.data());
+    print_stats("tremor per hour", seconds_since(q0), r.stats(), r.rows());
+    got.resize(hours);
+    check(same_buckets(got, want_h), "hourly aggregate");
+    check(r.stats().blocks_decoded == 0, "hourly aggregate decoded a block");
+
+    got.resize(hours * 4);
+    r.reset_stats();
+    q0 = std::chrono::steady_clock::now();
+    r.aggregate(FS_TREMOR, t0, t1, HOUR_MS / 4, got.data());
+    print_stats("tremor per 15 min", seconds_since(q0), r.stats(), r.rows());
+    check(same_buckets(got, want_q), "15 min aggregate");
+
+    // strong tremor: above the midpoint of the lowest and highest hourly
+    // peak, so the hours with quieter peaks are skipped by their headers
+    double peak_lo = want_h[0].max, peak_hi = want_h[0].max;
+    for (const fs_bucket &b : want_h) {
+        if (b.max < peak_lo) peak_lo = b.max;
+        if (b.max > peak_hi) peak_hi = b.max;
+    }
+    double strong = 0.5 * (peak_lo + peak_hi);
+    uint64_t want_n = 0;
+    for (int64_t k=0; k < per_patient; k++) want_n += row_at(rec, k).tremor >= strong;
+    r.reset_stats();
+    q0 = std::chrono::steady_clock::now();
+    uint64_t n = r.count_where(FS_TREMOR, t0, t1, strong, INFINITY);
+    print_stats("windows of strong tremor", seconds_since(q0), r.stats(), r.rows());
+    check(n == want_n, "count_where");
+
+    std::vector<feature_row> day;
+    int64_t d0 = t0 + (days / 2) * DAY_MS;
+    r.reset_stats();
+    q0 = std::chrono::steady_clock::now();
+    r.read(d0, d0 + DAY_MS, day);
+    print_stats("one day, all columns", seconds_since(q0), r.stats(), day.size());
+    bool day_ok = day.size() == (size_t)(DAY_MS / HOP_MS);
+    for (size_t i=0; day_ok && i < day.size(); i++)
+        day_ok = same(day[i], row_at(rec, (d0 - t0) / HOP_MS + i));
+    check(day_ok, "read back one day");
+
+    std::vector<feature_row> all;
+    all.reserve(per_patient);
+    r.reset_stats();
+    q0 = std::chrono::steady_clock::now();
+    r.read(t0, t1, all);
+    double all_s = seconds_since(q0);
+    print_stats("March, all columns", all_s, r.stats(), all.size());
+    bool all_ok = all.size() == (size_t)per_patient;
+    for (size_t i=0; all_ok && i < all.size(); i++) all_ok = same(all[i], row_at(rec, i));
+    check(all_ok, "read back March");
+
+    // the same rows as an array of structs, for scale
+    std::vector<feature_row> copy(all.size());
+    q0 = std::chrono::steady_clock::now();
+    memcpy(copy.data(), all.data(), all.size() * sizeof(feature_row));
+    double copy_s = seconds_since(q0);
+    printf("%-26s %9.3f ms  %.1f GB/s over %zu-byte rows\n", "memcpy of the raw rows",
+           copy_s * 1e3, all.size() * sizeof(feature_row) / copy_s / 1e9, sizeof(feature_row));
+    r.close();
+
+    // ======= TORN TAIL =======
+    // three hours, the last block cut short: reopening keeps two
+    snprintf(path, sizeof(path), "%s/torn.fst", dir);
+    unlink(path);
+    {
+        FeatureWriter w;
+        w.open(path);
+        for (int64_t k=0; k < 3 * HOUR_MS / HOP_MS; k++) w.append(row_at(rec, k));
+        w.close();
+        check(truncate(path, (off_t)w.bytes() - 10) == 0, "truncate");
+        check(w.open(path) && w.rows() == (uint64_t)(2 * HOUR_MS / HOP_MS), "torn block dropped");
+        int64_t k0 = 2 * HOUR_MS / HOP_MS;
+        for (int64_t k=k0; k < 4 * HOUR_MS / HOP_MS; k++) check(w.append(row_at(rec, k)), "append after reopen");
+        w.close();
+        FeatureReader t;
+        std::vector<feature_row> back;
+        check(t.open(path) && t.read(t0, t1, back) == (size_t)(4 * HOUR_MS / HOP_MS), "reopened rows");
+        bool torn_ok = true;
+        for (size_t i=0; torn_ok && i < back.size(); i++) torn_ok = same(back[i], row_at(rec, i));
+        check(torn_ok, "rows after reopen");
+    }
+    unlink(path);
+
+    printf("\n%s\n", ok ? "all queries match the rows written" : "MISMATCH");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,420 @@
+// ========= TELEMETRY INGEST =========
+// Host daemon for many devices' telemetry (telemetry.h frames), sharded
+// over per-core event loops (ingest_shard.h): decodes frames, optionally
+// re-runs the board graph on the raw samples, and appends a row per
+// device and hop to the feature store (tools/store).
+//
+//   pio run -e ingest && .pio/build/ingest/program serve <shards> <store-dir|-> <reanalyse 0|1> <source>...
+//   .pio/build/ingest/program load [devices] [seconds] [store-dir|-]
+//   .pio/build/ingest/program gen <file> [devices] [seconds] [first-id]
+//
+// serve   sources are paths (pseudo-terminals, FIFOs, capture files)
+//         or tcp:<port> (loopback listener, each connection a
+//         gateway); sources go to shards round-robin. Ends when every
+//         path source has ended and no listener is open, or on Ctrl-C.
+// load    load generator: devices (10000) on 64 loopback socket pairs
+//         standing in for gateways, `seconds` of synthetic recording
+//         each (raw samples every 13, a window every 156), about one
+//         frame in 1000 damaged. Runs 1, 2, 4, ... shards up to the
+//         core count (at least 4) with re-analysis on and checks every
+//         hop is stored once and re-analysis agrees with the device.
+// gen     writes the same stream for one gateway to a file, for serve.
+//
+// A device must arrive on one source only: its state and store file
+// belong to the shard reading that source.
+//
+// Scaling is judged on the busiest shard's CPU time, which is what the
+// wall time becomes once every shard has its own core; wall time is
+// printed too. Exit status 1 on a failed check, or if a shard count no
+// larger than the core count scales below 80 %.
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include "board_graph.h"
+#include "motion_gen.h"
+#include "telemetry.h"
+#include "feature_store.h"
+#include "ingest_shard.h"
+
+static const int W = board_graph::input_tokens;
+static const int WAKE = 13;                         // samples per raw frame, as main.cpp
+static const int GATEWAYS = 64;
+static const int DAMAGE_EVERY = 997;                // frames
+static const int64_t EPOCH_MS = 1772323200000LL;    // 2026-03-01 00:00 UTC
+
+static_assert(W % WAKE == 0, "a window is a whole number of raw frames");
+
+// ======= SYNTHETIC DEVICES =======
+// One device's frames, and where each wake's frames end.
+struct device_stream {
+    std::vector<uint8_t> bytes;
+    std::vector<uint32_t> wake_end;
+};
+
+static board_graph graph;
+
+static void device_frames(uint32_t id, int seconds, device_stream &out) {
+    motion_gen gen;
+    motion_init(gen, id + 1);
+    board_graph_init(graph);
+
+    int wakes = seconds * MOTION_RATE / WAKE;
+    uint16_t seq = 0;
+    uint8_t frame[TM_MAX_FRAME];
+    out.bytes.clear();
+    out.wake_end.clear();
+    for (int k=0; k < wakes; k++) {
+        tm_raw r;
+        r.sample = (uint32_t)k * WAKE;
+        motion_generate(gen, r.raw, 0, WAKE);
+        size_t n = tm_encode(frame, TM_RAW, id, seq++, &r, 4 + WAKE * IMU_AXES * 2);
+        out.bytes.insert(out.bytes.end(), frame, frame + n);
+
+        for (int i=0; i < WAKE; i++) {
+            imu_sample s;
+            memcpy(s.raw, r.raw[i], sizeof(s.raw));
+            graph.push(s);
+        }
+        if (graph.ready()) {
+            const board_decision &d = *graph.run();
+            tm_window w = tm_window_from((uint32_t)((k + 1) * WAKE / W - 1), d.r, d.active);
+            n = tm_encode(frame, TM_WINDOW, id, seq++, &w, sizeof(w));
+            out.bytes.insert(out.bytes.end(), frame, frame + n);
+        }
+        out.wake_end.push_back((uint32_t)out.bytes.size());
+    }
+}
+
+// Frames of the given devices interleaved wake by wake, as a gateway
+// forwards them. Every DAMAGE_EVERY-th raw frame gets a flipped byte;
+// returns how many. unseen counts those that were a device's first or
+// last frame, which no sequence gap can reveal.
+static uint32_t gateway_stream(const std::vector<uint32_t> &ids, int seconds,
+                               std::vector<uint8_t> &out, uint32_t &frame_no, uint32_t &unseen) {
+    std::vector<device_stream> dev(ids.size());
+    for (size_t i=0; i < ids.size(); i++) device_frames(ids[i], seconds, dev[i]);
+
+    uint32_t damaged = 0;
+    size_t wakes = dev.empty() ? 0 : dev[0].wake_end.size();
+    for (size_t k=0; k < wakes; k++) {
+        for (device_stream &d : dev) {
+            uint32_t a = k ? d.wake_end[k - 1] : 0, b = d.wake_end[k];
+            size_t at = out.size();
+            out.insert(out.end(), d.bytes.begin() + a, d.bytes.begin() + b);
+            // the raw frame leads the wake
+            if (++frame_no % DAMAGE_EVERY == 0) {
+                out[at + TM_HEADER + 5] ^= 0x40;
+                damaged++;
+                bool last = k == wakes - 1 && b - a == TM_HEADER + 4 + WAKE * IMU_AXES * 2 + TM_TRAILER;
+                unseen += k == 0 || last;
+            }
+        }
+    }
+    return damaged;
+}
+
+// ======= LOAD =======
+static std::vector<std::vector<uint8_t> > gateways;
+
+static void feed(const std::vector<int> &fds) {
+    const size_t CHUNK = 32 * 1024;
+    std::vector<size_t> pos(fds.size(), 0);
+    size_t open = fds.size();
+    for (size_t g=0; g < fds.size(); g++) if (gateways[g].empty()) shutdown(fds[g], SHUT_WR);
+    while (open) {
+        open = 0;
+        for (size_t g=0; g < fds.size(); g++) {
+            const std::vector<uint8_t> &b = gateways[g];
+            if (pos[g] == b.size()) continue;
+            size_t n = std::min(CHUNK, b.size() - pos[g]);
+            ssize_t w = write(fds[g], b.data() + pos[g], n);
+            if (w > 0) pos[g] += w;
+            if (pos[g] < b.size()) open++;
+            else                   shutdown(fds[g], SHUT_WR);
+        }
+    }
+    for (int fd : fds) close(fd);
+}
+
+struct load_run {
+    int shards;
+    double wall_s, max_cpu_s;
+    ingest_stats total;
+};
+
+static load_run run_load(int shards, const ingest_config &cfg) {
+    std::vector<IngestShard *> sh;
+    for (int i=0; i < shards; i++) sh.push_back(new IngestShard(i, cfg));
+
+    std::vector<int> tx;
+    for (int g=0; g < GATEWAYS; g++) {
+        int sv[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, sv) < 0) {
+            perror("socketpair");
+            exit(1);
+        }
+        sh[g % shards]->add_source(sv[0]);
+        tx.push_back(sv[1]);
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (IngestShard *s : sh) s->start();
+    std::thread feeder(feed, tx);
+    feeder.join();
+    for (IngestShard *s : sh) s->finish(true);
+    for (IngestShard *s : sh) s->join();
+    auto t1 = std::chrono::steady_clock::now();
+
+    load_run r;
+    r.shards = shards;
+    r.wall_s = std::chrono::duration<double>(t1 - t0).count();
+    r.max_cpu_s = 0;
+    memset(&r.total, 0, sizeof(r.total));
+    for (IngestShard *s : sh) {
+        ingest_stats_add(r.total, s->stats());
+        r.max_cpu_s = std::max(r.max_cpu_s, s->stats().cpu_s);
+        delete s;
+    }
+    return r;
+}
+
+static int cmd_load(int devices, int seconds, const char *dir) {
+    if (dir) mkdir(dir, 0755);
+    auto g0 = std::chrono::steady_clock::now();
+    gateways.assign(GATEWAYS, std::vector<uint8_t>());
+    uint32_t damaged = 0, unseen = 0, frame_no = 0;
+    for (int g=0; g < GATEWAYS; g++) {
+        std::vector<uint32_t> ids;
+        for (int d=g; d < devices; d += GATEWAYS) ids.push_back(d);
+        damaged += gateway_stream(ids, seconds, gateways[g], frame_no, unseen);
+    }
+    size_t bytes = 0;
+    for (const std::vector<uint8_t> &b : gateways) bytes += b.size();
+    double gen_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - g0).count();
+
+    uint64_t hops = (uint64_t)devices * (seconds * MOTION_RATE / W);
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    printf("%d devices x %d s on %d gateways: %.1f MB, %llu hops, %u damaged frames "
+           "(generated in %.1f s); %u cores\n\n",
+           devices, seconds, GATEWAYS, bytes / 1e6, (unsigned long long)hops, damaged,
+           gen_s, cores);
+    printf("%6s %8s %10s %9s %9s %10s %10s %8s\n",
+           "shards", "wall s", "frames/s", "cpu s", "max cpu", "frames/s*", "devices*", "scaling");
+
+    ingest_config cfg;
+    cfg.reanalyse = true;
+    cfg.store_dir = dir;
+    cfg.epoch_ms = EPOCH_MS;
+
+    bool ok = true;
+    double base = 0;
+    for (unsigned shards=1; shards <= std::max(4u, cores); shards *= 2) {
+        if (dir) {
+            char path[512];
+            for (int d=0; d < devices; d++) {
+                feature_store_path(path, sizeof(path), dir, d);
+                unlink(path);
+            }
+        }
+        load_run r = run_load(shards, cfg);
+        const ingest_stats &t = r.total;
+
+        // projected: each shard on its own core
+        double proj = t.frames / r.max_cpu_s;
+        if (shards == 1) base = proj;
+        double scaling = proj / (base * shards);
+        printf("%6u %8.2f %10.0f %9.2f %9.2f %10.0f %10.0f %7.0f%%\n",
+               shards, r.wall_s, t.frames / r.wall_s, t.cpu_s, r.max_cpu_s, proj,
+               (double)devices * seconds / r.max_cpu_s, 100 * scaling);
+
+        bool pass = t.rows == hops && t.devices == (uint64_t)devices
+                 && t.crc_errors >= damaged && t.lost == damaged - unseen
+                 && t.disagree == 0 && t.agree + t.inexact + damaged >= hops && t.store_errors == 0;
+        if (!pass) {
+            printf("  FAIL: rows %llu devices %llu crc %llu lost %llu agree %llu disagree %llu "
+                   "inexact %llu store errors %llu\n",
+                   (unsigned long long)t.rows, (unsigned long long)t.devices,
+                   (unsigned long long)t.crc_errors, (unsigned long long)t.lost,
+                   (unsigned long long)t.agree, (unsigned long long)t.disagree,
+                   (unsigned long long)t.inexact, (unsigned long long)t.store_errors);
+        }
+        if (shards <= cores && scaling < 0.8) {
+            printf("  FAIL: below 80 %% of linear\n");
+            pass = false;
+        }
+        ok = ok && pass;
+    }
+    printf("* with the busiest shard's CPU time as the wall time; devices = how many\n"
+           "  this many cores keep up with in real time\n");
+
+    // a sample of the stores holds every hop in order
+    if (dir) {
+        int hops_per = seconds * MOTION_RATE / W;
+        for (int d=0; d < devices; d += 997) {
+            char path[512];
+            feature_store_path(path, sizeof(path), dir, d);
+            FeatureReader rd;
+            std::vector<feature_row> rows;
+            bool good = rd.open(path) && rd.read(EPOCH_MS, EPOCH_MS + 86400000LL, rows) == (size_t)hops_per;
+            for (int k=0; good && k < hops_per; k++)
+                good = rows[k].t_ms == EPOCH_MS + (k + 1) * (int64_t)board_detector::window_sec * 1000;
+            if (!good) {
+                printf("FAIL: store of device %d\n", d);
+                ok = false;
+            }
+        }
+    }
+    printf("\n%s\n", ok ? "every hop stored once, re-analysis agrees" : "FAILED");
+    return ok ? 0 : 1;
+}
+
+// ======= GEN =======
+static int cmd_gen(const char *file, int devices, int seconds, uint32_t first) {
+    std::vector<uint32_t> ids;
+    for (int d=0; d < devices; d++) ids.push_back(first + d);
+    std::vector<uint8_t> out;
+    uint32_t frame_no = 0, unseen = 0;
+    uint32_t damaged = gateway_stream(ids, seconds, out, frame_no, unseen);
+    FILE *f = fopen(file, "wb");
+    if (!f || fwrite(out.data(), 1, out.size(), f) != out.size()) {
+        printf("cannot write %s\n", file);
+        return 1;
+    }
+    fclose(f);
+    printf("%s: %d devices x %d s, %zu bytes, %u damaged frames\n",
+           file, devices, seconds, out.size(), damaged);
+    return 0;
+}
+
+// ======= SERVE =======
+static volatile sig_atomic_t interrupted = 0;
+
+static void on_signal(int) { interrupted = 1; }
+
+static int listen_tcp(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in a;
+    memset(&a, 0, sizeof(a));
+    a.sin_family = AF_INET;
+    a.sin_port = htons(port);
+    a.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(fd, (sockaddr *)&a, sizeof(a)) < 0 || listen(fd, 128) < 0) {
+        perror("listen");
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static void print_stats(const ingest_stats &t, double wall_s) {
+    fprintf(stderr,
+            "%llu sources, %llu devices, %.1f MB, %llu frames (%.0f/s), %llu crc errors, "
+            "%llu lost, %llu restarts\n%llu windows, %llu raw samples, %llu hours, %llu episode "
+            "events, %llu log records, %llu rows stored, "
+            "%llu store errors\nre-analysed %llu: %llu agree, %llu differ, %llu after a gap\n",
+            (unsigned long long)t.sources, (unsigned long long)t.devices, t.bytes / 1e6,
+            (unsigned long long)t.frames, t.frames / wall_s,
+            (unsigned long long)t.crc_errors, (unsigned long long)t.lost,
+            (unsigned long long)t.restarts, (unsigned long long)t.windows, (unsigned long long)t.raw_samples,
+            (unsigned long long)t.hours, (unsigned long long)t.episodes,
+            (unsigned long long)t.logs, (unsigned long long)t.rows,
+            (unsigned long long)t.store_errors, (unsigned long long)t.reanalysed,
+            (unsigned long long)t.agree, (unsigned long long)t.disagree,
+            (unsigned long long)t.inexact);
+}
+
+static int cmd_serve(int shards, const char *dir, bool reanalyse, char **src, int nsrc) {
+    ingest_config cfg;
+    cfg.reanalyse = reanalyse;
+    cfg.store_dir = dir;
+    cfg.epoch_ms = 0;
+    if (dir) mkdir(dir, 0755);
+
+    std::vector<IngestShard *> sh;
+    for (int i=0; i < shards; i++) sh.push_back(new IngestShard(i, cfg));
+    std::vector<pollfd> listeners;
+    int next = 0;
+    for (int i=0; i < nsrc; i++) {
+        if (!strncmp(src[i], "tcp:", 4)) {
+            int fd = listen_tcp(atoi(src[i] + 4));
+            if (fd < 0) return 1;
+            pollfd p = { fd, POLLIN, 0 };
+            listeners.push_back(p);
+            continue;
+        }
+        int fd = open(src[i], O_RDONLY | O_NOCTTY | O_CLOEXEC);
+        if (fd < 0) {
+            fprintf(stderr, "%s: %s\n", src[i], strerror(errno));
+            return 1;
+        }
+        sh[next++ % shards]->add_source(fd);
+    }
+
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+    auto t0 = std::chrono::steady_clock::now();
+    for (IngestShard *s : sh) s->start();
+
+    while (!listeners.empty() && !interrupted) {
+        if (poll(listeners.data(), listeners.size(), 200) <= 0) continue;
+        for (pollfd &p : listeners) {
+            if (!(p.revents & POLLIN)) continue;
+            int fd = accept4(p.fd, 0, 0, SOCK_CLOEXEC);
+            if (fd >= 0) sh[next++ % shards]->add_source(fd);
+        }
+    }
+    for (pollfd &p : listeners) close(p.fd);
+    for (IngestShard *s : sh) s->finish(!interrupted);
+    for (IngestShard *s : sh) s->join();
+    double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    ingest_stats total;
+    memset(&total, 0, sizeof(total));
+    for (IngestShard *s : sh) {
+        ingest_stats_add(total, s->stats());
+        delete s;
+    }
+    print_stats(total, wall_s);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    const char *cmd = argc > 1 ? argv[1] : "load";
+    if (!strcmp(cmd, "serve") && argc > 5) {
+        int shards = std::max(1, atoi(argv[2]));
+        const char *dir = strcmp(argv[3], "-") ? argv[3] : 0;
+        return cmd_serve(shards, dir, atoi(argv[4]) != 0, argv + 5, argc - 5);
+    }
+    if (!strcmp(cmd, "load")) {
+        int devices = argc > 2 ? std::max(1, atoi(argv[2])) : 10000;
+        int seconds = argc > 3 ? std::max(W / MOTION_RATE, atoi(argv[3])) : 30;
+        const char *dir = argc > 4 && strcmp(argv[4], "-") ? argv[4] : 0;
+        return cmd_load(devices, seconds, dir);
+    }
+    if (!strcmp(cmd, "gen") && argc > 2) {
+        int devices = argc > 3 ? std::max(1, atoi(argv[3])) : 16;
+        int seconds = argc > 4 ? std::max(W / MOTION_RATE, atoi(argv[4])) : 60;
+        uint32_t first = argc > 5 ? (uint32_t)strtoul(argv[5], 0, 0) : 0;
+        return cmd_gen(argv[2], devices, seconds, first);
+    }
+    fprintf(stderr, "usage: %s serve <shards> <store-dir|-> <reanalyse 0|1> <source>...\n"
+                    "       %s load [devices] [seconds] [store-dir|-]\n"
+                    "       %s gen <file> [devices] [seconds] [first-id]\n", argv[0], argv[0], argv[0]);
+    return 2;
+}
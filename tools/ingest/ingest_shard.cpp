@@ -0,0 +1,331 @@
+#include "ingest_shard.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/stat.h>
+#include <algorithm>
+
+static const int W = board_graph::input_tokens;
+static const int64_t HOP_MS = board_detector::window_sec * 1000;
+
+static int64_t wall_ms() {
+    timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+void ingest_stats_add(ingest_stats &a, const ingest_stats &b) {
+    a.bytes += b.bytes;
+    a.frames += b.frames;
+    a.crc_errors += b.crc_errors;
+    a.skipped += b.skipped;
+    a.lost += b.lost;
+    a.windows += b.windows;
+    a.raw_samples += b.raw_samples;
+    a.hours += b.hours;
+    a.episodes += b.episodes;
+    a.logs += b.logs;
+    a.rows += b.rows;
+    a.store_errors += b.store_errors;
+    a.reanalysed += b.reanalysed;
+    a.agree += b.agree;
+    a.disagree += b.disagree;
+    a.inexact += b.inexact;
+    a.restarts += b.restarts;
+    a.devices += b.devices;
+    a.sources += b.sources;
+    a.cpu_s += b.cpu_s;
+}
+
+IngestShard::IngestShard(int index, const ingest_config &cfg)
+    : index(index), cfg(cfg), stop_now(false), stop_drained(false) {
+    memset(&st, 0, sizeof(st));
+    memset(&dec, 0, sizeof(dec));
+    ep = epoll_create1(EPOLL_CLOEXEC);
+    wake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.ptr = 0;
+    epoll_ctl(ep, EPOLL_CTL_ADD, wake, &ev);
+}
+
+IngestShard::~IngestShard() {
+    if (thread.joinable()) {
+        finish(false);
+        join();
+    }
+    for (source *s : sources) close_source(s);
+    for (auto &kv : devices) {
+        delete kv.second->graph;
+        delete kv.second->store;
+        delete kv.second;
+    }
+    close(wake);
+    close(ep);
+}
+
+void IngestShard::add_source(int fd) {
+    {
+        std::lock_guard<std::mutex> g(inbox_lock);
+        inbox.push_back(fd);
+    }
+    uint64_t one = 1;
+    if (write(wake, &one, sizeof(one)) < 0) {}
+}
+
+void IngestShard::start() {
+    thread = std::thread(&IngestShard::run, this);
+}
+
+void IngestShard::finish(bool drain) {
+    (drain ? stop_drained : stop_now) = true;
+    uint64_t one = 1;
+    if (write(wake, &one, sizeof(one)) < 0) {}
+}
+
+void IngestShard::join() {
+    if (thread.joinable()) thread.join();
+}
+
+void IngestShard::adopt() {
+    uint64_t n;
+    if (read(wake, &n, sizeof(n)) < 0) {}
+    std::vector<int> fds;
+    {
+        std::lock_guard<std::mutex> g(inbox_lock);
+        fds.swap(inbox);
+    }
+    for (int fd : fds) {
+        source *s = new source;
+        s->fd = fd;
+        s->fill = 0;
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        epoll_event ev;
+        ev.events = EPOLLIN;
+        ev.data.ptr = s;
+        // regular files cannot be polled; they are read every turn
+        s->polled = epoll_ctl(ep, EPOLL_CTL_ADD, fd, &ev) == 0;
+        sources.push_back(s);
+        st.sources++;
+    }
+}
+
+void IngestShard::close_source(source *s) {
+    if (s->polled) epoll_ctl(ep, EPOLL_CTL_DEL, s->fd, 0);
+    close(s->fd);
+    delete s;
+}
+
+void IngestShard::run() {
+    epoll_event ev[64];
+    while (!stop_now) {
+        bool files = false;
+        for (source *s : sources) files = files || !s->polled;
+        int n = epoll_wait(ep, ev, 64, files ? 0 : 100);
+        for (int i=0; i < n; i++) {
+            source *s = (source *)ev[i].data.ptr;
+            if (!s) {
+                adopt();
+                continue;
+            }
+            if (!pump(s)) {
+                sources.erase(std::find(sources.begin(), sources.end(), s));
+                close_source(s);
+            }
+        }
+        for (size_t i=0; i < sources.size(); ) {
+            source *s = sources[i];
+            if (!s->polled && !pump(s)) {
+                sources.erase(sources.begin() + i);
+                close_source(s);
+            } else {
+                i++;
+            }
+        }
+        if (stop_drained && sources.empty()) {
+            std::lock_guard<std::mutex> g(inbox_lock);
+            if (inbox.empty()) break;
+        }
+    }
+
+    for (auto &kv : devices) {
+        device &d = *kv.second;
+        if (d.have_re) store(d, d.re_row);
+        if (d.store) d.store->close();
+    }
+    st.devices = devices.size();
+    st.frames = dec.frames;
+    st.crc_errors = dec.crc_errors;
+    st.skipped = dec.skipped;
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    st.cpu_s = ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+bool IngestShard::pump(source *s) {
+    for (;;) {
+        ssize_t r = read(s->fd, s->buf + s->fill, sizeof(s->buf) - s->fill);
+        if (r < 0) return errno == EAGAIN || errno == EINTR;
+        if (r == 0) return false;
+        st.bytes += r;
+        s->fill += r;
+        size_t used = tm_decode(s->buf, s->fill, &IngestShard::on_frame, this, dec);
+        s->fill -= used;
+        memmove(s->buf, s->buf + used, s->fill);
+        // a polled source is read again when epoll says so
+        if (s->polled && (size_t)r < sizeof(s->buf) / 2) return true;
+    }
+}
+
+void IngestShard::on_frame(void *ctx, const tm_frame &f) {
+    ((IngestShard *)ctx)->frame(f);
+}
+
+IngestShard::device &IngestShard::find(uint32_t id) {
+    auto it = devices.find(id);
+    if (it != devices.end()) return *it->second;
+    device *d = new device();
+    d->id = id;
+    d->graph = 0;
+    d->store = 0;
+    if (cfg.store_dir) {
+        char path[512];
+        feature_store_path(path, sizeof(path), cfg.store_dir, id);
+        d->store = new FeatureWriter;
+        if (!d->store->open(path)) {
+            fprintf(stderr, "shard %d: cannot open %s\n", index, path);
+            delete d->store;
+            d->store = 0;
+        }
+    }
+    devices[id] = d;
+    return *d;
+}
+
+void IngestShard::frame(const tm_frame &f) {
+    device &d = find(f.device);
+    uint16_t gap = (uint16_t)(f.seq - d.next_seq);
+    if (d.seen && gap >= 0x8000) restart(d);   // sequence went back: rebooted
+    else if (d.seen)             st.lost += gap;
+    d.seen = true;
+    d.next_seq = f.seq + 1;
+
+    switch (f.type) {
+    case TM_WINDOW:
+        if (f.len == sizeof(tm_window)) {
+            tm_window w;
+            memcpy(&w, f.payload, sizeof(w));
+            window(d, w);
+        }
+        break;
+    case TM_RAW:
+        if (f.len >= 4 && (f.len - 4) % (IMU_AXES * 2) == 0) {
+            tm_raw r;
+            memcpy(&r, f.payload, f.len);
+            raw(d, r, (f.len - 4) / (IMU_AXES * 2));
+        }
+        break;
+    case TM_HOUR:
+        st.hours++;
+        break;
+    case TM_EPISODE:
+        st.episodes++;
+        break;
+    case TM_LOG:
+        st.logs++;
+        break;
+    }
+}
+
+// A new session of a known device: its hops and samples count from 0
+// again, so the time base and the host graph start over.
+void IngestShard::restart(device &d) {
+    st.restarts++;
+    if (d.have_re) store(d, d.re_row);
+    d.have_re = false;
+    d.base_ms = 0;
+    delete d.graph;
+    d.graph = 0;
+}
+
+void IngestShard::window(device &d, const tm_window &w) {
+    st.windows++;
+    if (!d.base_ms) d.base_ms = (cfg.epoch_ms ? cfg.epoch_ms : wall_ms() - HOP_MS) - w.hop * HOP_MS;
+
+    if (d.have_re && d.re_hop == w.hop && !d.exact) {
+        st.inexact++;
+        d.have_re = false;
+        store(d, d.re_row);
+        return;
+    }
+    if (d.have_re && d.re_hop == w.hop) {
+        detector_result r;
+        tm_window_result(w, r);
+        const detector_result &h = d.re_result;
+        bool same = r.tremor == h.tremor && r.dysk == h.dysk && r.walk == h.walk
+                 && r.fog == h.fog && r.fog_ratio == h.fog_ratio
+                 && r.tremor_present == h.tremor_present && r.freezing == h.freezing
+                 && r.is_tremor == h.is_tremor && r.is_dysk == h.is_dysk
+                 && !memcmp(r.score, h.score, sizeof(r.score));
+        (same ? st.agree : st.disagree)++;
+        d.have_re = false;
+        store(d, d.re_row);
+        return;
+    }
+    if (d.have_re && d.re_hop < w.hop) {
+        d.have_re = false;
+        store(d, d.re_row);
+    }
+    detector_result r;
+    tm_window_result(w, r);
+    store(d, feature_row_from(d.base_ms + ((int64_t)w.hop + 1) * HOP_MS, r, w.active));
+}
+
+void IngestShard::raw(device &d, const tm_raw &r, int n) {
+    st.raw_samples += n;
+    if (!cfg.reanalyse) return;
+    if (!d.graph) {
+        d.graph = new board_graph;
+        board_graph_init(*d.graph);
+        d.aligned = false;
+        d.exact = r.sample == 0;
+    }
+    if (!d.base_ms) d.base_ms = cfg.epoch_ms ? cfg.epoch_ms : wall_ms() - (int64_t)r.sample * 1000 / board_detector::sample_rate;
+    if (d.aligned && r.sample != d.next_sample) {
+        board_graph_init(*d.graph);
+        d.aligned = false;
+        d.exact = false;
+    }
+    d.next_sample = r.sample + n;
+
+    for (int i=0; i < n; i++) {
+        uint32_t t = r.sample + i;
+        if (!d.aligned) {
+            if (t % W) continue;
+            d.aligned = true;
+        }
+        imu_sample s;
+        memcpy(s.raw, r.raw[i], sizeof(s.raw));
+        d.graph->push(s);
+        if (!d.graph->ready()) continue;
+
+        const board_decision &b = *d.graph->run();
+        st.reanalysed++;
+        if (d.have_re) store(d, d.re_row);     // its device window never came
+        d.have_re = true;
+        d.re_hop = t / W;
+        d.re_result = b.r;
+        d.re_row = feature_row_from(d.base_ms + ((int64_t)d.re_hop + 1) * HOP_MS, b.r, b.active);
+    }
+}
+
+void IngestShard::store(device &d, const feature_row &row) {
+    st.rows++;
+    if (d.store && !d.store->append(row)) st.store_errors++;
+}
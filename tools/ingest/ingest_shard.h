@@ -0,0 +1,131 @@
+#ifndef INGEST_SHARD_H
+#define INGEST_SHARD_H
+
+#include <stdint.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "board_graph.h"
+#include "telemetry.h"
+#include "feature_store.h"
+
+// ========= INGEST SHARD =========
+// One event loop (epoll, one thread) owning a set of byte-stream sources
+// (sockets, pseudo-terminals, pipes, files) and every device that
+// appears on them. Frames are decoded in place from a per-source buffer;
+// each device keeps its own sequence check, optional re-analysis graph
+// and feature store writer, all touched by this shard only, so shards
+// share nothing and scale with cores. A device must stay on one source
+// (a gateway connection), which keeps it on one shard.
+//
+// Per device and analysis hop exactly one row is stored:
+//
+//   re-analysis off   the device's TM_WINDOW
+//   re-analysis on    the row the host's board graph computed from the
+//                     TM_RAW samples, compared with the device's window
+//                     of the same hop; the device's row when raw samples
+//                     of that hop were lost
+//
+// A sequence number going back means the device restarted: its time
+// base is taken again and the host graph starts over. A raw sample gap
+// resets the host graph, which then waits for the next
+// window boundary (sample % window == 0). Spectral averaging and the
+// vote carry state from hop to hop, so only hops re-analysed from every
+// sample since the device's boot are compared with the device.
+
+struct ingest_config {
+    bool reanalyse;
+    const char *store_dir;          // 0: decode and check, store nothing
+    int64_t epoch_ms;               // wall time of hop 0; 0: from arrival
+};
+
+struct ingest_stats {
+    uint64_t bytes, frames, crc_errors, skipped;
+    uint64_t lost;                  // frames missing by sequence number
+    uint64_t restarts;              // sequence went back: device rebooted
+    uint64_t windows, raw_samples, hours, episodes, logs;
+    uint64_t rows, store_errors;    // one row per device and hop
+    uint64_t reanalysed, agree, disagree;
+    uint64_t inexact;               // re-analysed after a raw gap, not compared
+    uint64_t devices, sources;
+    double cpu_s;                   // thread CPU time of the loop
+};
+
+void ingest_stats_add(ingest_stats &a, const ingest_stats &b);
+
+class IngestShard {
+public:
+    IngestShard(int index, const ingest_config &cfg);
+    ~IngestShard();
+
+    // Hands a non-blocking-capable descriptor to the shard; it is closed
+    // at end of stream. Callable from any thread, before or after start.
+    void add_source(int fd);
+
+    void start();
+
+    // Stop once every source has ended (drain) or at once.
+    void finish(bool drain);
+    void join();
+
+    // Valid after join().
+    const ingest_stats &stats() const { return st; }
+
+private:
+    struct source {
+        int fd;
+        bool polled;                // false: regular file, read until EOF
+        size_t fill;
+        uint8_t buf[64 * 1024];
+    };
+
+    struct device {
+        uint32_t id;
+        uint16_t next_seq;
+        bool     seen;
+        int64_t  base_ms;
+
+        board_graph *graph;         // re-analysis, from the first raw frame
+        uint32_t next_sample;
+        bool     aligned;
+        bool     exact;             // graph has seen every sample since boot
+        bool     have_re;           // re_row not yet stored
+        uint32_t re_hop;
+        feature_row re_row;
+        detector_result re_result;
+
+        FeatureWriter *store;
+    };
+
+    int index;
+    ingest_config cfg;
+    int ep, wake;
+    std::thread thread;
+    std::atomic<bool> stop_now, stop_drained;
+
+    std::mutex inbox_lock;
+    std::vector<int> inbox;
+
+    std::vector<source *> sources;
+    std::unordered_map<uint32_t, device *> devices;
+    ingest_stats st;
+    tm_decode_stats dec;
+
+    void run();
+    void adopt();
+    bool pump(source *s);           // false at end of stream
+    void close_source(source *s);
+
+    static void on_frame(void *ctx, const tm_frame &f);
+    void frame(const tm_frame &f);
+    device &find(uint32_t id);
+    void restart(device &d);
+    void window(device &d, const tm_window &w);
+    void raw(device &d, const tm_raw &r, int n);
+    void store(device &d, const feature_row &row);
+};
+
+#endif
@@ -0,0 +1,178 @@
+// ========= APPROXIMATE MAGNITUDE =========
+// Checks the approximate complex-magnitude kernels against their
+// documented error bounds, times them against the exact ones, and runs
+// the board detector with exact and approximate magnitudes side by side
+// over a synthetic corpus to see what the error does to decisions.
+//
+//   pio run -e magbench && .pio/build/magbench/program [iterations]
+//
+// Exit status 1 if a kernel exceeds its bound. Host timings only say
+// how the kernels compare here; on the Cortex-M4 the exact f32 kernel
+// pays a 14-cycle VSQRT per bin, the q15 one a software square root.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <chrono>
+
+#include "board_graph.h"
+#include "motion_gen.h"
+
+typedef Detector<52, 3, 256, parkinson_bands, prec_f32>        det_exact;
+typedef Detector<52, 3, 256, parkinson_bands, prec_f32_approx> det_approx;
+
+static const int BINS = 129;            // 256-point real FFT
+
+static float src_f32[2 * BINS], dst_f32[BINS];
+static q15_t src_q15[2 * BINS], dst_q15[BINS];
+
+typedef void (*kernel_f32)(const float32_t *, float32_t *, uint32_t);
+typedef void (*kernel_q15)(const q15_t *, q15_t *, uint32_t);
+
+static unsigned seed = 1;
+static float rnd() {
+    seed = seed * 1664525u + 1013904223u;
+    return (float)(seed >> 8) / 16777216.0f * 2.0f - 1.0f;
+}
+
+template <class F>
+static double ns_per_bin(F fn, int iterations) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i=0; i < iterations; i++) fn();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / iterations / BINS;
+}
+
+// Worst relative error over random inputs of every scale and a fine
+// phase sweep.
+static double err_f32(kernel_f32 k) {
+    double worst = 0;
+    for (int rep=0; rep < 2000; rep++) {
+        float scale = powf(10.0f, 6.0f * (rnd() + 1.0f) / 2.0f - 3.0f);
+        for (int i=0; i < BINS; i++) {
+            if (rep == 0) {
+                float th = (float)i / (BINS - 1) * 2.0f * PI;
+                src_f32[2*i] = cosf(th);
+                src_f32[2*i+1] = sinf(th);
+            } else {
+                src_f32[2*i] = rnd() * scale;
+                src_f32[2*i+1] = rnd() * scale;
+            }
+        }
+        k(src_f32, dst_f32, BINS);
+        for (int i=0; i < BINS; i++) {
+            double re = src_f32[2*i], im = src_f32[2*i+1];
+            double m = sqrt(re * re + im * im);
+            if (m > 0) {
+                double e = fabs(dst_f32[i] - m) / m;
+                if (e > worst) worst = e;
+            }
+        }
+    }
+    return worst;
+}
+
+// Relative error in 2.14, counting 1 LSB as allowed slack: returns the
+// worst relative error of bins whose error exceeds 1 LSB.
+static double err_q15(kernel_q15 k) {
+    double worst = 0;
+    for (int rep=0; rep < 2000; rep++) {
+        for (int i=0; i < BINS; i++) {
+            src_q15[2*i]   = (q15_t)(rnd() * 32767.0f);
+            src_q15[2*i+1] = (q15_t)(rnd() * 32767.0f);
+        }
+        if (rep == 1) src_q15[0] = src_q15[1] = -32768;
+        k(src_q15, dst_q15, BINS);
+        for (int i=0; i < BINS; i++) {
+            double re = src_q15[2*i], im = src_q15[2*i+1];
+            double m = sqrt(re * re + im * im) / 2.0;       // in 2.14 LSB
+            double d = fabs(dst_q15[i] - m);
+            if (m > 0 && d > 1.0) {
+                double e = (d - 1.0) / m;
+                if (e > worst) worst = e;
+            }
+        }
+    }
+    return worst;
+}
+
+static det_exact  dexact;
+static det_approx dapprox;
+
+int main(int argc, char **argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 20000;
+    if (iterations <= 0) iterations = 1;
+
+    // ======= ERROR BOUNDS =======
+    struct { const char *name; kernel_f32 k; double bound; } f32[] = {
+        { "arm_cmplx_mag_f32",                arm_cmplx_mag_f32,                1e-6 },
+        { "arm_cmplx_mag_approx_f32",         arm_cmplx_mag_approx_f32,         0.0396 },
+        { "arm_cmplx_mag_approx_refined_f32", arm_cmplx_mag_approx_refined_f32, 0.00971 },
+    };
+    struct { const char *name; kernel_q15 k; double bound; } q15[] = {
+        { "arm_cmplx_mag_q15",                arm_cmplx_mag_q15,                1e-3 },
+        { "arm_cmplx_mag_approx_q15",         arm_cmplx_mag_approx_q15,         0.0396 },
+        { "arm_cmplx_mag_approx_refined_q15", arm_cmplx_mag_approx_refined_q15, 0.00971 },
+    };
+
+    bool ok = true;
+    printf("%-34s %10s %10s %9s\n", "kernel", "max err", "bound", "ns/bin");
+    for (auto &k : f32) {
+        double e = err_f32(k.k);
+        double ns = ns_per_bin([&] { k.k(src_f32, dst_f32, BINS); }, iterations);
+        bool pass = e <= k.bound;
+        ok = ok && pass;
+        printf("%-34s %9.4f%% %9.4f%% %9.2f  %s\n", k.name, 100 * e, 100 * k.bound, ns,
+               pass ? "ok" : "FAIL");
+    }
+    for (auto &k : q15) {
+        double e = err_q15(k.k);
+        double ns = ns_per_bin([&] { k.k(src_q15, dst_q15, BINS); }, iterations);
+        bool pass = e <= k.bound;
+        ok = ok && pass;
+        printf("%-34s %9.4f%% %9.4f%% %9.2f  %s  (+1 LSB)\n", k.name, 100 * e, 100 * k.bound, ns,
+               pass ? "ok" : "FAIL");
+    }
+
+    // ======= DECISIONS =======
+    dexact.init();
+    dapprox.init();
+    motion_gen gen;
+    motion_init(gen, 7);
+
+    MagnitudeNode mag;
+    mag.init();
+    static int16_t raw[det_exact::raw_samples][IMU_AXES];
+    static float accel[det_exact::raw_samples], gyro[det_exact::raw_samples];
+    int windows = 4800, agree = 0;
+    double worst_band = 0;
+    for (int w=0; w < windows; w++) {
+        motion_generate(gen, raw, 0, det_exact::raw_samples);
+        for (int i=0; i < det_exact::raw_samples; i++) {
+            imu_sample s;
+            for (int a=0; a < IMU_AXES; a++) s.raw[a] = raw[i][a];
+            mag_sample m;
+            mag.run(&s, &m);
+            accel[i] = m.accel;
+            gyro[i] = m.gyro;
+        }
+
+        detector_result a, b;
+        dexact.analyze(accel, gyro, a);
+        dapprox.analyze(accel, gyro, b);
+        if (a.is_tremor == b.is_tremor && a.is_dysk == b.is_dysk && a.freezing == b.freezing)
+            agree++;
+        const float pa[4] = { a.tremor, a.dysk, a.walk, a.fog };
+        const float pb[4] = { b.tremor, b.dysk, b.walk, b.fog };
+        for (int j=0; j < 4; j++) {
+            if (pa[j] > 1e-3f) {
+                double e = fabs(pb[j] - pa[j]) / pa[j];
+                if (e > worst_band) worst_band = e;
+            }
+        }
+    }
+    printf("\nboard detector, %d synthetic windows: decisions agree in %d (%.2f%%), "
+           "worst band sum error %.3f%%\n",
+           windows, agree, 100.0 * agree / windows, 100 * worst_band);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,299 @@
+// ========= RADIO PACKETS =========
+// Runs hours of synthetic recording through the board graph, step
+// detector, tremor tracker and hourly summary as main.cpp does, and
+// records the telemetry frames the device would queue: a window result
+// and two instrumentation records (WCET, DUTY) per hop, an hourly
+// summary per hour (routine), an episode event per change of the shown
+// symptoms (urgent). The frames are replayed through the packetizer
+// (packetizer.h) at the board's wake-ups, every SAMPLES_PER_WAKE
+// samples, into a loopback transport that decodes every packet.
+//
+// Per MTU and flush latency: packets (radio wake-ups), bytes, worst
+// latency per priority and the energy of a simple radio model, against
+// one packet per frame as queued.
+//
+//   pio run -e packets && .pio/build/packets/program [hours] [seed]
+//
+// Exit status 1 if a frame is lost, duplicated, reordered within its
+// priority or damaged, or a latency bound is missed on a reliable link.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "board_graph.h"
+#include "motion_gen.h"
+#include "step_detector.h"
+#include "tremor_tracker.h"
+#include "symptom_summary.h"
+#include "packetizer.h"
+
+static board_graph graph;
+static motion_gen gen;
+static TremorTracker<board_detector> tracker;
+static board_sink spectra = { 0, &tracker };
+static symptom_summary summary;
+
+static const int W = board_graph::input_tokens;
+static int16_t raw[W][IMU_AXES];
+static uint8_t labels[W];
+
+// main.cpp: 13 samples per wake-up
+static const int WAKE_SAMPLES = 13;
+static uint32_t sample_ms(uint64_t n) { return (uint32_t)(n * 1000 / board_detector::sample_rate); }
+
+// Radio energy, BLE-class link at 1 Mbit/s and 3 V: each packet costs a
+// connection event (wake-up, ramp, header, empty ack), each payload byte
+// its air time at the TX current.
+static const double WAKE_UJ = 15.0;
+static const double BYTE_UJ = 0.12;
+
+// ======= TRACE =======
+// A frame as queued on the device.
+struct queued {
+    uint32_t ms;
+    int prio;
+    uint8_t type;
+    uint8_t len;
+    uint8_t payload[TM_MAX_PAYLOAD];
+};
+
+static std::vector<queued> trace;
+
+static void put(uint32_t ms, int prio, uint8_t type, const void *p, size_t len) {
+    queued q;
+    q.ms = ms;
+    q.prio = prio;
+    q.type = type;
+    q.len = (uint8_t)len;
+    memcpy(q.payload, p, len);
+    trace.push_back(q);
+}
+
+static void record(uint32_t ms, uint32_t fmt, const uint32_t *args, int n) {
+    tm_log l;
+    l.fmt = fmt;
+    memcpy(l.args, args, n * 4);
+    put(ms, PK_ROUTINE, TM_LOG, &l, 4 + 4 * n);
+}
+
+static void make_trace(int hours, uint32_t seed) {
+    board_graph_init(graph);
+    graph.node<NODE_DETECTOR>().sink = &spectra;
+    step_init();
+    tracker.init();
+    summary_init(summary);
+    motion_init(gen, seed);
+
+    uint32_t shown_was = 0;
+    size_t windows = (size_t)hours * SUMMARY_HOUR_WINDOWS;
+    for (size_t w=0; w < windows; w++) {
+        motion_generate(gen, raw, labels, W);
+        float amag[STEP_BLOCK];
+        int an = 0;
+        for (int i=0; i < W; i++) {
+            imu_sample s;
+            memcpy(s.raw, raw[i], sizeof(s.raw));
+            graph.push(s);
+            amag[an++] = graph.head_output().accel;
+            if (an == STEP_BLOCK || i == W - 1) {
+                step_push(amag, an);
+                an = 0;
+            }
+        }
+        uint32_t t[16];
+        while (step_take(t, 16) > 0) {}
+
+        const board_decision &d = *graph.run();
+        bool freezing = (d.active & (1u << SYM_FREEZE)) || step_freeze_hint();
+        uint32_t shown = (d.active & ~(1u << SYM_FREEZE)) | (freezing ? 1u << SYM_FREEZE : 0);
+        summary_window(summary, d.r, shown, tracker.locked() ? tracker.frequency() : 0.0f);
+
+        // as main.cpp queues them, at the end of the window
+        uint32_t ms = sample_ms((uint64_t)(w + 1) * W);
+        tm_window tw = tm_window_from((uint32_t)w, d.r, shown);
+        put(ms, PK_ROUTINE, TM_WINDOW, &tw, sizeof(tw));
+        if (shown != shown_was) {
+            tm_episode e = { (uint32_t)w, shown & ~shown_was, shown_was & ~shown, shown };
+            put(ms, PK_URGENT, TM_EPISODE, &e, sizeof(e));
+            shown_was = shown;
+        }
+        summary_hour h;
+        while (summary_take(summary, h)) put(ms, PK_ROUTINE, TM_HOUR, &h, sizeof(h));
+        // plausible WCET and DUTY records; only their size matters here
+        uint32_t wcet[7] = { 900u + (uint32_t)(w % 97), 2100, 0, 0, 4100u + (uint32_t)(w % 89), 6800, 0 };
+        uint32_t duty[5];
+        float dv[4] = { 97.1f, 0.9f, 1.6f, 0.4f };
+        memcpy(duty, dv, sizeof(dv));
+        duty[4] = W / WAKE_SAMPLES;
+        record(ms, 9, wcet, 7);
+        record(ms, 10, duty, 5);
+    }
+}
+
+// ======= LOOPBACK =======
+// Takes every packet, decodes it and checks each frame against the next
+// one queued at its priority.
+struct loopback {
+    uint32_t now_ms;
+    uint32_t fail_every;        // 0: reliable; n: every n-th send fails
+    uint32_t attempts;
+    uint64_t packets, bytes;
+    size_t next[PK_PRIORITIES]; // trace index of the next frame expected
+    uint64_t got[PK_PRIORITIES];
+    uint32_t worst_ms[PK_PRIORITIES];
+    uint64_t bad;
+    tm_decode_stats dec;
+};
+
+static void next_of(size_t &i, int prio) {
+    while (i < trace.size() && trace[i].prio != prio) i++;
+}
+
+// frame k of the trace carries seq k
+static void on_frame(void *ctx, const tm_frame &f) {
+    loopback &lb = *(loopback *)ctx;
+    int prio = f.type == TM_EPISODE ? PK_URGENT : PK_ROUTINE;
+    size_t &i = lb.next[prio];
+    next_of(i, prio);
+    if (i == trace.size()) {
+        lb.bad++;
+        return;
+    }
+    const queued &q = trace[i];
+    if (f.seq != (uint16_t)i || f.type != q.type || f.len != q.len || f.device != 42
+            || memcmp(f.payload, q.payload, q.len)) {
+        lb.bad++;
+    }
+    uint32_t late = lb.now_ms - q.ms;
+    if (late > lb.worst_ms[prio]) lb.worst_ms[prio] = late;
+    lb.got[prio]++;
+    i++;
+}
+
+static bool loopback_send(void *ctx, const uint8_t *p, size_t n) {
+    loopback &lb = *(loopback *)ctx;
+    lb.attempts++;
+    if (lb.fail_every && lb.attempts % lb.fail_every == 0) return false;
+    lb.packets++;
+    lb.bytes += n;
+    size_t used = tm_decode(p, n, &on_frame, &lb, lb.dec);
+    if (used != n) lb.bad++;
+    return true;
+}
+
+// ======= RUN =======
+struct outcome {
+    uint64_t packets, bytes;
+    uint32_t worst_ms[PK_PRIORITIES];
+    pk_stats st;
+    bool intact;
+};
+
+static packetizer pk;
+
+static outcome run(uint16_t mtu, uint32_t flush_ms, uint32_t fail_every) {
+    loopback lb;
+    memset(&lb, 0, sizeof(lb));
+    lb.fail_every = fail_every;
+    pk_config cfg = { mtu, flush_ms, 0 };
+    pk_init(pk, cfg, 42, &loopback_send, &lb);
+
+    // wake-ups every WAKE_SAMPLES samples; a window ends inside one
+    size_t k = 0;
+    uint64_t samples = 0;
+    while (k < trace.size()) {
+        samples += WAKE_SAMPLES;
+        uint32_t now = sample_ms(samples);
+        for (; k < trace.size() && trace[k].ms <= now; k++) {
+            const queued &q = trace[k];
+            pk_put(pk, q.prio, q.type, q.payload, q.len, q.ms);
+        }
+        lb.now_ms = now;
+        pk_poll(pk, now);
+    }
+    // the link goes on after the recording
+    for (int i=0; i < 1000 && (pk.q[PK_ROUTINE].frames || pk.q[PK_URGENT].frames); i++) {
+        samples += WAKE_SAMPLES;
+        lb.now_ms = sample_ms(samples);
+        pk_poll(pk, lb.now_ms);
+    }
+
+    outcome o;
+    o.packets = lb.packets;
+    o.bytes = lb.bytes;
+    memcpy(o.worst_ms, lb.worst_ms, sizeof(o.worst_ms));
+    o.st = pk.st;
+    size_t want[PK_PRIORITIES] = {};
+    for (const queued &q : trace) want[q.prio]++;
+    o.intact = !lb.bad && !lb.dec.crc_errors && !lb.dec.skipped
+            && lb.got[PK_ROUTINE] == want[PK_ROUTINE] && lb.got[PK_URGENT] == want[PK_URGENT]
+            && !pk.st.dropped[PK_ROUTINE] && !pk.st.dropped[PK_URGENT];
+    return o;
+}
+
+static double energy_mj(uint64_t packets, uint64_t bytes) {
+    return (packets * WAKE_UJ + bytes * BYTE_UJ) / 1000.0;
+}
+
+int main(int argc, char **argv) {
+    int hours = argc > 1 ? atoi(argv[1]) : 6;
+    uint32_t seed = argc > 2 ? (uint32_t)strtoul(argv[2], 0, 0) : 1;
+    if (hours <= 0) hours = 1;
+
+    make_trace(hours, seed);
+    uint64_t frames[PK_PRIORITIES] = {}, bytes = 0;
+    for (const queued &q : trace) {
+        frames[q.prio]++;
+        bytes += TM_HEADER + q.len + TM_TRAILER;
+    }
+    uint64_t all = frames[PK_ROUTINE] + frames[PK_URGENT];
+    printf("corpus: %d h, seed %lu: %llu frames (%llu urgent), %llu bytes, %.1f B/s\n",
+           hours, (unsigned long)seed, (unsigned long long)all,
+           (unsigned long long)frames[PK_URGENT], (unsigned long long)bytes,
+           bytes / (hours * 3600.0));
+    printf("radio model: %.0f uJ per packet + %.2f uJ per byte\n\n", WAKE_UJ, BYTE_UJ);
+
+    // one packet per frame, sent as queued
+    double base = energy_mj(all, bytes) / hours;
+    printf("%-9s %5s %8s | %8s %6s %6s | %8s %8s | %9s %7s\n", "link", "mtu", "flush",
+           "packets", "/hour", "fill", "urgent", "routine", "mJ/hour", "saving");
+    printf("%-9s %5s %8s | %8llu %6.0f %5.0fB | %6dms %6dms | %9.1f %7s\n", "unbatched",
+           "-", "-", (unsigned long long)all, (double)all / hours, (double)bytes / all,
+           0, 0, base, "-");
+
+    struct cfg { uint16_t mtu; uint32_t flush_ms; uint32_t fail_every; };
+    const cfg runs[] = {
+        { 244, 0, 0 }, { 244, 1000, 0 }, { 244, 3000, 0 }, { 244, 10000, 0 },
+        { 244, 30000, 0 }, { 244, 60000, 0 },
+        { 64, 30000, 0 }, { 128, 30000, 0 }, { 512, 30000, 0 },
+        { 244, 30000, 10 },
+    };
+    // a packet is sent at the first wake-up at or after it is due
+    const uint32_t wake_ms = sample_ms(WAKE_SAMPLES) + 1;
+
+    bool ok = true;
+    for (const cfg &c : runs) {
+        outcome o = run(c.mtu, c.flush_ms, c.fail_every);
+        bool in_time = c.fail_every
+                    || (o.worst_ms[PK_URGENT] <= wake_ms && o.worst_ms[PK_ROUTINE] <= c.flush_ms + wake_ms);
+        ok = ok && o.intact && in_time;
+        double e = energy_mj(o.packets, o.bytes) / hours;
+        char link[16];
+        if (c.fail_every) snprintf(link, sizeof(link), "1/%u fail", c.fail_every);
+        else              snprintf(link, sizeof(link), "reliable");
+        printf("%-9s %5u %6.0fs | %8llu %6.0f %5.0fB | %6ums %6ums | %9.1f %6.1f%%%s%s\n",
+               link, c.mtu, c.flush_ms / 1000.0, (unsigned long long)o.packets,
+               (double)o.packets / hours, o.packets ? (double)o.bytes / o.packets : 0.0,
+               o.worst_ms[PK_URGENT], o.worst_ms[PK_ROUTINE], e, 100.0 * (1.0 - e / base),
+               o.intact ? "" : "  LOST", in_time ? "" : "  LATE");
+        if (c.mtu == 244 && c.flush_ms == 30000 && !c.fail_every)
+            printf("%33s sent because full %u, routine due %u, urgent %u\n", "",
+                   o.st.full, o.st.due, o.st.urgent);
+    }
+    printf("\nstate: %zu bytes\n", sizeof(packetizer));
+    printf("\n%s\n", ok ? "every frame delivered once, in order, within its bound"
+                        : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,243 @@
+// ========= HOST REPLAY =========
+// Reruns data captured on the board through the same detector code.
+//
+//   pio run -e replay && .pio/build/replay/program < serial_log.txt
+//
+// Input is a serial log. Two kinds of block are recognised:
+//   WCDUMP  worst-case analysis window (sent on 'd'), decoded bit-exact
+//           and analysed again with host timing.
+//   FRDUMP  flight-recorder capture around an episode. The window that
+//           fired is re-analysed from the raw samples, and the capture is
+//           recorded again through a host flight recorder to check the
+//           block layout and measure recorder throughput. The gyro
+//           bias of the GBIAS line before it is taken off, as on the
+//           board.
+// The per-hop SCORE lines are also fed through a host copy of the vote,
+// which must reproduce every VOTE line exactly. Worst-case windows also
+// go through a tremor tracker (tools/tracker has the full evaluation).
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <chrono>
+
+#include "board_graph.h"
+#include "wcet_monitor.h"
+#include "imu.h"
+#include "gyro_bias.h"
+#include "flight_recorder.h"
+#include "vote.h"
+#include "tremor_tracker.h"
+
+static uint32_t host_clock() {
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<nanoseconds>(
+        steady_clock::now().time_since_epoch()).count();
+}
+
+static board_detector detector;
+
+typedef board_detector::sample_t sample_t;
+
+static sample_t accel[board_detector::raw_samples];
+static sample_t gyro[board_detector::raw_samples];
+
+static int16_t raw[FR_LENGTH][IMU_AXES];
+
+static wcet_stage host;
+
+static board_vote vote;
+
+static gyro_bias bias;          // from the last GBIAS line
+
+static TremorTracker<board_detector> tracker;
+
+static void print_result(const detector_result &r) {
+    printf("  Tremor=%.3f  Dysk=%.3f  FogRatio=%.3f  Walk=%.3f\n",
+           r.tremor, r.dysk, r.fog_ratio, r.walk);
+    printf("  Freeze=%d  Is tremor?=%d  Is dysk?=%d\n",
+           r.freezing, r.is_tremor, r.is_dysk);
+}
+
+// ======= WORST-CASE WINDOW =======
+static bool replay_window(const char *line, int index) {
+    unsigned long len, cycles, hz;
+    sscanf(line, "WCDUMP BEGIN %lu %lu %lu", &len, &cycles, &hz);
+
+    if (len != board_detector::raw_samples) {
+        fprintf(stderr, "window of %lu samples, detector expects %d\n",
+                len, (int)board_detector::raw_samples);
+        return false;
+    }
+
+    char buf[128];
+    uint32_t n = 0;
+    while (n < len && fgets(buf, sizeof(buf), stdin)) {
+        unsigned long a, g;
+        if (sscanf(buf, "%lx %lx", &a, &g) != 2) break;
+        uint32_t ab = (uint32_t)a, gb = (uint32_t)g;
+        float af, gf;
+        memcpy(&af, &ab, 4);
+        memcpy(&gf, &gb, 4);
+        accel[n] = (sample_t)af;
+        gyro[n]  = (sample_t)gf;
+        n++;
+    }
+    if (n != len) {
+        fprintf(stderr, "truncated window (%lu of %lu samples)\n",
+                (unsigned long)n, len);
+        return false;
+    }
+
+    // the hops before it are not in the dump: each window seeds the
+    // board's band-power average afresh
+    board_detector_init(detector);
+    detector_result r;
+    wcet_begin(host);
+    detector.analyze(accel, gyro, r, tracker);     // as the board, tracker included
+    wcet_end(host);
+
+    printf("window %d: device %lu cycles (%.1f us)  host %.1f us\n",
+           index, cycles, 1e6 * cycles / (double)hz, host.last / 1e3);
+    print_result(r);
+
+    printf("  track lock=%d f=%.3fHz amp=%.1f\n",
+           tracker.locked(), tracker.frequency(), tracker.amplitude());
+    return true;
+}
+
+// ======= FLIGHT RECORDER CAPTURE =======
+static bool replay_capture(const char *line) {
+    unsigned long seq, reason, trig;
+    unsigned pre, post, lag;
+    sscanf(line, "FRDUMP BEGIN %lu %lu %lu %u %u %u",
+           &seq, &reason, &trig, &pre, &post, &lag);
+
+    if (pre > FR_PRE || post > FR_POST) {
+        fprintf(stderr, "capture %lu larger than this build's recorder\n", seq);
+        return false;
+    }
+
+    char buf[128];
+    unsigned total = pre + post, n = 0;
+    while (n < total && fgets(buf, sizeof(buf), stdin)) {
+        unsigned v[IMU_AXES];
+        if (sscanf(buf, "%x %x %x %x %x %x",
+                   &v[0], &v[1], &v[2], &v[3], &v[4], &v[5]) != IMU_AXES) break;
+        for (int a=0; a < IMU_AXES; a++) raw[n][a] = (int16_t)(uint16_t)v[a];
+        n++;
+    }
+    if (n != total) {
+        fprintf(stderr, "truncated capture %lu (%u of %u samples)\n", seq, n, total);
+        return false;
+    }
+
+    printf("capture %lu: reason=%s%s%s  %u pre + %u post samples\n", seq,
+           reason & FR_TREMOR ? "tremor " : "",
+           reason & FR_DYSK   ? "dysk "   : "",
+           reason & FR_FREEZE ? "freeze " : "", pre, post);
+
+    // the analysis window that fired ends lag samples before the trigger
+    int end = (int)pre - (int)lag;
+    int begin = end - board_detector::raw_samples;
+    if (begin >= 0) {
+        for (int i=0; i < board_detector::raw_samples; i++) {
+            accel[i] = (sample_t)imu_accel_magnitude(raw[begin + i]);
+            gyro[i]  = (sample_t)gyro_bias_magnitude(bias, raw[begin + i]);
+        }
+        board_detector_init(detector);
+        detector_result r;
+        detector.analyze(accel, gyro, r);
+        print_result(r);
+    } else {
+        printf("  (window that fired is not fully inside the capture)\n");
+    }
+
+    // record it again on the host and compare block contents
+    flight_init();
+    auto t0 = std::chrono::steady_clock::now();
+    for (unsigned i=0; i < pre; i++) flight_push(raw[i]);
+    flight_trigger((uint32_t)reason, lag);
+    for (unsigned i=pre; i < total; i++) flight_push(raw[i]);
+    auto t1 = std::chrono::steady_clock::now();
+
+    flight_block *b = flight_next();
+    bool same = b && b->pre == pre && b->post == post;
+    for (unsigned i=0; same && i < total; i++)
+        same = memcmp(flight_sample(b, i), raw[i], sizeof(raw[0])) == 0;
+    if (b) flight_release(b);
+
+    double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / total;
+    printf("  re-record %s, %.1f ns/sample (%.0f ksamples/s)\n",
+           same ? "identical" : "MISMATCH", ns, 1e6 / ns);
+    return same;
+}
+
+static void read_bias(const char *line) {
+    float b[3];
+    if (sscanf(line, "GBIAS %f %f %f", &b[0], &b[1], &b[2]) == 3)
+        memcpy(bias.bias, b, sizeof(b));
+}
+
+// ======= VOTE =======
+static bool replay_score(const char *line) {
+    int s[SYM_COUNT];
+    if (sscanf(line, "SCORE %d %d %d %d", &s[0], &s[1], &s[2], &s[3]) != SYM_COUNT)
+        return false;
+    int16_t score[SYM_COUNT];
+    for (int i=0; i < SYM_COUNT; i++) score[i] = (int16_t)s[i];
+    vote.push(score);
+    return true;
+}
+
+static bool check_vote(const char *line, int hop) {
+    int c[SYM_COUNT];
+    unsigned mask;
+    if (sscanf(line, "VOTE %d %d %d %d %x", &c[0], &c[1], &c[2], &c[3], &mask)
+        != SYM_COUNT + 1)
+        return false;
+
+    bool same = mask == vote.active_mask();
+    for (int i=0; i < SYM_COUNT; i++) same = same && c[i] == vote.confidence(i);
+    if (!same)
+        printf("hop %d: vote MISMATCH  device %d %d %d %d %x  host %d %d %d %d %x\n",
+               hop, c[0], c[1], c[2], c[3], mask,
+               vote.confidence(0), vote.confidence(1), vote.confidence(2),
+               vote.confidence(3), (unsigned)vote.active_mask());
+    return same;
+}
+
+int main() {
+    tracker.init();
+    gyro_bias_init(bias);
+    cycle_clock_set(&host_clock, 1000000000u);
+    wcet_stage_init(host, "host", 0xFFFFFFFFu);
+
+    char line[128];
+    int windows = 0, captures = 0, failed = 0;
+    int hops = 0, votes_bad = 0;
+
+    while (fgets(line, sizeof(line), stdin)) {
+        if (strncmp(line, "WCDUMP BEGIN", 12) == 0) {
+            if (replay_window(line, windows)) windows++; else failed++;
+        }
+        else if (strncmp(line, "FRDUMP BEGIN", 12) == 0) {
+            if (replay_capture(line)) captures++; else failed++;
+        }
+        else if (strncmp(line, "GBIAS ", 6) == 0) {
+            read_bias(line);
+        }
+        else if (strncmp(line, "SCORE ", 6) == 0) {
+            if (replay_score(line)) hops++;
+        }
+        else if (strncmp(line, "VOTE ", 5) == 0) {
+            if (!check_vote(line, hops)) votes_bad++;
+        }
+    }
+
+    printf("%d window(s), %d capture(s) replayed, %d failed, host worst %.1f us\n",
+           windows, captures, failed, host.worst / 1e3);
+    if (hops)
+        printf("%d hop(s) voted, %d vote mismatch(es)\n", hops, votes_bad);
+    return (windows + captures + hops) && !failed && !votes_bad ? 0 : 1;
+}
@@ -0,0 +1,175 @@
+// ========= IN-PLACE REAL FFT =========
+// Checks the in-place real FFTs (arm_rfft_fast_inplace_f32 / _f16,
+// arm_rfft_inplace_q15 / _q31) against the out-of-place ones over every
+// supported length, forward and inverse, on random signals, and times
+// the f32 pair at the board detector's length.
+//
+//   pio run -e rfftcheck && .pio/build/rfftcheck/program [iterations]
+//
+// The in-place kernels do the same arithmetic in the same order, so the
+// results must be bit-exact; exit status 1 on any difference. The fixed
+// point ones keep only the packed half spectrum (DC, Nyquist, then bins
+// 1 to N/2-1), which is what is compared.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+#include "arm_math.h"
+#include "arm_math_f16.h"
+
+static const int MAX_N = 8192;
+
+static float32_t in_f32[MAX_N], ref_f32[MAX_N], p_f32[MAX_N];
+static q31_t in_q31[MAX_N], ref_q31[2 * MAX_N], p_q31[MAX_N];
+static q15_t in_q15[MAX_N], ref_q15[2 * MAX_N], p_q15[MAX_N];
+#if defined(ARM_FLOAT16_SUPPORTED)
+static float16_t in_f16[MAX_N], ref_f16[MAX_N], p_f16[MAX_N];
+#endif
+
+static unsigned seed = 1;
+static float rnd() {
+    seed = seed * 1664525u + 1013904223u;
+    return (float)(seed >> 8) / 16777216.0f * 2.0f - 1.0f;
+}
+
+static bool ok = true;
+
+static void report(const char *name, int n, int ifft, long diffs) {
+    if (diffs) {
+        ok = false;
+        printf("%-28s N=%-5d %s  %ld values differ  FAIL\n", name, n, ifft ? "inverse" : "forward", diffs);
+    }
+}
+
+static long count_diff(const void *a, const void *b, int n, size_t size) {
+    long d = 0;
+    const char *x = (const char *)a, *y = (const char *)b;
+    for (int i=0; i < n; i++)
+        if (memcmp(x + i * size, y + i * size, size)) d++;
+    return d;
+}
+
+// Full spectrum of the out-of-place fixed-point RFFT to the packed
+// in-place layout and back.
+template <class T>
+static void pack(const T *full, T *packed, int n) {
+    memcpy(packed, full, n * sizeof(T));
+    packed[1] = full[n];
+}
+
+template <class T>
+static void unpack(const T *packed, T *full, int n) {
+    memcpy(full, packed, n * sizeof(T));
+    full[1] = 0;
+    full[n] = packed[1];
+    full[n + 1] = 0;
+}
+
+static void check_f32(int n) {
+    arm_rfft_fast_instance_f32 S;
+    arm_rfft_fast_init_f32(&S, n);
+    for (int ifft=0; ifft < 2; ifft++) {
+        for (int i=0; i < n; i++) in_f32[i] = rnd();
+        memcpy(p_f32, in_f32, sizeof(float32_t) * n);
+        arm_rfft_fast_f32(&S, in_f32, ref_f32, ifft);        // clobbers in_f32
+        arm_rfft_fast_inplace_f32(&S, p_f32, ifft);
+        report("arm_rfft_fast_inplace_f32", n, ifft, count_diff(ref_f32, p_f32, n, sizeof(float32_t)));
+    }
+}
+
+#if defined(ARM_FLOAT16_SUPPORTED)
+static void check_f16(int n) {
+    arm_rfft_fast_instance_f16 S;
+    arm_rfft_fast_init_f16(&S, n);
+    for (int ifft=0; ifft < 2; ifft++) {
+        for (int i=0; i < n; i++) in_f16[i] = (float16_t)rnd();
+        memcpy(p_f16, in_f16, sizeof(float16_t) * n);
+        arm_rfft_fast_f16(&S, in_f16, ref_f16, ifft);
+        arm_rfft_fast_inplace_f16(&S, p_f16, ifft);
+        report("arm_rfft_fast_inplace_f16", n, ifft, count_diff(ref_f16, p_f16, n, sizeof(float16_t)));
+    }
+}
+#endif
+
+static void check_q15(int n) {
+    arm_rfft_instance_q15 fwd, inv;
+    arm_rfft_init_q15(&fwd, n, 0, 1);
+    arm_rfft_init_q15(&inv, n, 1, 1);
+
+    for (int i=0; i < n; i++) in_q15[i] = (q15_t)(rnd() * 32767.0f);
+    memcpy(p_q15, in_q15, sizeof(q15_t) * n);
+    arm_rfft_q15(&fwd, in_q15, ref_q15);
+    arm_rfft_inplace_q15(&fwd, p_q15);
+    pack(ref_q15, in_q15, n);
+    report("arm_rfft_inplace_q15", n, 0, count_diff(in_q15, p_q15, n, sizeof(q15_t)));
+
+    // inverse of the spectrum just computed
+    unpack(p_q15, in_q15, n);
+    arm_rfft_q15(&inv, in_q15, ref_q15);
+    arm_rfft_inplace_q15(&inv, p_q15);
+    report("arm_rfft_inplace_q15", n, 1, count_diff(ref_q15, p_q15, n, sizeof(q15_t)));
+}
+
+static void check_q31(int n) {
+    arm_rfft_instance_q31 fwd, inv;
+    arm_rfft_init_q31(&fwd, n, 0, 1);
+    arm_rfft_init_q31(&inv, n, 1, 1);
+
+    for (int i=0; i < n; i++) in_q31[i] = (q31_t)(rnd() * 2147483520.0f);
+    memcpy(p_q31, in_q31, sizeof(q31_t) * n);
+    arm_rfft_q31(&fwd, in_q31, ref_q31);
+    arm_rfft_inplace_q31(&fwd, p_q31);
+    pack(ref_q31, in_q31, n);
+    report("arm_rfft_inplace_q31", n, 0, count_diff(in_q31, p_q31, n, sizeof(q31_t)));
+
+    unpack(p_q31, in_q31, n);
+    arm_rfft_q31(&inv, in_q31, ref_q31);
+    arm_rfft_inplace_q31(&inv, p_q31);
+    report("arm_rfft_inplace_q31", n, 1, count_diff(ref_q31, p_q31, n, sizeof(q31_t)));
+}
+
+template <class F>
+static double ns_per_call(F fn, int iterations) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i=0; i < iterations; i++) fn();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / iterations;
+}
+
+int main(int argc, char **argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 20000;
+    if (iterations <= 0) iterations = 1;
+
+    int lengths = 0;
+    for (int n=32; n <= MAX_N; n *= 2) {
+        if (n <= 4096) {
+            check_f32(n);
+#if defined(ARM_FLOAT16_SUPPORTED)
+            check_f16(n);
+#endif
+        }
+        check_q15(n);
+        check_q31(n);
+        lengths++;
+    }
+    printf("%d lengths, forward and inverse: %s\n", lengths, ok ? "bit-exact" : "MISMATCH");
+
+    // the detector's transform: 256 points, 1 KiB of f32 output saved
+    const int N = 256;
+    arm_rfft_fast_instance_f32 S;
+    arm_rfft_fast_init_f32(&S, N);
+    for (int i=0; i < N; i++) in_f32[i] = rnd();
+    double out_of_place = ns_per_call([&] {
+        memcpy(p_f32, in_f32, sizeof(float32_t) * N);
+        arm_rfft_fast_f32(&S, p_f32, ref_f32, 0);
+    }, iterations);
+    double in_place = ns_per_call([&] {
+        memcpy(p_f32, in_f32, sizeof(float32_t) * N);
+        arm_rfft_fast_inplace_f32(&S, p_f32, 0);
+    }, iterations);
+    printf("N=%d f32: out-of-place %.0f ns, in-place %.0f ns, buffer saved %u bytes\n",
+           N, out_of_place, in_place, (unsigned)(sizeof(float32_t) * N));
+    return ok ? 0 : 1;
+}
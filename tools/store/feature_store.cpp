@@ -0,0 +1,595 @@
+#include "feature_store.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// ======= ROWS =======
+feature_row feature_row_from(int64_t t_ms, const detector_result &r, uint32_t active) {
+    feature_row f;
+    f.t_ms = t_ms;
+    f.tremor = r.tremor;
+    f.dysk = r.dysk;
+    f.walk = r.walk;
+    f.fog = r.fog;
+    f.fog_ratio = r.fog_ratio;
+    f.flags = (r.tremor_present ? FS_FLAG_TREMOR_PRESENT : 0)
+            | (r.freezing       ? FS_FLAG_FREEZING : 0)
+            | (r.is_tremor      ? FS_FLAG_IS_TREMOR : 0)
+            | (r.is_dysk        ? FS_FLAG_IS_DYSK : 0)
+            | active << 8;
+    for (int s=0; s < SYM_COUNT; s++) f.score[s] = r.score[s];
+    return f;
+}
+
+double feature_value(const feature_row &r, int col) {
+    switch (col) {
+    case FS_TIME:      return (double)r.t_ms;
+    case FS_TREMOR:    return r.tremor;
+    case FS_DYSK:      return r.dysk;
+    case FS_WALK:      return r.walk;
+    case FS_FOG:       return r.fog;
+    case FS_FOG_RATIO: return r.fog_ratio;
+    case FS_FLAGS:     return r.flags;
+    default:           return r.score[col - FS_SCORE];
+    }
+}
+
+const char *feature_column_name(int col) {
+    static const char *const names[FS_COLUMNS] = {
+        "time", "tremor", "dysk", "walk", "fog", "fog_ratio", "flags",
+        "score_tremor", "score_dysk", "score_freeze", "score_present",
+    };
+    static_assert(FS_COLUMNS == 11, "column names out of date");
+    return col >= 0 && col < FS_COLUMNS ? names[col] : "?";
+}
+
+static bool is_float(int col) { return col >= FS_TREMOR && col <= FS_FOG_RATIO; }
+
+static float *float_field(feature_row &r, int col) {
+    switch (col) {
+    case FS_TREMOR: return &r.tremor;
+    case FS_DYSK:   return &r.dysk;
+    case FS_WALK:   return &r.walk;
+    case FS_FOG:    return &r.fog;
+    default:        return &r.fog_ratio;
+    }
+}
+
+static float float_field(const feature_row &r, int col) {
+    return *float_field(const_cast<feature_row &>(r), col);
+}
+
+static int64_t int_field(const feature_row &r, int col) {
+    return col == FS_FLAGS ? (int64_t)r.flags : (int64_t)r.score[col - FS_SCORE];
+}
+
+static void set_int_field(feature_row &r, int col, int64_t v) {
+    if (col == FS_FLAGS) r.flags = (uint32_t)v;
+    else                 r.score[col - FS_SCORE] = (int16_t)v;
+}
+
+// ======= CRC-32 (IEEE) =======
+struct crc_table {
+    uint32_t t[256];
+    crc_table() {
+        for (uint32_t i=0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k=0; k < 8; k++) c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+    }
+};
+
+static uint32_t crc32(const void *data, size_t n) {
+    static const crc_table table;       // built once, thread-safe
+    const uint8_t *p = (const uint8_t *)data;
+    uint32_t c = 0xFFFFFFFFu;
+    for (size_t i=0; i < n; i++) c = table.t[(c ^ p[i]) & 0xFF] ^ (c >> 8);
+    return c ^ 0xFFFFFFFFu;
+}
+
+static uint32_t header_crc(const fs_block_header &b) {
+    fs_block_header h = b;
+    h.crc = 0;
+    return crc32(&h, sizeof(h));
+}
+
+static bool column_ok(const fs_block_header &b, const uint8_t *payload, int col) {
+    const fs_column_index &ci = b.col[col];
+    return ci.offset + ci.bytes <= b.bytes && crc32(payload + ci.offset, ci.bytes) == ci.crc;
+}
+
+// ======= VARINTS =======
+static uint64_t zigzag(int64_t v)   { return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63); }
+static int64_t  unzigzag(uint64_t u) { return (int64_t)(u >> 1) ^ -(int64_t)(u & 1); }
+
+static void put_varint(std::vector<uint8_t> &out, uint64_t u) {
+    while (u >= 0x80) {
+        out.push_back((uint8_t)(u | 0x80));
+        u >>= 7;
+    }
+    out.push_back((uint8_t)u);
+}
+
+static bool get_varint(const uint8_t *&p, const uint8_t *end, uint64_t &u) {
+    u = 0;
+    for (int shift=0; p < end && shift < 64; shift += 7) {
+        uint8_t b = *p++;
+        u |= (uint64_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+// ======= BITS =======
+struct bit_writer {
+    std::vector<uint8_t> &out;
+    uint64_t acc;
+    int n;
+
+    explicit bit_writer(std::vector<uint8_t> &o) : out(o), acc(0), n(0) {}
+
+    void put(uint32_t v, int bits) {
+        acc = (acc << bits) | (v & (uint32_t)((1ull << bits) - 1));
+        n += bits;
+        while (n >= 8) {
+            n -= 8;
+            out.push_back((uint8_t)(acc >> n));
+        }
+    }
+    void finish() {
+        if (n) out.push_back((uint8_t)(acc << (8 - n)));
+        n = 0;
+    }
+};
+
+struct bit_reader {
+    const uint8_t *p, *end;
+    uint64_t acc;
+    int n;
+
+    bit_reader(const uint8_t *b, const uint8_t *e) : p(b), end(e), acc(0), n(0) {}
+
+    uint32_t get(int bits) {
+        while (n < bits) {
+            acc = (acc << 8) | (p < end ? *p++ : 0);
+            n += 8;
+        }
+        n -= bits;
+        return (uint32_t)((acc >> n) & ((1ull << bits) - 1));
+    }
+};
+
+// ======= COLUMN CODECS =======
+static void encode_times(const std::vector<feature_row> &rows, std::vector<uint8_t> &out) {
+    int64_t prev = rows[0].t_ms, delta = 0;
+    for (int k=0; k < 8; k++) out.push_back((uint8_t)((uint64_t)prev >> (8 * k)));
+    for (size_t i=1; i < rows.size(); i++) {
+        int64_t d = rows[i].t_ms - prev;
+        put_varint(out, zigzag(d - delta));
+        delta = d;
+        prev = rows[i].t_ms;
+    }
+}
+
+static bool decode_times(const uint8_t *p, const uint8_t *end, uint32_t rows, int64_t *t) {
+    if (end - p < 8) return false;
+    uint64_t first = 0;
+    for (int k=0; k < 8; k++) first |= (uint64_t)p[k] << (8 * k);
+    p += 8;
+    int64_t prev = (int64_t)first, delta = 0;
+    t[0] = prev;
+    for (uint32_t i=1; i < rows; i++) {
+        uint64_t u;
+        if (!get_varint(p, end, u)) return false;
+        delta += unzigzag(u);
+        prev += delta;
+        t[i] = prev;
+    }
+    return true;
+}
+
+static uint32_t float_bits(float f) { uint32_t u; memcpy(&u, &f, 4); return u; }
+static float bits_float(uint32_t u) { float f; memcpy(&f, &u, 4); return f; }
+
+// Control bits per value: 0 = same as the previous value; 10 = XOR fits
+// the previous leading / meaningful window; 11 = new window, 5 bits of
+// leading zeros and 5 bits of length - 1, then the meaningful bits.
+static void encode_float(const std::vector<feature_row> &rows, int col, std::vector<uint8_t> &out) {
+    bit_writer w(out);
+    uint32_t prev = float_bits(float_field(rows[0], col));
+    w.put(prev, 32);
+    int lead = -1, len = 0;
+    for (size_t i=1; i < rows.size(); i++) {
+        uint32_t v = float_bits(float_field(rows[i], col));
+        uint32_t x = v ^ prev;
+        prev = v;
+        if (!x) {
+            w.put(0, 1);
+            continue;
+        }
+        int l = __builtin_clz(x), t = __builtin_ctz(x);
+        if (lead >= 0 && l >= lead && t >= 32 - lead - len) {
+            w.put(2, 2);
+            w.put(x >> (32 - lead - len), len);
+        } else {
+            if (l > 31) l = 31;
+            lead = l;
+            len = 32 - l - t;
+            w.put(3, 2);
+            w.put((uint32_t)lead, 5);
+            w.put((uint32_t)(len - 1), 5);
+            w.put(x >> t, len);
+        }
+    }
+    w.finish();
+}
+
+static void decode_float(const uint8_t *p, const uint8_t *end, uint32_t rows, double *v) {
+    bit_reader r(p, end);
+    uint32_t prev = r.get(32);
+    v[0] = bits_float(prev);
+    int lead = 0, len = 0;
+    for (uint32_t i=1; i < rows; i++) {
+        if (r.get(1)) {
+            if (r.get(1)) {
+                lead = (int)r.get(5);
+                len = (int)r.get(5) + 1;
+            }
+            prev ^= r.get(len) << (32 - lead - len);
+        }
+        v[i] = bits_float(prev);
+    }
+}
+
+static void encode_int(const std::vector<feature_row> &rows, int col, std::vector<uint8_t> &out) {
+    int64_t prev = 0;
+    for (const feature_row &r : rows) {
+        int64_t v = int_field(r, col);
+        put_varint(out, zigzag(v - prev));
+        prev = v;
+    }
+}
+
+static bool decode_int(const uint8_t *p, const uint8_t *end, uint32_t rows, double *v) {
+    int64_t prev = 0;
+    for (uint32_t i=0; i < rows; i++) {
+        uint64_t u;
+        if (!get_varint(p, end, u)) return false;
+        prev += unzigzag(u);
+        v[i] = (double)prev;
+    }
+    return true;
+}
+
+// ======= WRITER =======
+bool FeatureWriter::open(const char *path, uint32_t block_span_s, uint32_t block_rows) {
+    close();
+    fd = ::open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return false;
+
+    written = 0;
+    last_t = INT64_MIN;
+    pending.clear();
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) { close(); return false; }
+
+    if (st.st_size == 0) {
+        hdr.magic = FS_FILE_MAGIC;
+        hdr.version = 1;
+        hdr.columns = FS_COLUMNS;
+        hdr.block_span_s = block_span_s ? block_span_s : 3600;
+        hdr.block_rows = block_rows ? block_rows : 4096;
+        if (pwrite(fd, &hdr, sizeof(hdr), 0) != (ssize_t)sizeof(hdr)) { close(); return false; }
+        file_bytes = sizeof(hdr);
+    } else {
+        if (pread(fd, &hdr, sizeof(hdr), 0) != (ssize_t)sizeof(hdr)
+            || hdr.magic != FS_FILE_MAGIC || hdr.columns != FS_COLUMNS) {
+            close();
+            return false;
+        }
+        // Walk the block headers; the first one that is cut short or
+        // damaged ends the file. Only the last block can be torn, so
+        // only its columns are checked.
+        uint64_t pos = sizeof(hdr), last_pos = 0;
+        int64_t before_last = INT64_MIN;
+        fs_block_header b, last;
+        while (pos + sizeof(b) <= (uint64_t)st.st_size
+               && pread(fd, &b, sizeof(b), (off_t)pos) == (ssize_t)sizeof(b)
+               && b.magic == FS_BLOCK_MAGIC && header_crc(b) == b.crc
+               && pos + sizeof(b) + b.bytes <= (uint64_t)st.st_size) {
+            written += b.rows;
+            before_last = last_t;
+            last_t = b.t_max;
+            last = b;
+            last_pos = pos;
+            pos += sizeof(b) + b.bytes;
+        }
+        if (last_pos) {
+            payload.resize(last.bytes);
+            bool ok = pread(fd, payload.data(), last.bytes, (off_t)(last_pos + sizeof(last)))
+                      == (ssize_t)last.bytes;
+            for (int c=0; ok && c < FS_COLUMNS; c++) ok = column_ok(last, payload.data(), c);
+            if (!ok) {
+                written -= last.rows;
+                last_t = before_last;
+                pos = last_pos;
+            }
+        }
+        if (pos != (uint64_t)st.st_size && ftruncate(fd, (off_t)pos) != 0) { close(); return false; }
+        file_bytes = pos;
+    }
+    span_ms = (int64_t)hdr.block_span_s * 1000;
+    return true;
+}
+
+static int64_t span_of(int64_t t, int64_t span_ms) {
+    return t >= 0 ? t / span_ms : -((-t + span_ms - 1) / span_ms);
+}
+
+bool FeatureWriter::append(const feature_row &r) {
+    if (fd < 0 || r.t_ms < last_t) return false;
+    if (!pending.empty()
+        && (pending.size() >= hdr.block_rows
+            || span_of(r.t_ms, span_ms) != span_of(pending[0].t_ms, span_ms))) {
+        if (!flush()) return false;
+    }
+    pending.push_back(r);
+    last_t = r.t_ms;
+    return true;
+}
+
+bool FeatureWriter::flush(bool sync) {
+    if (fd < 0) return false;
+    if (pending.empty()) return !sync || fsync(fd) == 0;
+
+    fs_block_header b;
+    memset(&b, 0, sizeof(b));
+    b.magic = FS_BLOCK_MAGIC;
+    b.rows = (uint32_t)pending.size();
+    b.t_min = pending.front().t_ms;
+    b.t_max = pending.back().t_ms;
+
+    payload.assign(sizeof(b), 0);
+    for (int c=0; c < FS_COLUMNS; c++) {
+        fs_column_index &ci = b.col[c];
+        ci.offset = (uint32_t)(payload.size() - sizeof(b));
+        ci.min = INFINITY;
+        ci.max = -INFINITY;
+        ci.sum = 0;
+        for (const feature_row &r : pending) {
+            double v = feature_value(r, c);
+            if (v < ci.min) ci.min = v;
+            if (v > ci.max) ci.max = v;
+            ci.sum += v;
+        }
+        if (c == FS_TIME)     encode_times(pending, payload);
+        else if (is_float(c)) encode_float(pending, c, payload);
+        else                  encode_int(pending, c, payload);
+        ci.bytes = (uint32_t)(payload.size() - sizeof(b)) - ci.offset;
+        ci.crc = crc32(payload.data() + sizeof(b) + ci.offset, ci.bytes);
+    }
+    // keep the next header 8-byte aligned in the mapping
+    while (payload.size() % 8) payload.push_back(0);
+    b.bytes = (uint32_t)(payload.size() - sizeof(b));
+    b.crc = header_crc(b);
+    memcpy(payload.data(), &b, sizeof(b));
+
+    if (pwrite(fd, payload.data(), payload.size(), (off_t)file_bytes) != (ssize_t)payload.size())
+        return false;
+    file_bytes += payload.size();
+    written += pending.size();
+    pending.clear();
+    return !sync || fsync(fd) == 0;
+}
+
+void FeatureWriter::close() {
+    if (fd < 0) return;
+    flush();
+    ::close(fd);
+    fd = -1;
+}
+
+// ======= READER =======
+bool FeatureReader::open(const char *path) {
+    close();
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(fs_file_header)) {
+        ::close(fd);
+        return false;
+    }
+    void *m = mmap(0, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (m == MAP_FAILED) return false;
+    base = (const uint8_t *)m;
+    size = (size_t)st.st_size;
+
+    if (file().magic != FS_FILE_MAGIC || file().columns != FS_COLUMNS) {
+        close();
+        return false;
+    }
+
+    // Headers only; column CRCs are checked when a column is decoded,
+    // so opening a file does not read it all.
+    size_t pos = sizeof(fs_file_header);
+    while (pos + sizeof(fs_block_header) <= size) {
+        const fs_block_header &b = *(const fs_block_header *)(base + pos);
+        if (b.magic != FS_BLOCK_MAGIC || header_crc(b) != b.crc
+            || pos + sizeof(b) + b.bytes > size)
+            break;
+        index.push_back(pos);
+        total_rows += b.rows;
+        pos += sizeof(b) + b.bytes;
+    }
+    reset_stats();
+    return true;
+}
+
+void FeatureReader::close() {
+    if (base) munmap((void *)base, size);
+    base = 0;
+    size = 0;
+    index.clear();
+    total_rows = 0;
+}
+
+void FeatureReader::reset_stats() { memset(&scan, 0, sizeof(scan)); }
+
+uint64_t FeatureReader::column_bytes(int col) const {
+    uint64_t n = 0;
+    for (size_t b=0; b < index.size(); b++) n += header(b).col[col].bytes;
+    return n;
+}
+
+// Blocks [first, last) that can hold rows in [t0, t1): blocks are in
+// time order, so two binary searches.
+void FeatureReader::range(int64_t t0, int64_t t1, size_t &first, size_t &last) const {
+    size_t lo = 0, hi = index.size();
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (header(mid).t_max < t0) lo = mid + 1;
+        else                        hi = mid;
+    }
+    first = lo;
+    hi = index.size();
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (header(mid).t_min < t1) lo = mid + 1;
+        else                        hi = mid;
+    }
+    last = lo;
+}
+
+bool FeatureReader::decode_time(size_t b) {
+    const fs_block_header &h = header(b);
+    const uint8_t *payload = (const uint8_t *)&h + sizeof(h);
+    if (!column_ok(h, payload, FS_TIME)) {
+        scan.crc_errors++;
+        return false;
+    }
+    const fs_column_index &ci = h.col[FS_TIME];
+    t_buf.resize(h.rows);
+    scan.blocks_decoded++;
+    scan.rows_decoded += h.rows;
+    scan.bytes_decoded += ci.bytes;
+    return decode_times(payload + ci.offset, payload + ci.offset + ci.bytes, h.rows, t_buf.data());
+}
+
+bool FeatureReader::decode_column(size_t b, int col) {
+    const fs_block_header &h = header(b);
+    const uint8_t *payload = (const uint8_t *)&h + sizeof(h);
+    if (!column_ok(h, payload, col)) {
+        scan.crc_errors++;
+        return false;
+    }
+    const fs_column_index &ci = h.col[col];
+    v_buf.resize(h.rows);
+    scan.bytes_decoded += ci.bytes;
+    const uint8_t *p = payload + ci.offset, *end = p + ci.bytes;
+    if (is_float(col)) {
+        decode_float(p, end, h.rows, v_buf.data());
+        return true;
+    }
+    return decode_int(p, end, h.rows, v_buf.data());
+}
+
+size_t FeatureReader::read(int64_t t0, int64_t t1, std::vector<feature_row> &out) {
+    size_t first, last, n = 0;
+    range(t0, t1, first, last);
+    scan.blocks_skipped += index.size() - (last - first);
+
+    std::vector<double> cols[FS_COLUMNS];
+    for (size_t b=first; b < last; b++) {
+        if (!decode_time(b)) continue;
+        uint32_t rows = header(b).rows;
+        bool ok = true;
+        for (int c=1; ok && c < FS_COLUMNS; c++) {
+            ok = decode_column(b, c);
+            cols[c].swap(v_buf);
+        }
+        if (!ok) continue;
+        for (uint32_t i=0; i < rows; i++) {
+            if (t_buf[i] < t0 || t_buf[i] >= t1) continue;
+            feature_row r;
+            r.t_ms = t_buf[i];
+            for (int c=1; c < FS_COLUMNS; c++) {
+                if (is_float(c)) *float_field(r, c) = (float)cols[c][i];
+                else             set_int_field(r, c, (int64_t)cols[c][i]);
+            }
+            out.push_back(r);
+            n++;
+        }
+    }
+    return n;
+}
+
+static void bucket_add(fs_bucket &k, uint32_t count, double sum, double min, double max) {
+    if (!count) return;
+    if (!k.count || min < k.min) k.min = min;
+    if (!k.count || max > k.max) k.max = max;
+    k.count += count;
+    k.sum += sum;
+}
+
+void FeatureReader::aggregate(int col, int64_t t0, int64_t t1, int64_t bucket_ms, fs_bucket *out) {
+    size_t nb = (size_t)((t1 - t0 + bucket_ms - 1) / bucket_ms);
+    memset(out, 0, nb * sizeof(fs_bucket));
+
+    size_t first, last;
+    range(t0, t1, first, last);
+    scan.blocks_skipped += index.size() - (last - first);
+
+    for (size_t b=first; b < last; b++) {
+        const fs_block_header &h = header(b);
+        if (h.t_min >= t0 && h.t_max < t1
+            && (h.t_min - t0) / bucket_ms == (h.t_max - t0) / bucket_ms) {
+            const fs_column_index &ci = h.col[col];
+            bucket_add(out[(h.t_min - t0) / bucket_ms], h.rows, ci.sum, ci.min, ci.max);
+            scan.blocks_header++;
+            continue;
+        }
+        if (!decode_time(b) || !decode_column(b, col)) continue;
+        for (uint32_t i=0; i < h.rows; i++) {
+            if (t_buf[i] < t0 || t_buf[i] >= t1) continue;
+            double v = v_buf[i];
+            bucket_add(out[(t_buf[i] - t0) / bucket_ms], 1, v, v, v);
+        }
+    }
+}
+
+uint64_t FeatureReader::count_where(int col, int64_t t0, int64_t t1, double lo, double hi) {
+    size_t first, last;
+    range(t0, t1, first, last);
+    scan.blocks_skipped += index.size() - (last - first);
+
+    uint64_t n = 0;
+    for (size_t b=first; b < last; b++) {
+        const fs_block_header &h = header(b);
+        const fs_column_index &ci = h.col[col];
+        if (ci.max < lo || ci.min > hi) {
+            scan.blocks_skipped++;
+            continue;
+        }
+        if (h.t_min >= t0 && h.t_max < t1 && ci.min >= lo && ci.max <= hi) {
+            n += h.rows;
+            scan.blocks_header++;
+            continue;
+        }
+        if (!decode_time(b) || !decode_column(b, col)) continue;
+        for (uint32_t i=0; i < h.rows; i++)
+            if (t_buf[i] >= t0 && t_buf[i] < t1 && v_buf[i] >= lo && v_buf[i] <= hi) n++;
+    }
+    return n;
+}
+
+void feature_store_path(char *out, size_t n, const char *dir, uint32_t patient) {
+    snprintf(out, n, "%s/patient-%lu.fst", dir, (unsigned long)patient);
+}
@@ -0,0 +1,198 @@
+#ifndef FEATURE_STORE_H
+#define FEATURE_STORE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+#include "detector.h"
+
+// ========= FEATURE STORE =========
+// Host-side, append-only columnar store for per-window detector
+// features, one file per patient. Rows go into blocks; a block is
+// closed after block_rows rows or when a row falls into the next
+// block_span (an hour by default), so blocks never straddle an hour.
+//
+// Each block has a header with its row count, time range and, per
+// column, the payload offset, a CRC-32 and min / max / sum. Columns are
+// compressed separately:
+//
+//   time          first value, then zigzag varint delta-of-delta (one
+//                 byte per row at a steady hop)
+//   float         XOR with the previous value, leading / meaningful bit
+//                 windows as in Gorilla (one bit per repeated value)
+//   int           zigzag varint delta (flags, scores)
+//
+// Readers mmap the file and index the block headers. A query decodes
+// only the columns it needs, of the blocks its time range touches; a
+// block that lies inside one aggregation bucket is answered from its
+// header alone, and a block whose min / max cannot match a value
+// filter is skipped.
+//
+// Appends are single-writer. A block is written in one piece, header
+// first; a reader sees whole blocks only. Opening a file for append
+// drops a torn last block (crash during a write). Host byte order
+// (little-endian) on disk.
+
+enum {
+    FS_TIME,                // ms since the epoch, window end
+    FS_TREMOR,
+    FS_DYSK,
+    FS_WALK,
+    FS_FOG,
+    FS_FOG_RATIO,
+    FS_FLAGS,               // FS_FLAG_* | vote mask << 8
+    FS_SCORE,               // SYM_COUNT q15 scores follow
+    FS_COLUMNS = FS_SCORE + SYM_COUNT
+};
+
+#define FS_FLAG_TREMOR_PRESENT  (1u << 0)
+#define FS_FLAG_FREEZING        (1u << 1)
+#define FS_FLAG_IS_TREMOR       (1u << 2)
+#define FS_FLAG_IS_DYSK         (1u << 3)
+
+struct feature_row {
+    int64_t  t_ms;
+    float    tremor, dysk, walk, fog, fog_ratio;
+    uint32_t flags;
+    int16_t  score[SYM_COUNT];
+};
+
+// One window's result and the vote mask (1 << SYM_*) in force after it.
+feature_row feature_row_from(int64_t t_ms, const detector_result &r, uint32_t active);
+
+double feature_value(const feature_row &r, int col);
+const char *feature_column_name(int col);
+
+// ======= ON DISK =======
+#define FS_FILE_MAGIC   0x31534650u     // "PFS1"
+#define FS_BLOCK_MAGIC  0x4b4c4246u     // "FBLK"
+
+struct fs_file_header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t columns;
+    uint32_t block_span_s;
+    uint32_t block_rows;
+};
+
+struct fs_column_index {
+    uint32_t offset;        // in the payload
+    uint32_t bytes;
+    uint32_t crc;           // CRC-32 of the column's bytes
+    uint32_t reserved;
+    double   min, max, sum;
+};
+
+struct fs_block_header {
+    uint32_t magic;
+    uint32_t bytes;         // payload after this header
+    uint32_t rows;
+    uint32_t crc;           // CRC-32 of this header with crc = 0
+    int64_t  t_min, t_max;
+    fs_column_index col[FS_COLUMNS];
+};
+
+// ======= WRITER =======
+class FeatureWriter {
+public:
+    FeatureWriter() : fd(-1) {}
+    ~FeatureWriter() { close(); }
+
+    // Creates the file, or opens it for append after its last whole
+    // block. block_span_s and block_rows apply to new files only.
+    bool open(const char *path, uint32_t block_span_s = 3600, uint32_t block_rows = 4096);
+
+    // false if the row is older than the last one, or on I/O error
+    bool append(const feature_row &r);
+
+    // Writes the rows appended so far as a (possibly short) block;
+    // sync also waits for the disk.
+    bool flush(bool sync = false);
+    void close();
+
+    uint64_t rows() const { return written + pending.size(); }
+    uint64_t bytes() const { return file_bytes; }
+
+private:
+    int fd;
+    fs_file_header hdr;
+    int64_t span_ms;
+    int64_t last_t;
+    uint64_t written, file_bytes;
+    std::vector<feature_row> pending;
+    std::vector<uint8_t> payload;
+};
+
+// ======= READER =======
+struct fs_bucket {
+    uint32_t count;
+    double   sum, min, max;
+};
+
+// Work done by the queries since the last reset, to check what a query
+// really touched.
+struct fs_scan_stats {
+    uint64_t blocks_skipped;        // outside the range or filtered by min / max
+    uint64_t blocks_header;         // answered from the header alone
+    uint64_t blocks_decoded;
+    uint64_t bytes_decoded;         // compressed column bytes read
+    uint64_t rows_decoded;
+    uint64_t crc_errors;            // damaged columns met while decoding
+};
+
+class FeatureReader {
+public:
+    FeatureReader() : base(0), size(0), total_rows(0) {}
+    ~FeatureReader() { close(); }
+
+    // Maps the file and indexes its whole blocks.
+    bool open(const char *path);
+    void close();
+
+    size_t   blocks() const { return index.size(); }
+    uint64_t rows() const { return total_rows; }
+    int64_t  first_t() const { return index.empty() ? 0 : header(0).t_min; }
+    int64_t  last_t() const  { return index.empty() ? 0 : header(index.size() - 1).t_max; }
+    const fs_file_header &file() const { return *(const fs_file_header *)base; }
+
+    // compressed bytes of one column over all blocks
+    uint64_t column_bytes(int col) const;
+
+    // Rows with t0 <= t < t1, all columns, appended to out.
+    size_t read(int64_t t0, int64_t t1, std::vector<feature_row> &out);
+
+    // count / sum / min / max of column col over [t0, t1) in buckets of
+    // bucket_ms starting at t0; out has (t1 - t0 + bucket_ms - 1) /
+    // bucket_ms entries.
+    void aggregate(int col, int64_t t0, int64_t t1, int64_t bucket_ms, fs_bucket *out);
+
+    // Rows in [t0, t1) whose column col lies in [lo, hi].
+    uint64_t count_where(int col, int64_t t0, int64_t t1, double lo, double hi);
+
+    const fs_scan_stats &stats() const { return scan; }
+    void reset_stats();
+
+private:
+    const uint8_t *base;
+    size_t size;
+    std::vector<size_t> index;      // block header offsets
+    uint64_t total_rows;
+    fs_scan_stats scan;
+
+    // decode scratch, one block
+    std::vector<int64_t> t_buf;
+    std::vector<double>  v_buf;
+
+    const fs_block_header &header(size_t b) const {
+        return *(const fs_block_header *)(base + index[b]);
+    }
+    bool decode_time(size_t b);
+    bool decode_column(size_t b, int col);
+    void range(int64_t t0, int64_t t1, size_t &first, size_t &last) const;
+};
+
+// <dir>/patient-<id>.fst
+void feature_store_path(char *out, size_t n, const char *dir, uint32_t patient);
+
+#endif
@@ -0,0 +1,189 @@
+// ========= HOURLY SUMMARY =========
+// Runs a day (by default) of synthetic recording through the board graph,
+// step detector and tremor tracker as main.cpp does, and feeds every
+// window to the hourly symptom summary (symptom_summary.h). Prints the
+// records as they would be exported, next to the labelled minutes per
+// hour, and checks each against counts kept window by window on the
+// host. Reports the cost per window and the bytes kept per day.
+//
+//   pio run -e summary && .pio/build/summary/program [hours] [seed]
+//
+// Exit status 1 if a record differs from the per-window counts.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+
+#include "board_graph.h"
+#include "motion_gen.h"
+#include "step_detector.h"
+#include "tremor_tracker.h"
+#include "symptom_summary.h"
+
+static board_graph graph;
+static motion_gen gen;
+static TremorTracker<board_detector> tracker;
+static board_sink spectra = { 0, &tracker };
+static symptom_summary summary;
+
+static const int W = board_graph::input_tokens;
+static int16_t raw[W][IMU_AXES];
+static uint8_t labels[W];
+
+// what the summary saw, per window
+struct window_in {
+    float tremor, dysk, hz;
+    uint32_t shown;
+    uint32_t labels;            // MOTION_* on for at least half the window
+};
+
+static uint8_t share(uint32_t count, uint32_t windows) {
+    return (uint8_t)((count * 255u + windows / 2) / windows);
+}
+
+// The record for windows [first, first + n), counted directly.
+static summary_hour expected(const std::vector<window_in> &in, size_t first, size_t n, uint32_t prev) {
+    summary_hour h;
+    memset(&h, 0, sizeof(h));
+    h.hour = (uint16_t)(first / SUMMARY_HOUR_WINDOWS);
+    h.windows = (uint16_t)n;
+    uint32_t tn[SUMMARY_POWER_BINS] = {}, dn[SUMMARY_POWER_BINS] = {}, fn[SUMMARY_FREQ_BINS] = {};
+    for (size_t i=first; i < first + n; i++) {
+        const window_in &w = in[i];
+        for (int k=0; k < SYM_COUNT; k++) {
+            h.on[k] += (w.shown >> k) & 1;
+            h.episodes[k] += ((w.shown & ~prev) >> k) & 1;
+        }
+        prev = w.shown;
+        tn[summary_power_bin(w.tremor)]++;
+        dn[summary_power_bin(w.dysk)]++;
+        if (w.hz > 0.0f) fn[summary_freq_bin(w.hz)]++;
+    }
+    for (int b=0; b < SUMMARY_POWER_BINS; b++) {
+        h.tremor_hist[b] = share(tn[b], n);
+        h.dysk_hist[b]   = share(dn[b], n);
+    }
+    for (int b=0; b < SUMMARY_FREQ_BINS; b++) h.freq_hist[b] = share(fn[b], n);
+    return h;
+}
+
+static void print_hist(const uint8_t *h, int n) {
+    for (int b=0; b < n; b++) printf("%4d", h[b]);
+    printf(" |");
+}
+
+int main(int argc, char **argv) {
+    int hours = argc > 1 ? atoi(argv[1]) : 24;
+    uint32_t seed = argc > 2 ? (uint32_t)strtoul(argv[2], 0, 0) : 1;
+    if (hours <= 0) hours = 1;
+
+    board_graph_init(graph);
+    graph.node<NODE_DETECTOR>().sink = &spectra;
+    step_init();
+    tracker.init();
+    summary_init(summary);
+    motion_init(gen, seed);
+
+    // a partial last hour shows the flush path
+    size_t windows = (size_t)hours * SUMMARY_HOUR_WINDOWS + SUMMARY_HOUR_WINDOWS / 3;
+    std::vector<window_in> in;
+    std::vector<summary_hour> out;
+    std::vector<double> ns;
+    in.reserve(windows);
+    ns.reserve(windows);
+
+    for (size_t w=0; w < windows; w++) {
+        motion_generate(gen, raw, labels, W);
+        int count[8] = {};
+        float amag[STEP_BLOCK];
+        int an = 0;
+        for (int i=0; i < W; i++) {
+            imu_sample s;
+            memcpy(s.raw, raw[i], sizeof(s.raw));
+            graph.push(s);
+
+            amag[an++] = graph.head_output().accel;
+            if (an == STEP_BLOCK || i == W - 1) {
+                step_push(amag, an);
+                an = 0;
+            }
+            for (int b=0; b < 8; b++) if (labels[i] & (1u << b)) count[b]++;
+        }
+        uint32_t t[16];
+        while (step_take(t, 16) > 0) {}
+
+        const board_decision &d = *graph.run();
+
+        bool freezing = (d.active & (1u << SYM_FREEZE)) || step_freeze_hint();
+        window_in x;
+        x.tremor = d.r.tremor;
+        x.dysk = d.r.dysk;
+        x.hz = tracker.locked() ? tracker.frequency() : 0.0f;
+        x.shown = (d.active & ~(1u << SYM_FREEZE)) | (freezing ? 1u << SYM_FREEZE : 0);
+        x.labels = 0;
+        for (int b=0; b < 8; b++) if (count[b] * 2 >= W) x.labels |= 1u << b;
+        in.push_back(x);
+
+        auto t0 = std::chrono::steady_clock::now();
+        summary_window(summary, d.r, x.shown, x.hz);
+        auto t1 = std::chrono::steady_clock::now();
+        ns.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count());
+
+        summary_hour h;
+        while (summary_take(summary, h)) out.push_back(h);
+    }
+    summary_flush(summary);
+    summary_hour h;
+    while (summary_take(summary, h)) out.push_back(h);
+
+    printf("corpus: %d h + %d windows, seed %lu\n\n", hours, SUMMARY_HOUR_WINDOWS / 3,
+           (unsigned long)seed);
+    printf("%4s %5s | %-17s | %-17s | %-11s | %-23s | %-23s | %-15s |\n",
+           "hour", "win", "on min trem/dysk/fz", "labelled min", "episodes",
+           "tremor power share", "dysk power share", "tremor Hz share");
+
+    bool ok = true;
+    size_t first = 0;
+    uint32_t prev = 0;
+    for (const summary_hour &r : out) {
+        summary_hour e = expected(in, first, r.windows, prev);
+        bool same = !memcmp(&e, &r, sizeof(r));
+        ok = ok && same;
+
+        double lab[3] = {};
+        for (size_t i=first; i < first + r.windows; i++) {
+            lab[0] += (in[i].labels & MOTION_TREMOR) != 0;
+            lab[1] += (in[i].labels & MOTION_DYSK) != 0;
+            lab[2] += (in[i].labels & MOTION_FREEZE) != 0;
+        }
+        const double min_per_window = (double)W / MOTION_RATE / 60;
+        printf("%4u %5u | %5.0f %5.0f %5.0f | %5.0f %5.0f %5.0f | %3u %3u %3u |",
+               r.hour, r.windows, r.on[SYM_TREMOR] * min_per_window,
+               r.on[SYM_DYSK] * min_per_window, r.on[SYM_FREEZE] * min_per_window,
+               lab[0] * min_per_window, lab[1] * min_per_window, lab[2] * min_per_window,
+               r.episodes[SYM_TREMOR], r.episodes[SYM_DYSK], r.episodes[SYM_FREEZE]);
+        print_hist(r.tremor_hist, SUMMARY_POWER_BINS);
+        print_hist(r.dysk_hist, SUMMARY_POWER_BINS);
+        print_hist(r.freq_hist, SUMMARY_FREQ_BINS);
+        printf("%s\n", same ? "" : "  MISMATCH");
+
+        first += r.windows;
+        if (first) prev = in[first - 1].shown;
+    }
+    ok = ok && first == windows;
+
+    std::nth_element(ns.begin(), ns.begin() + ns.size() / 2, ns.end());
+    double med = ns[ns.size() / 2];
+    double worst = *std::max_element(ns.begin(), ns.end());
+    printf("\nsummary_window: median %.0f ns, worst %.0f ns (host)\n", med, worst);
+    printf("kept per day: %zu bytes (24 x %zu); state %zu bytes\n",
+           24 * sizeof(summary_hour), sizeof(summary_hour), sizeof(symptom_summary));
+    printf("per-window results per day: %d x %zu bytes = %zu bytes\n",
+           24 * SUMMARY_HOUR_WINDOWS, sizeof(board_decision),
+           (size_t)24 * SUMMARY_HOUR_WINDOWS * sizeof(board_decision));
+    printf("\n%s\n", ok ? "records match the per-window counts" : "MISMATCH");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,176 @@
+// ========= SYNTHETIC REGRESSION =========
+// Generates a labelled corpus with the motion generator and runs it
+// through the board analysis graph and the step detector, window by
+// window, exactly as main.cpp feeds them. Reports per symptom how the
+// single-window rule and the board decision (vote, plus the step
+// detector's freeze hint) agree with the labels, step counts
+// against the true cadence, how closely the gyro bias estimate follows
+// the generator's drifting bias, and generator throughput.
+//
+//   pio run -e synth && .pio/build/synth/program [minutes] [seed]
+//
+// A window is labelled with a symptom when at least half its samples
+// are. The corpus checksum changes only if the generator does; the exit
+// status is 1 if detection falls below the floors at the end of the file.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <chrono>
+
+#include "board_graph.h"
+#include "motion_gen.h"
+#include "step_detector.h"
+
+static board_graph graph;
+static motion_gen gen;
+
+static const int W = board_graph::input_tokens;
+static int16_t raw[W][IMU_AXES];
+static uint8_t labels[W];
+
+struct symptom {
+    const char *name;
+    uint32_t bit;               // MOTION_*
+    int sym;                    // SYM_*
+    float min_recall;           // of the vote, regression floor
+    float max_false;            // vote false alarms per unlabelled window
+    uint32_t pos, neg;          // labelled / unlabelled windows
+    uint32_t hit_rule, fa_rule; // single window
+    uint32_t hit_vote, fa_vote;
+};
+
+// Floors sit a little under what the current rules reach on 4 h corpora
+// (seeds 1-4). With its zero-rate bias taken off, |gyro| rectifies
+// tremor into its second harmonic (the bias no longer acts as a
+// carrier), which holds tremor and dyskinesia recall down; the step
+// detector's freeze hint carries freeze.
+static symptom symptoms[] = {
+    { "tremor", MOTION_TREMOR, SYM_TREMOR, 0.12f, 0.10f, 0, 0, 0, 0, 0, 0 },
+    { "dysk",   MOTION_DYSK,   SYM_DYSK,   0.02f, 0.05f, 0, 0, 0, 0, 0, 0 },
+    { "freeze", MOTION_FREEZE, SYM_FREEZE, 0.25f, 0.03f, 0, 0, 0, 0, 0, 0 },
+};
+static const int NSYM = sizeof(symptoms) / sizeof(symptoms[0]);
+
+static bool rule_fired(const detector_result &r, int sym) {
+    switch (sym) {
+    case SYM_TREMOR: return r.is_tremor;
+    case SYM_DYSK:   return r.is_dysk;
+    default:         return r.freezing;
+    }
+}
+
+// FNV-1a over the raw samples and labels
+static uint32_t fnv(uint32_t h, const void *p, size_t n) {
+    const uint8_t *b = (const uint8_t *)p;
+    for (size_t i=0; i < n; i++) h = (h ^ b[i]) * 16777619u;
+    return h;
+}
+
+int main(int argc, char **argv) {
+    int minutes = argc > 1 ? atoi(argv[1]) : 240;
+    uint32_t seed = argc > 2 ? (uint32_t)strtoul(argv[2], 0, 0) : 1;
+    if (minutes <= 0) minutes = 1;
+
+    board_graph_init(graph);
+    step_init();
+    motion_init(gen, seed);
+
+    int windows = minutes * 60 * MOTION_RATE / W;
+    uint32_t sum = 2166136261u;
+    double walk_s = 0;
+    double bias_err2 = 0, bias2 = 0;
+    uint32_t steps = 0;
+    double gen_ns = 0;
+
+    for (int w=0; w < windows; w++) {
+        auto t0 = std::chrono::steady_clock::now();
+        motion_generate(gen, raw, labels, W);
+        auto t1 = std::chrono::steady_clock::now();
+        gen_ns += std::chrono::duration<double, std::nano>(t1 - t0).count();
+
+        sum = fnv(sum, raw, sizeof(raw));
+        sum = fnv(sum, labels, sizeof(labels));
+
+        int count[8] = {};
+        float amag[STEP_BLOCK];
+        int an = 0;
+        for (int i=0; i < W; i++) {
+            imu_sample s;
+            for (int a=0; a < IMU_AXES; a++) s.raw[a] = raw[i][a];
+            graph.push(s);
+
+            amag[an++] = graph.head_output().accel;
+            if (an == STEP_BLOCK || i == W - 1) {
+                steps += step_push(amag, an);
+                an = 0;
+            }
+
+            for (int b=0; b < 8; b++) if (labels[i] & (1u << b)) count[b]++;
+            if (labels[i] & MOTION_WALK) walk_s += 1.0 / MOTION_RATE;
+        }
+
+        const board_decision &d = *graph.run();
+        const gyro_bias &gb = graph.node<NODE_MAGNITUDE>().bias;
+        for (int i=0; i < 3; i++) {
+            bias_err2 += (gb.bias[i] - gen.bias[i]) * (gb.bias[i] - gen.bias[i]);
+            bias2 += gen.bias[i] * gen.bias[i];
+        }
+        for (int k=0; k < NSYM; k++) {
+            symptom &s = symptoms[k];
+            int b = 0;
+            while (!(s.bit & (1u << b))) b++;
+            bool labelled = count[b] * 2 >= W;
+            bool rule = rule_fired(d.r, s.sym);
+            bool vote = d.active & (1u << s.sym);
+            if (s.sym == SYM_FREEZE) vote = vote || step_freeze_hint();   // as main.cpp
+            if (labelled) {
+                s.pos++;
+                s.hit_rule += rule;
+                s.hit_vote += vote;
+            } else {
+                s.neg++;
+                s.fa_rule += rule;
+                s.fa_vote += vote;
+            }
+        }
+        // only the count is needed, not the step times
+        uint32_t t[16];
+        while (step_take(t, 16) > 0) {}
+    }
+
+    const motion_stats &ms = gen.stats;
+    printf("corpus: %d min, seed %lu, %d windows, %lu segments, checksum %08lx\n",
+           minutes, (unsigned long)seed, windows, (unsigned long)ms.segments,
+           (unsigned long)sum);
+    printf("saturated samples %lu of %lu\n",
+           (unsigned long)ms.saturated, (unsigned long)ms.samples);
+    printf("generator %.0f ns/sample, %.0fx real time\n",
+           gen_ns / ms.samples, 1e9 / MOTION_RATE / (gen_ns / ms.samples));
+
+    printf("\n%-8s %6s %6s  %12s %12s  %12s %12s\n",
+           "symptom", "pos", "neg", "rule recall", "rule fa", "vote recall", "vote fa");
+    bool ok = true;
+    for (int k=0; k < NSYM; k++) {
+        const symptom &s = symptoms[k];
+        double rr = s.pos ? (double)s.hit_rule / s.pos : 0;
+        double rf = s.neg ? (double)s.fa_rule / s.neg : 0;
+        double vr = s.pos ? (double)s.hit_vote / s.pos : 0;
+        double vf = s.neg ? (double)s.fa_vote / s.neg : 0;
+        bool pass = (!s.pos || vr >= s.min_recall) && vf <= s.max_false;
+        ok = ok && pass;
+        printf("%-8s %6lu %6lu  %12.3f %12.3f  %12.3f %12.3f  %s\n",
+               s.name, (unsigned long)s.pos, (unsigned long)s.neg,
+               rr, rf, vr, vf, pass ? "ok" : "FAIL");
+    }
+
+    printf("\nsteps %lu, generated %lu over %.0f s of walking (%.1f%%)\n",
+           (unsigned long)steps, (unsigned long)ms.steps, walk_s,
+           ms.steps ? 100.0 * steps / ms.steps : 0.0);
+    const gyro_bias &gb = graph.node<NODE_MAGNITUDE>().bias;
+    printf("gyro bias: %.1f%% of seconds still, error %.2f dps rms per axis "
+           "(%.2f dps uncorrected)\n",
+           gb.blocks ? 100.0 * gb.still_blocks / gb.blocks : 0.0,
+           sqrt(bias_err2 / (3.0 * windows)), sqrt(bias2 / (3.0 * windows)));
+    return ok ? 0 : 1;
+}
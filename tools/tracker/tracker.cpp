@@ -0,0 +1,136 @@
+// ========= TREMOR TRACKER REPLAY =========
+// Replays a synthetic gyro recording with a wandering tremor through
+// the board detector with TremorTracker as its sink, hop by hop, and
+// reports how well the tracker follows the true frequency and what it
+// adds to the detector hop it rides on.
+//
+//   pio run -e tracker && .pio/build/tracker/program [hops]
+//
+// The recording: 4.0-4.6 Hz tremor wandering slowly, 12 dps, switched
+// off for a stretch in the middle; a 1.2 Hz sway and broadband noise.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+
+#include "detector.h"
+#include "tremor_tracker.h"
+
+typedef board_detector D;
+
+static D detector;
+static TremorTracker<D> tracker;
+static float gyro[D::raw_samples];
+
+// The tracker, and the strongest tremor bin of the same spectrum as the
+// reference it is compared with. Keeps the last spectrum for timing.
+struct replay_sink {
+    int strongest;
+    D::sample_t last[D::bins];
+    float last_gain;
+
+    void accel_spectrum(const D::sample_t *, float) {}
+    void gyro_spectrum(const D::sample_t *mag, float gain) {
+        tracker.gyro_spectrum(mag, gain);
+        memcpy(last, mag, sizeof(last));
+        last_gain = gain;
+        strongest = D::tremor_bins::first;
+        for (int k=D::tremor_bins::first; k <= D::tremor_bins::last; k++)
+            if (mag[k] > mag[strongest]) strongest = k;
+    }
+};
+
+static unsigned seed = 12345;
+static float noise() {
+    // sum of uniforms, roughly normal with unit variance
+    float s = 0;
+    for (int i=0; i < 4; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        s += (float)(seed >> 8) / 16777216.0f - 0.5f;
+    }
+    return s * 1.732f;
+}
+
+static float true_hz(int hop, int hops) {
+    return 4.3f + 0.3f * sinf(2.0f * PI * hop / (hops * 0.6f));
+}
+
+static bool tremor_on(int hop, int hops) {
+    return hop < hops * 2 / 5 || hop >= hops / 2;
+}
+
+template <class F>
+static double ns_per_call(F fn, int n) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i=0; i < n; i++) fn();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+}
+
+int main(int argc, char **argv) {
+    int hops = argc > 1 ? atoi(argv[1]) : 200;
+    if (hops < 10) hops = 10;
+
+    detector.init();
+    tracker.init();
+    replay_sink sink;
+    detector_result r;
+
+    float phase = 0;
+    int on_hops = 0, on_locked = 0, off_locked = 0;
+    double err2 = 0, bin_err2 = 0;
+    int measured = 0;
+
+    for (int h=0; h < hops; h++) {
+        float fz = true_hz(h, hops);
+        bool on = tremor_on(h, hops);
+        for (int i=0; i < D::raw_samples; i++) {
+            float t = (float)(h * D::raw_samples + i) / D::sample_rate;
+            phase += 2.0f * PI * fz / D::sample_rate;
+            gyro[i] = 15.0f + (on ? 12.0f * sinf(phase) : 0.0f)
+                    + 4.0f * sinf(2.0f * PI * 1.2f * t) + 3.0f * noise();
+        }
+
+        detector.analyze(gyro, gyro, r, sink);
+
+        if (on) {
+            on_hops++;
+            if (tracker.locked()) {
+                on_locked++;
+                double e = tracker.frequency() - fz;
+                err2 += e * e;
+
+                // reference: centre of the strongest bin
+                double eb = sink.strongest * D::hz_per_bin - fz;
+                bin_err2 += eb * eb;
+                measured++;
+            }
+        } else if (tracker.locked()) {
+            off_locked++;
+        }
+    }
+
+    const TremorTracker<D>::stats &st = tracker.get_stats();
+    printf("hops %d, tremor on in %d\n", hops, on_hops);
+    printf("locked on %d of %d tremor hops, %d hops locked with no tremor\n",
+           on_locked, on_hops, off_locked);
+    printf("acquired %lu, lost %lu\n", (unsigned long)st.acquired, (unsigned long)st.lost);
+    if (measured)
+        printf("frequency rms error %.3f Hz (strongest bin %.3f Hz, bin width %.3f Hz)\n",
+               sqrt(err2 / measured), sqrt(bin_err2 / measured), (double)D::hz_per_bin);
+
+    // cost: what the tracker adds to the detector hop the board runs
+    // anyway (best of interleaved rounds, host timing is noisy)
+    double ns_detect = 1e30, ns_track = 1e30;
+    for (int round=0; round < 10; round++) {
+        ns_detect = fmin(ns_detect, ns_per_call([&r] { detector.analyze(gyro, gyro, r); }, 2000));
+        ns_track = fmin(ns_track, ns_per_call([&sink] {
+            tracker.gyro_spectrum(sink.last, sink.last_gain);
+        }, 20000));
+    }
+    printf("host: detector hop %.0f ns, tracker %.0f ns on top (%.1f%%)\n",
+           ns_detect, ns_track, 100.0 * ns_track / ns_detect);
+    return 0;
+}